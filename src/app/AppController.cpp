@@ -1,14 +1,22 @@
 #include "app/AppController.h"
+#include "app/CpuTopology.h"
+#include "app/MachineIdentity.h"
+#include "app/StartupTrace.h"
+#include "app/Trace.h"
 #include "app/UacHelper.h"
 
 #include <QCoreApplication>
+#include <QDebug>
+#include <QFutureWatcher>
 #include <QProcess>
 #include <QSysInfo>
+#include <QtConcurrent/QtConcurrent>
+
+#include <algorithm>
 
 AppController::AppController(QObject *parent)
     : QObject(parent)
     , m_detector()
-    , m_hwInfo(m_detector.detect())
     , m_engine()
     , m_model(m_engine.tweaks(), this)
     , m_startupScanner()
@@ -19,27 +27,144 @@ AppController::AppController(QObject *parent)
     , m_gameBenchmark(this)
     , m_configManager(this)
 {
+    // Connect benchmark signals
+    connect(&m_benchmark, &BenchmarkEngine::resultsChanged, this, &AppController::benchmarkChanged);
+    connect(&m_benchmark, &BenchmarkEngine::runningChanged, this, &AppController::benchmarkRunningChanged);
+    connect(&m_benchmark, &BenchmarkEngine::coreScanChanged, this, &AppController::coreScanChanged);
+    connect(&m_benchmark, &BenchmarkEngine::sampleReady, this, [this]() {
+        // Samples are keyed by the hardware they ran on, so wait for detection
+        if (m_hardwareReady)
+            m_calibration.addSample(m_benchmark.lastSample(), ScoreCalibration::keyFor(m_hwInfo));
+        rescore();
+    });
+}
+
+// ---------------------------------------------------------------------------
+// Staged start-up
+// ---------------------------------------------------------------------------
+void AppController::initialize()
+{
+    TRACE_SCOPE("app", "initialize");
+    StartupTrace::mark(QStringLiteral("initialize"));
+
     // Restore persisted CS2 path
     const QString savedCs2 = m_settings.cs2Path();
     if (!savedCs2.isEmpty())
         m_engine.setCs2Path(savedCs2);
 
+    // The tweak catalog and applied state load on a scratch engine off the
+    // GUI thread and are swapped in whole.
+    auto *tweaksWatcher = new QFutureWatcher<QList<Tweak>>(this);
+    connect(tweaksWatcher, &QFutureWatcher<QList<Tweak>>::finished, this, [this, tweaksWatcher]() {
+        tweaksWatcher->deleteLater();
+        m_model.reset(tweaksWatcher->result());
+        m_tweaksReady = true;
+        if (m_hardwareReady)
+            m_engine.updateRecommendations(m_hwInfo);
+        StartupTrace::mark(QStringLiteral("tweaks ready"));
+        emit tweaksChanged();
+    });
+    tweaksWatcher->setFuture(QtConcurrent::run([]() {
+        TweakEngine engine;
+        engine.load();
+        return engine.tweaks();
+    }));
+
+    // Startup entries are only read (registry / autostart folders)
+    auto *scanWatcher = new QFutureWatcher<QVariantList>(this);
+    connect(scanWatcher, &QFutureWatcher<QVariantList>::finished, this, [this, scanWatcher]() {
+        scanWatcher->deleteLater();
+        m_startupSuggestions = scanWatcher->result();
+        StartupTrace::mark(QStringLiteral("startup scan done"));
+        emit startupChanged();
+    });
+    const StartupScanner *scanner = &m_startupScanner;
+    scanWatcher->setFuture(QtConcurrent::run([scanner]() { return scanner->scan(); }));
+
+    m_systemMonitor.start();
+
+    // Show the cached snapshot immediately; probes only run in the background
+    // when the machine fingerprint changed or the snapshot is too old. The
+    // fingerprint comes from the identity pass, so that check waits for it.
+    // Recommendations, scores and the game benchmark follow the hardware info.
+    CachedHardware cached;
+    const bool haveCache = m_hwCache.load(cached);
+    if (haveCache) {
+        m_hwInfo = cached.info;
+        m_hardwareReady = true;
+        applyHardware();
+        StartupTrace::mark(QStringLiteral("hardware ready"));
+    }
+    if (!haveCache) {
+        startHardwareDetection();
+        return;
+    }
+    MachineIdentity::instance().whenReady(this, [this, cached]() {
+        if (HardwareCache::needsRefresh(cached, MachineIdentity::instance().fingerprint()))
+            startHardwareDetection();
+        else
+            qDebug() << "[HW] Using cached hardware snapshot";
+    });
+}
+
+// ---------------------------------------------------------------------------
+// Hardware detection
+// ---------------------------------------------------------------------------
+void AppController::startHardwareDetection()
+{
+    if (m_detecting) return;
+    m_detecting = true;
+    m_pendingHwInfo = HardwareInfo();
+
+    m_detector.detectAsync(this,
+        [this](const HardwareInfo &partial, const QString &) {
+            HardwareDetector::merge(m_pendingHwInfo, partial);
+            // On first detection show partial info as it arrives; on a
+            // refresh keep the previous complete info until the new one is done.
+            if (!m_hardwareReady) {
+                m_hwInfo = m_pendingHwInfo;
+                emit hardwareChanged();
+            }
+        },
+        [this]() {
+            m_detecting = false;
+            HardwareDetector::finalize(m_pendingHwInfo);
+            m_hwInfo = m_pendingHwInfo;
+            m_hardwareReady = true;
+            const HardwareInfo detected = m_hwInfo;
+            MachineIdentity::instance().whenReady(this, [this, detected]() {
+                if (!m_hwCache.save(detected, MachineIdentity::instance().fingerprint()))
+                    qWarning() << "[HW] Could not write hardware cache";
+            });
+            applyHardware();
+            StartupTrace::mark(QStringLiteral("hardware ready"));
+        });
+}
+
+void AppController::applyHardware()
+{
+    TRACE_SCOPE("app", "applyHardware");
     m_engine.updateRecommendations(m_hwInfo);
     m_model.refresh();
-    refreshStartupSuggestions();
 
-    // Score hardware
+    // Measurements only apply to the hardware they were taken on
+    const QString key = ScoreCalibration::keyFor(m_hwInfo);
+    if (key != m_calibration.hardwareKey())
+        m_calibration.load(key);
+    m_scorer.setCalibration(m_calibration.model());
     m_scorer.score(m_hwInfo);
-
-    // Initialize game benchmark with hardware info
     m_gameBenchmark.setHardware(m_hwInfo, &m_scorer);
+    emit hardwareChanged();
+    emit tweaksChanged();
+}
 
-    // Start system monitor
-    m_systemMonitor.start();
-
-    // Connect benchmark signals
-    connect(&m_benchmark, &BenchmarkEngine::resultsChanged, this, &AppController::benchmarkChanged);
-    connect(&m_benchmark, &BenchmarkEngine::runningChanged, this, &AppController::benchmarkRunningChanged);
+void AppController::rescore()
+{
+    TRACE_SCOPE("app", "rescore");
+    m_scorer.setCalibration(m_calibration.model());
+    m_scorer.score(m_hwInfo);
+    m_gameBenchmark.setHardware(m_hwInfo, &m_scorer);
+    emit scoresChanged();
 }
 
 // ---------------------------------------------------------------------------
@@ -57,6 +182,7 @@ bool    AppController::hasNvme()        const { return m_hwInfo.hasNvme; }
 // Lag 2: Low-Level
 QString AppController::ramType()          const { return m_hwInfo.ramType; }
 int     AppController::ramSpeedMhz()      const { return static_cast<int>(m_hwInfo.ramSpeedMhz); }
+int     AppController::ramChannels()      const { return m_hwInfo.ramChannels; }
 int     AppController::gpuVramMb()        const { return static_cast<int>(m_hwInfo.gpuVramMb); }
 QString AppController::gpuDriverVersion() const { return m_hwInfo.gpuDriverVersion; }
 int     AppController::cpuL2CacheKb()     const { return static_cast<int>(m_hwInfo.cpuL2CacheKb); }
@@ -68,6 +194,7 @@ QString AppController::biosDate()         const { return m_hwInfo.biosDate; }
 QString AppController::tpmVersion()       const { return m_hwInfo.tpmVersion; }
 bool    AppController::secureBootEnabled()const { return m_hwInfo.secureBootEnabled; }
 QString AppController::chassisType()      const { return m_hwInfo.chassisType; }
+bool    AppController::hardwareReady()    const { return m_hardwareReady; }
 
 QString AppController::totalRam() const { return ramText(); }
 
@@ -78,6 +205,41 @@ QString AppController::ramText() const
     return QString::number(gb, 'f', 1) + QStringLiteral(" GB");
 }
 
+QString AppController::cpuLayout() const
+{
+    return CpuTopology::summary(m_hwInfo);
+}
+
+QString AppController::ramLayout() const
+{
+    // "2 × 16 GB · dual channel · dual rank · 2 of 4 slots"
+    const QList<quint32> &modules = m_hwInfo.ramModulesMb;
+    if (modules.isEmpty()) return QStringLiteral("Unknown");
+
+    QStringList parts;
+    const bool matched = std::all_of(modules.begin(), modules.end(),
+                                     [&](quint32 mb) { return mb == modules.first(); });
+    auto gb = [](quint32 mb) { return QString::number(mb / 1024.0, 'g', 3) + QStringLiteral(" GB"); };
+    if (matched) {
+        parts << QStringLiteral("%1 × %2").arg(modules.size()).arg(gb(modules.first()));
+    } else {
+        QStringList sizes;
+        for (quint32 mb : modules) sizes << gb(mb);
+        parts << sizes.join(QStringLiteral(" + "));
+    }
+
+    static const char *const kCount[] = { "", "single", "dual", "triple", "quad" };
+    auto count = [](int n, const char *what) {
+        return n < 5 ? QStringLiteral("%1 %2").arg(QLatin1String(kCount[n]), QLatin1String(what))
+                     : QStringLiteral("%1-%2").arg(n).arg(QLatin1String(what));
+    };
+    if (m_hwInfo.ramChannels > 0) parts << count(m_hwInfo.ramChannels, "channel");
+    if (m_hwInfo.ramRanks > 0)    parts << count(m_hwInfo.ramRanks, "rank");
+    if (m_hwInfo.ramSlots > 0)
+        parts << QStringLiteral("%1 of %2 slots").arg(modules.size()).arg(m_hwInfo.ramSlots);
+    return parts.join(QStringLiteral(" · "));
+}
+
 QString AppController::storageText() const
 {
     return m_hwInfo.storage.isEmpty()
@@ -107,6 +269,7 @@ int  AppController::recommendedCount() const { return m_engine.recommendedCount(
 TweakListModel *AppController::tweaksModel()       { return &m_model; }
 QVariantList    AppController::startupSuggestions() const { return m_startupSuggestions; }
 QStringList     AppController::categories()         const { return m_engine.categories(); }
+bool            AppController::tweaksReady()        const { return m_tweaksReady; }
 
 // System Monitor
 SystemMonitor *AppController::systemMonitor() { return &m_systemMonitor; }
@@ -142,17 +305,12 @@ void    AppController::setFilterText(const QString &text)
 // ---------------------------------------------------------------------------
 void AppController::refreshHardware()
 {
-    m_hwInfo = m_detector.detect();
-    m_engine.updateRecommendations(m_hwInfo);
-    m_model.refresh();
-    m_scorer.score(m_hwInfo);
-    m_gameBenchmark.setHardware(m_hwInfo, &m_scorer);
-    emit hardwareChanged();
-    emit tweaksChanged();
+    startHardwareDetection();
 }
 
 void AppController::applyRecommended()
 {
+    TRACE_SCOPE("app", "applyRecommended");
     m_engine.applyRecommended();
     m_model.refresh();
     emit tweaksChanged();
@@ -160,6 +318,7 @@ void AppController::applyRecommended()
 
 void AppController::restoreDefaults()
 {
+    TRACE_SCOPE("app", "restoreDefaults");
     m_engine.restoreDefaults();
     m_model.refresh();
     emit tweaksChanged();
@@ -167,6 +326,7 @@ void AppController::restoreDefaults()
 
 void AppController::toggleTweak(int row)
 {
+    TRACE_SCOPE("app", "toggleTweak");
     if (!m_model.isValidRow(row)) return;
     const QString id = m_model.tweakIdForRow(row);
     m_engine.toggleTweak(id);
@@ -180,12 +340,6 @@ bool AppController::requestAdmin()
     return UacHelper::relaunchAsAdmin();
 }
 
-void AppController::refreshStartupSuggestions()
-{
-    m_startupSuggestions = m_startupScanner.scan();
-    emit startupChanged();
-}
-
 // New actions
 void AppController::applyAllGaming()
 {
@@ -221,10 +375,20 @@ void AppController::flushDns()
 QVariantList AppController::benchmarkResults() const     { return m_benchmark.results(); }
 bool         AppController::benchmarkRunning() const     { return m_benchmark.running(); }
 bool         AppController::benchmarkHasBaseline() const { return m_benchmark.hasBaseline(); }
+QVariantMap  AppController::coreScan() const             { return m_benchmark.coreScan(); }
 
 void AppController::runBaseline()    { m_benchmark.runBaseline(); }
 void AppController::runAfterTweaks() { m_benchmark.runAfterTweaks(); }
 void AppController::resetBenchmark() { m_benchmark.reset(); }
+void AppController::runCoreScan()    { m_benchmark.runCoreScan(); }
+
+void AppController::calibrateScores() { m_benchmark.runCalibration(); }
+
+void AppController::resetCalibration()
+{
+    m_calibration.clear();
+    rescore();
+}
 
 // ---------------------------------------------------------------------------
 // Hardware Scorer
@@ -284,6 +448,7 @@ QStringList AppController::appliedTweakIds() const
 // ---------------------------------------------------------------------------
 bool AppController::verifyTweak(int row)
 {
+    TRACE_SCOPE("app", "verifyTweak");
     if (!m_model.isValidRow(row)) return false;
     const QString id = m_model.tweakIdForRow(row);
     bool ok = m_engine.verifyTweak(id);
@@ -293,6 +458,7 @@ bool AppController::verifyTweak(int row)
 
 void AppController::verifyAllTweaks()
 {
+    TRACE_SCOPE("app", "verifyAllTweaks");
     m_engine.verifyAllTweaks();
     m_model.refresh();
     emit tweaksChanged();
@@ -300,6 +466,7 @@ void AppController::verifyAllTweaks()
 
 void AppController::batchApplyTweaks(QVariantList rowIndices)
 {
+    TRACE_SCOPE("app", "batchApplyTweaks");
     int total = rowIndices.size();
     for (int i = 0; i < total; ++i) {
         int row = rowIndices[i].toInt();
@@ -6,6 +6,7 @@
 #include <QVariantList>
 
 #include "app/HardwareDetector.h"
+#include "app/HardwareCache.h"
 #include "app/TweakEngine.h"
 #include "app/TweakListModel.h"
 #include "app/StartupScanner.h"
@@ -13,6 +14,7 @@
 #include "app/BenchmarkEngine.h"
 #include "app/SystemMonitor.h"
 #include "app/HardwareScorer.h"
+#include "app/ScoreCalibration.h"
 #include "app/GameBenchmark.h"
 #include "app/ConfigManager.h"
 
@@ -28,6 +30,7 @@ class AppController : public QObject
     Q_PROPERTY(QString ramText          READ ramText          NOTIFY hardwareChanged)
     Q_PROPERTY(int     cpuCores         READ cpuCores         NOTIFY hardwareChanged)
     Q_PROPERTY(int     cpuThreads       READ cpuThreads       NOTIFY hardwareChanged)
+    Q_PROPERTY(QString cpuLayout        READ cpuLayout        NOTIFY hardwareChanged)
     Q_PROPERTY(QString motherboardName  READ motherboardName  NOTIFY hardwareChanged)
     Q_PROPERTY(QString storageText      READ storageText      NOTIFY hardwareChanged)
     Q_PROPERTY(QString diskModel        READ diskModel        NOTIFY hardwareChanged)
@@ -37,6 +40,8 @@ class AppController : public QObject
     // Lag 2: Low-Level
     Q_PROPERTY(QString ramType          READ ramType          NOTIFY hardwareChanged)
     Q_PROPERTY(int     ramSpeedMhz      READ ramSpeedMhz      NOTIFY hardwareChanged)
+    Q_PROPERTY(int     ramChannels      READ ramChannels      NOTIFY hardwareChanged)
+    Q_PROPERTY(QString ramLayout        READ ramLayout        NOTIFY hardwareChanged)
     Q_PROPERTY(int     gpuVramMb        READ gpuVramMb        NOTIFY hardwareChanged)
     Q_PROPERTY(QString gpuDriverVersion READ gpuDriverVersion NOTIFY hardwareChanged)
     Q_PROPERTY(int     cpuL2CacheKb     READ cpuL2CacheKb     NOTIFY hardwareChanged)
@@ -47,6 +52,8 @@ class AppController : public QObject
     Q_PROPERTY(QString tpmVersion       READ tpmVersion       NOTIFY hardwareChanged)
     Q_PROPERTY(bool    secureBootEnabled READ secureBootEnabled NOTIFY hardwareChanged)
     Q_PROPERTY(QString chassisType      READ chassisType      NOTIFY hardwareChanged)
+    // False while probes are still reporting; fields above may be partial
+    Q_PROPERTY(bool    hardwareReady    READ hardwareReady    NOTIFY hardwareChanged)
 
     // State
     Q_PROPERTY(bool    isAdmin          READ isAdmin          CONSTANT)
@@ -57,7 +64,8 @@ class AppController : public QObject
     Q_PROPERTY(TweakListModel* tweaksModel READ tweaksModel CONSTANT)
     Q_PROPERTY(TweakListModel* tweakModel  READ tweaksModel CONSTANT)
     Q_PROPERTY(QVariantList startupSuggestions READ startupSuggestions NOTIFY startupChanged)
-    Q_PROPERTY(QStringList  categories        READ categories         CONSTANT)
+    Q_PROPERTY(QStringList  categories        READ categories         NOTIFY tweaksChanged)
+    Q_PROPERTY(bool         tweaksReady       READ tweaksReady        NOTIFY tweaksChanged)
 
     // Settings
     Q_PROPERTY(QString cs2Path          READ cs2Path   WRITE setCs2Path NOTIFY cs2PathChanged)
@@ -68,6 +76,7 @@ class AppController : public QObject
     Q_PROPERTY(QVariantList benchmarkResults    READ benchmarkResults    NOTIFY benchmarkChanged)
     Q_PROPERTY(bool         benchmarkRunning    READ benchmarkRunning    NOTIFY benchmarkRunningChanged)
     Q_PROPERTY(bool         benchmarkHasBaseline READ benchmarkHasBaseline NOTIFY benchmarkChanged)
+    Q_PROPERTY(QVariantMap  coreScan            READ coreScan            NOTIFY coreScanChanged)
 
     // System Monitor
     Q_PROPERTY(SystemMonitor* systemMonitor READ systemMonitor CONSTANT)
@@ -92,6 +101,7 @@ public:
     QString ramText() const;
     int     cpuCores() const;
     int     cpuThreads() const;
+    QString cpuLayout() const;
     QString motherboardName() const;
     QString storageText() const;
     QString diskModel() const;
@@ -101,6 +111,8 @@ public:
     // Lag 2
     QString ramType() const;
     int     ramSpeedMhz() const;
+    int     ramChannels() const;
+    QString ramLayout() const;
     int     gpuVramMb() const;
     QString gpuDriverVersion() const;
     int     cpuL2CacheKb() const;
@@ -111,6 +123,7 @@ public:
     QString tpmVersion() const;
     bool    secureBootEnabled() const;
     QString chassisType() const;
+    bool    hardwareReady() const;
 
     // State
     bool isAdmin() const;
@@ -121,6 +134,7 @@ public:
     TweakListModel* tweaksModel();
     QVariantList    startupSuggestions() const;
     QStringList     categories() const;
+    bool            tweaksReady() const;
 
     // Settings
     QString cs2Path() const;
@@ -134,6 +148,7 @@ public:
     QVariantList benchmarkResults() const;
     bool benchmarkRunning() const;
     bool benchmarkHasBaseline() const;
+    QVariantMap coreScan() const;
 
     // System Monitor
     SystemMonitor* systemMonitor();
@@ -147,6 +162,13 @@ public:
     // Config Manager
     ConfigManager* configManager();
 
+    /// Staged start-up, run once the window is up: cached hardware and
+    /// scores first, then the tweak catalog and startup scan on worker
+    /// threads, detection and the monitor in the background. Readiness is
+    /// announced through tweaksChanged (tweaksReady), hardwareChanged
+    /// (hardwareReady) and startupChanged.
+    Q_INVOKABLE void initialize();
+
     // Actions
     Q_INVOKABLE void refreshHardware();
     Q_INVOKABLE void applyRecommended();
@@ -156,6 +178,13 @@ public:
     Q_INVOKABLE void runBaseline();
     Q_INVOKABLE void runAfterTweaks();
     Q_INVOKABLE void resetBenchmark();
+    // Per-core throughput under pinned load; flags throttled or parked cores.
+    Q_INVOKABLE void runCoreScan();
+
+    // Score calibration: every benchmark pass feeds the measured scores;
+    // calibrateScores() runs one pass just for that.
+    Q_INVOKABLE void calibrateScores();
+    Q_INVOKABLE void resetCalibration();
 
     // New QML-invokable actions
     Q_INVOKABLE void applyAllGaming();
@@ -190,14 +219,23 @@ signals:
     void filterTextChanged();
     void benchmarkChanged();
     void benchmarkRunningChanged();
+    void coreScanChanged();
+    void scoresChanged();
     void batchProgress(int current, int total, QString name, QString status);
     void batchComplete();
 
 private:
-    void refreshStartupSuggestions();
+    void startHardwareDetection();
+    void applyHardware();
+    void rescore();
 
     HardwareDetector m_detector;
+    HardwareCache    m_hwCache;
     HardwareInfo     m_hwInfo;
+    HardwareInfo     m_pendingHwInfo;     // merged probe results of the running detection
+    bool             m_hardwareReady = false;
+    bool             m_detecting     = false;
+    bool             m_tweaksReady   = false;
     TweakEngine      m_engine;
     TweakListModel   m_model;
     StartupScanner   m_startupScanner;
@@ -206,6 +244,7 @@ private:
     BenchmarkEngine  m_benchmark;
     SystemMonitor    m_systemMonitor;
     HardwareScorer   m_scorer;
+    ScoreCalibration m_calibration;
     GameBenchmark    m_gameBenchmark;
     ConfigManager    m_configManager;
     QString          m_filterText;
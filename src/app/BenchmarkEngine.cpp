@@ -1,5 +1,9 @@
 #include "app/BenchmarkEngine.h"
+#include "app/CpuTopology.h"
+#include "app/Trace.h"
 
+#include <QDateTime>
+#include <QHash>
 #include <QThread>
 #include <QElapsedTimer>
 #include <QTemporaryFile>
@@ -56,12 +60,17 @@ bool BenchmarkEngine::hasBaseline() const { return m_hasBaseline; }
 
 void BenchmarkEngine::runBaseline()
 {
-    runBenchmarks(true);
+    runBenchmarks(Pass::Baseline);
 }
 
 void BenchmarkEngine::runAfterTweaks()
 {
-    runBenchmarks(false);
+    runBenchmarks(Pass::AfterTweaks);
+}
+
+void BenchmarkEngine::runCalibration()
+{
+    runBenchmarks(Pass::Calibration);
 }
 
 void BenchmarkEngine::reset()
@@ -71,7 +80,7 @@ void BenchmarkEngine::reset()
     emit resultsChanged();
 }
 
-void BenchmarkEngine::runBenchmarks(bool isBaseline)
+void BenchmarkEngine::runBenchmarks(Pass pass)
 {
     if (m_running) return;
     m_running = true;
@@ -79,19 +88,43 @@ void BenchmarkEngine::runBenchmarks(bool isBaseline)
 
     // Run benchmarks in a thread to keep UI responsive
     auto *watcher = new QFutureWatcher<void>(this);
-    connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, isBaseline]() {
+    connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher, pass]() {
         watcher->deleteLater();
 
-        if (isBaseline) {
+        if (pass == Pass::Baseline) {
             m_hasBaseline = true;
         }
 
         m_running = false;
         emit runningChanged();
-        emit resultsChanged();
+        if (pass != Pass::Calibration)
+            emit resultsChanged();
+        emit sampleReady();
     });
 
-    watcher->setFuture(QtConcurrent::run([this, isBaseline]() {
+    watcher->setFuture(QtConcurrent::run([this, pass]() {
+        // Run each benchmark
+        const std::vector<double> scores = {
+            benchMemoryLatency(),
+            benchMemoryBandwidth(),
+            benchCpuSingleThread(),
+            benchCpuMultiThread(),
+            benchDiskSequential(),
+            benchSchedulingLatency()
+        };
+
+        BenchmarkSample sample;
+        sample.memLatencyNs    = scores[0];
+        sample.memBandwidthGbs = scores[1];
+        sample.cpuSingle       = scores[2];
+        sample.cpuMulti        = scores[3];
+        sample.diskMbps        = scores[4];
+        sample.takenAtMs       = QDateTime::currentMSecsSinceEpoch();
+        m_lastSample = sample;
+
+        if (pass == Pass::Calibration)
+            return;
+
         // Initialize result slots on first call
         if (m_results.isEmpty()) {
             m_results = {
@@ -104,20 +137,10 @@ void BenchmarkEngine::runBenchmarks(bool isBaseline)
             };
         }
 
-        // Run each benchmark
-        auto scores = {
-            benchMemoryLatency(),
-            benchMemoryBandwidth(),
-            benchCpuSingleThread(),
-            benchCpuMultiThread(),
-            benchDiskSequential(),
-            benchSchedulingLatency()
-        };
-
         int i = 0;
         for (double val : scores) {
             if (i < m_results.size()) {
-                if (isBaseline)
+                if (pass == Pass::Baseline)
                     m_results[i].baseline = val;
                 else
                     m_results[i].current = val;
@@ -127,11 +150,29 @@ void BenchmarkEngine::runBenchmarks(bool isBaseline)
     }));
 }
 
+void BenchmarkEngine::runCoreScan()
+{
+    if (m_running) return;
+    m_running = true;
+    emit runningChanged();
+
+    auto *watcher = new QFutureWatcher<QVariantMap>(this);
+    connect(watcher, &QFutureWatcher<QVariantMap>::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+        m_coreScan = watcher->result();
+        m_running = false;
+        emit runningChanged();
+        emit coreScanChanged();
+    });
+    watcher->setFuture(QtConcurrent::run([this]() { return scanCores(); }));
+}
+
 // ---------------------------------------------------------------------------
 // Memory Latency — pointer-chasing benchmark (ns per access)
 // ---------------------------------------------------------------------------
 double BenchmarkEngine::benchMemoryLatency() const
 {
+    TRACE_SCOPE("benchmark", "benchMemoryLatency");
     constexpr int SIZE = 4 * 1024 * 1024; // 4M entries = 32MB
     constexpr int ITERS = 2000000;
 
@@ -167,6 +208,7 @@ double BenchmarkEngine::benchMemoryLatency() const
 // ---------------------------------------------------------------------------
 double BenchmarkEngine::benchMemoryBandwidth() const
 {
+    TRACE_SCOPE("benchmark", "benchMemoryBandwidth");
     constexpr size_t SIZE = 64 * 1024 * 1024; // 64MB
     constexpr int ITERS = 4;
 
@@ -199,6 +241,7 @@ double BenchmarkEngine::benchMemoryBandwidth() const
 // ---------------------------------------------------------------------------
 double BenchmarkEngine::benchCpuSingleThread() const
 {
+    TRACE_SCOPE("benchmark", "benchCpuSingleThread");
     constexpr int ITERS = 5000000;
 
     QElapsedTimer timer;
@@ -220,20 +263,58 @@ double BenchmarkEngine::benchCpuSingleThread() const
 }
 
 // ---------------------------------------------------------------------------
-// CPU Multi-Thread — same workload spread across all cores
+// CPU Multi-Thread — same workload on every SMT thread, one pinned worker each
 // ---------------------------------------------------------------------------
 double BenchmarkEngine::benchCpuMultiThread() const
 {
-    const int numThreads = static_cast<int>(std::thread::hardware_concurrency());
-    if (numThreads <= 0) return 0;
+    return benchCpuThreads(cpusFor(ThreadMode::AllThreads)).score;
+}
+
+QList<int> BenchmarkEngine::cpusFor(ThreadMode mode)
+{
+    const CpuTopology &topology = CpuTopology::system();
+    if (topology.isEmpty()) {
+        // No topology: unpinned workers, one per hardware thread
+        if (mode != ThreadMode::AllThreads) return {};
+        return QList<int>(std::max(1, static_cast<int>(std::thread::hardware_concurrency())), -1);
+    }
+    switch (mode) {
+    case ThreadMode::AllThreads:
+        return topology.allThreads();
+    case ThreadMode::PhysicalCores:
+        return topology.primaryThreads();
+    case ThreadMode::PerformanceCores:
+        return topology.isHybrid() ? topology.primaryThreads(CpuTopology::CoreType::Performance)
+                                   : QList<int>();
+    case ThreadMode::OneL3Domain:
+        return topology.l3Domains().size() > 1 ? topology.domainThreads(0, false) : QList<int>();
+    }
+    return {};
+}
+
+BenchmarkEngine::ThreadRun BenchmarkEngine::benchCpuThreads(const QList<int> &cpus) const
+{
+    TRACE_SCOPE("benchmark", "benchCpuThreads");
+    ThreadRun run;
+    const int numThreads = static_cast<int>(cpus.size());
+    if (numThreads == 0) return run;
 
     constexpr int ITERS_PER_THREAD = 5000000;
 
+    // Workers pin themselves, then wait for a common start so each one's
+    // own timing reflects the all-core load.
     std::atomic<int> readyCount{0};
-    QElapsedTimer timer;
+    std::atomic<bool> go{false};
+    std::vector<double> workerMs(numThreads, 0.0);
 
-    auto worker = [&readyCount, ITERS_PER_THREAD]() {
+    auto worker = [&](int index) {
+        CpuTopology::pinCurrentThread(cpus.at(index));   // -1: leave it to the scheduler
         readyCount.fetch_add(1);
+        while (!go.load(std::memory_order_acquire))
+            std::this_thread::yield();
+
+        QElapsedTimer timer;
+        timer.start();
         volatile double result = 1.0;
         for (int i = 1; i <= ITERS_PER_THREAD; ++i) {
             result = result * 1.000001 + 0.000001;
@@ -241,22 +322,114 @@ double BenchmarkEngine::benchCpuMultiThread() const
             result = std::abs(result);
         }
         (void)result;
+        workerMs[index] = timer.nsecsElapsed() / 1e6;
     };
 
-    timer.start();
-
     std::vector<std::thread> threads;
     threads.reserve(numThreads);
     for (int i = 0; i < numThreads; ++i)
-        threads.emplace_back(worker);
+        threads.emplace_back(worker, i);
+    while (readyCount.load() < numThreads)
+        std::this_thread::yield();
+
+    QElapsedTimer timer;
+    timer.start();
+    go.store(true, std::memory_order_release);
     for (auto &t : threads)
         t.join();
-
     const double elapsedMs = timer.nsecsElapsed() / 1e6;
 
     // Total iterations across all threads / ms
-    double score = static_cast<double>(ITERS_PER_THREAD) * numThreads / elapsedMs;
-    return std::round(score);
+    run.score = std::round(static_cast<double>(ITERS_PER_THREAD) * numThreads / elapsedMs);
+    for (double ms : workerMs)
+        run.perWorker.append(std::round(ITERS_PER_THREAD / ms));
+    return run;
+}
+
+QVariantMap BenchmarkEngine::scanCores() const
+{
+    TRACE_SCOPE("benchmark", "scanCores");
+    struct ModeInfo { ThreadMode mode; const char *id; const char *label; };
+    static const ModeInfo kModes[] = {
+        { ThreadMode::AllThreads,       "allThreads",       "All SMT threads" },
+        { ThreadMode::PhysicalCores,    "physicalCores",    "One per physical core" },
+        { ThreadMode::PerformanceCores, "performanceCores", "P-cores only" },
+        { ThreadMode::OneL3Domain,      "oneL3Domain",      "One CCD" },
+    };
+
+    QVariantList modes;
+    ThreadRun perCore;
+    double allThreadsScore = 0;
+    for (const ModeInfo &info : kModes) {
+        const QList<int> cpus = cpusFor(info.mode);
+        if (cpus.isEmpty())
+            continue;
+        const ThreadRun run = benchCpuThreads(cpus);
+        if (info.mode == ThreadMode::PhysicalCores)
+            perCore = run;
+        else if (info.mode == ThreadMode::AllThreads)
+            allThreadsScore = run.score;
+
+        QVariantMap m;
+        m["mode"]    = QString::fromLatin1(info.id);
+        m["label"]   = QString::fromLatin1(info.label);
+        m["threads"] = int(cpus.size());
+        m["score"]   = run.score;
+        m["perThread"] = std::round(run.score / cpus.size());
+        modes.append(m);
+    }
+
+    // Per physical core under all-core load, relative to the median core of
+    // the same type — an E-core is not a slow P-core.
+    const CpuTopology &topology = CpuTopology::system();
+    const QList<CpuTopology::Core> &cores = topology.cores();
+    QVariantList coreList;
+    int slowCores = 0;
+    if (perCore.perWorker.size() == cores.size()) {
+        QHash<int, double> medianByType;
+        for (const auto type : { CpuTopology::CoreType::Unknown, CpuTopology::CoreType::Performance,
+                                 CpuTopology::CoreType::Efficiency }) {
+            std::vector<double> scores;
+            for (int i = 0; i < cores.size(); ++i)
+                if (cores.at(i).type == type)
+                    scores.push_back(perCore.perWorker.at(i));
+            if (scores.empty()) continue;
+            std::nth_element(scores.begin(), scores.begin() + scores.size() / 2, scores.end());
+            medianByType.insert(int(type), scores[scores.size() / 2]);
+        }
+
+        for (int i = 0; i < cores.size(); ++i) {
+            const CpuTopology::Core &core = cores.at(i);
+            const double median = medianByType.value(int(core.type));
+            const double relative = median > 0 ? perCore.perWorker.at(i) / median : 0;
+            const bool slow = relative > 0 && relative < 0.85;   // throttled, parked or busy
+            if (slow) ++slowCores;
+
+            QVariantMap c;
+            c["cpu"]      = core.threads.first();
+            c["package"]  = core.package;
+            c["l3Domain"] = core.l3Domain;
+            c["type"]     = core.type == CpuTopology::CoreType::Efficiency ? QStringLiteral("E")
+                          : core.type == CpuTopology::CoreType::Performance ? QStringLiteral("P")
+                                                                            : QString();
+            c["maxMhz"]   = core.maxMhz;
+            c["score"]    = perCore.perWorker.at(i);
+            c["relative"] = std::round(relative * 100.0) / 100.0;
+            c["slow"]     = slow;
+            coreList.append(c);
+        }
+    }
+
+    QVariantMap result;
+    result["topology"]  = topology.summary();
+    result["modes"]     = modes;
+    result["cores"]     = coreList;
+    result["slowCores"] = slowCores;
+    // What SMT siblings add on top of one thread per core
+    result["smtGainPct"] = perCore.score > 0
+                         ? std::round((allThreadsScore / perCore.score - 1.0) * 100.0) : 0.0;
+    result["takenAtMs"] = QDateTime::currentMSecsSinceEpoch();
+    return result;
 }
 
 // ---------------------------------------------------------------------------
@@ -264,6 +437,7 @@ double BenchmarkEngine::benchCpuMultiThread() const
 // ---------------------------------------------------------------------------
 double BenchmarkEngine::benchDiskSequential() const
 {
+    TRACE_SCOPE("benchmark", "benchDiskSequential");
     const QString tempDir = QStandardPaths::writableLocation(QStandardPaths::TempLocation);
     const QString filePath = tempDir + QStringLiteral("/tweak_bench.tmp");
 
@@ -312,6 +486,7 @@ double BenchmarkEngine::benchDiskSequential() const
 // ---------------------------------------------------------------------------
 double BenchmarkEngine::benchSchedulingLatency() const
 {
+    TRACE_SCOPE("benchmark", "benchSchedulingLatency");
     constexpr int SAMPLES = 1000;
     constexpr int TARGET_US = 1000; // Target 1ms sleep
 
@@ -4,6 +4,19 @@
 #include <QVariantList>
 #include <QVariantMap>
 
+/// Raw measurements of one benchmark pass, in the units BenchmarkEngine reports.
+struct BenchmarkSample
+{
+    double cpuSingle       = 0;   // iterations / ms, one thread
+    double cpuMulti        = 0;   // iterations / ms, all threads
+    double memLatencyNs    = 0;
+    double memBandwidthGbs = 0;
+    double diskMbps        = 0;
+    qint64 takenAtMs       = 0;   // ms since epoch
+
+    bool isValid() const { return cpuSingle > 0 && cpuMulti > 0 && memLatencyNs > 0; }
+};
+
 /// Runs lightweight synthetic benchmarks that measure system responsiveness.
 /// Captures "before" and "after" snapshots so the user can see improvement.
 class BenchmarkEngine : public QObject
@@ -13,8 +26,18 @@ class BenchmarkEngine : public QObject
     Q_PROPERTY(QVariantList results READ results NOTIFY resultsChanged)
     Q_PROPERTY(bool running READ running NOTIFY runningChanged)
     Q_PROPERTY(bool hasBaseline READ hasBaseline NOTIFY resultsChanged)
+    Q_PROPERTY(QVariantMap coreScan READ coreScan NOTIFY coreScanChanged)
 
 public:
+    /// Which logical CPUs the multi-threaded workers are pinned to, one
+    /// worker per CPU.
+    enum class ThreadMode {
+        AllThreads,         // every SMT thread
+        PhysicalCores,      // one per physical core
+        PerformanceCores,   // one per P-core; hybrid CPUs only
+        OneL3Domain,        // every thread of the first CCD/CCX; multi-L3 CPUs only
+    };
+
     explicit BenchmarkEngine(QObject *parent = nullptr);
 
     QVariantList results() const;
@@ -27,12 +50,29 @@ public:
     /// Run "after tweaks" benchmark and compute deltas.
     Q_INVOKABLE void runAfterTweaks();
 
+    /// Measure the system for score calibration only; before/after results
+    /// are left untouched.
+    Q_INVOKABLE void runCalibration();
+
+    /// Run the CPU workload in every thread mode the topology supports and
+    /// measure each physical core under all-core load, so throttled or
+    /// parked cores stand out. Results land in coreScan().
+    Q_INVOKABLE void runCoreScan();
+
     /// Clear all results.
     Q_INVOKABLE void reset();
 
+    QVariantMap coreScan() const { return m_coreScan; }
+
+    /// Measurements of the most recent completed pass of any kind.
+    BenchmarkSample lastSample() const { return m_lastSample; }
+
 signals:
     void resultsChanged();
     void runningChanged();
+    /// A pass finished and lastSample() holds its measurements.
+    void sampleReady();
+    void coreScanChanged();
 
 private:
     struct BenchResult {
@@ -43,15 +83,28 @@ private:
         bool higherIsBetter = true;  // true = higher score is better
     };
 
-    void runBenchmarks(bool isBaseline);
+    enum class Pass { Baseline, AfterTweaks, Calibration };
+
+    /// Total and per-worker throughput, iterations / ms.
+    struct ThreadRun {
+        double score = 0;
+        QList<double> perWorker;
+    };
+
+    void runBenchmarks(Pass pass);
     double benchMemoryLatency() const;
     double benchMemoryBandwidth() const;
     double benchCpuSingleThread() const;
     double benchCpuMultiThread() const;
+    ThreadRun benchCpuThreads(const QList<int> &cpus) const;
+    QVariantMap scanCores() const;
+    static QList<int> cpusFor(ThreadMode mode);
     double benchDiskSequential() const;
     double benchSchedulingLatency() const;
 
     QList<BenchResult> m_results;
+    BenchmarkSample m_lastSample;
+    QVariantMap m_coreScan;
     bool m_running = false;
     bool m_hasBaseline = false;
 };
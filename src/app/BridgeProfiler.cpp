@@ -0,0 +1,121 @@
+#include "app/BridgeProfiler.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonDocument>
+
+#include <algorithm>
+
+BridgeProfiler::BridgeProfiler()
+{
+    m_since.start();
+    m_enabled = qEnvironmentVariableIntValue("TWEAK_BRIDGE_PROFILE") != 0;
+}
+
+void BridgeProfiler::setEnabled(bool on)
+{
+    if (on && !m_enabled)
+        reset();                 // a new profiling window
+    m_enabled = on;
+}
+
+void BridgeProfiler::reset()
+{
+    m_methods.clear();
+    m_signals.clear();
+    m_slowCalls.clear();
+    m_since.restart();
+}
+
+qint64 BridgeProfiler::payloadSize(const QJsonObject &value)
+{
+    return QJsonDocument(value).toJson(QJsonDocument::Compact).size();
+}
+
+qint64 BridgeProfiler::payloadSize(const QJsonArray &value)
+{
+    return QJsonDocument(value).toJson(QJsonDocument::Compact).size();
+}
+
+void BridgeProfiler::recordCall(const char *method, qint64 elapsedNs, qint64 payloadBytes)
+{
+    MethodStats &s = m_methods[QString::fromLatin1(method)];
+    ++s.calls;
+    s.totalNs         += elapsedNs;
+    s.maxNs            = std::max(s.maxNs, elapsedNs);
+    s.payloadBytes    += payloadBytes;
+    s.maxPayloadBytes  = std::max(s.maxPayloadBytes, payloadBytes);
+
+    const double ms = elapsedNs / 1e6;
+    const auto bucket = std::lower_bound(kBucketMs.begin(), kBucketMs.end(), ms) - kBucketMs.begin();
+    ++s.histogram[size_t(bucket)];
+
+    if (ms > kBlockingMs) {
+        ++s.blockingCalls;
+        qWarning().noquote() << "[Bridge]" << method << "blocked the event loop for"
+                             << QString::number(ms, 'f', 1) << "ms";
+        m_slowCalls.append({ QString::fromLatin1(method), ms, QDateTime::currentMSecsSinceEpoch() });
+        if (m_slowCalls.size() > kSlowCallsKept)
+            m_slowCalls.removeFirst();
+    }
+}
+
+void BridgeProfiler::recordSignal(const char *name, qint64 bytes)
+{
+    if (!m_enabled) return;
+    SignalStats &s = m_signals[QString::fromLatin1(name)];
+    ++s.count;
+    s.bytes += bytes;
+}
+
+QJsonObject BridgeProfiler::toJson() const
+{
+    QJsonObject methods;
+    for (auto it = m_methods.cbegin(); it != m_methods.cend(); ++it) {
+        const MethodStats &s = it.value();
+        QJsonArray histogram;
+        for (size_t i = 0; i < s.histogram.size(); ++i) {
+            QJsonObject b;
+            b["leMs"]  = i < kBucketMs.size() ? QJsonValue(kBucketMs[i]) : QJsonValue(QStringLiteral("inf"));
+            b["count"] = double(s.histogram[i]);
+            histogram.append(b);
+        }
+
+        QJsonObject m;
+        m["calls"]           = double(s.calls);
+        m["totalMs"]         = s.totalNs / 1e6;
+        m["meanMs"]          = s.calls ? s.totalNs / 1e6 / s.calls : 0.0;
+        m["maxMs"]           = s.maxNs / 1e6;
+        m["payloadBytes"]    = double(s.payloadBytes);
+        m["maxPayloadBytes"] = double(s.maxPayloadBytes);
+        m["blockingCalls"]   = double(s.blockingCalls);
+        m["histogram"]       = histogram;
+        methods[it.key()] = m;
+    }
+
+    QJsonObject signalStats;
+    for (auto it = m_signals.cbegin(); it != m_signals.cend(); ++it) {
+        QJsonObject s;
+        s["count"] = double(it.value().count);
+        s["bytes"] = double(it.value().bytes);
+        signalStats[it.key()] = s;
+    }
+
+    QJsonArray slow;
+    for (const SlowCall &c : m_slowCalls) {
+        QJsonObject o;
+        o["method"] = c.method;
+        o["ms"]     = c.ms;
+        o["at"]     = QDateTime::fromMSecsSinceEpoch(c.atMs).toString(Qt::ISODateWithMs);
+        slow.append(o);
+    }
+
+    QJsonObject obj;
+    obj["enabled"]    = m_enabled;
+    obj["sinceMs"]    = double(m_since.elapsed());
+    obj["blockingMs"] = kBlockingMs;
+    obj["methods"]    = methods;
+    obj["signals"]    = signalStats;
+    obj["slowCalls"]  = slow;
+    return obj;
+}
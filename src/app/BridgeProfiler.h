@@ -0,0 +1,114 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+
+#include <array>
+
+/// Opt-in instrumentation of WebBridge invocations: per-method call
+/// counts, result payload sizes and latency histograms, plus the signals
+/// pushed to the page. Bridge methods run on the GUI thread, so any call
+/// longer than one 60 Hz frame (kBlockingMs) blocked the event loop; those
+/// are logged and kept in a list of recent offenders.
+///
+/// Enabled by TWEAK_BRIDGE_PROFILE=1 at start-up or setEnabled(). While
+/// disabled a Call costs one branch. GUI thread only.
+class BridgeProfiler
+{
+public:
+    static constexpr double kBlockingMs   = 16.0;
+    static constexpr int    kSlowCallsKept = 64;
+
+    /// Upper bucket bounds in ms; the last bucket takes everything above.
+    static constexpr std::array<double, 11> kBucketMs{
+        { 0.1, 0.25, 0.5, 1, 2, 4, 8, 16, 33, 66, 100 } };
+
+    BridgeProfiler();
+
+    bool enabled() const { return m_enabled; }
+    void setEnabled(bool on);
+    void reset();
+
+    /// Times one bridge method from construction to destruction.
+    class Call
+    {
+    public:
+        Call(BridgeProfiler &profiler, const char *method)
+            : m_profiler(profiler.enabled() ? &profiler : nullptr), m_method(method)
+        {
+            if (m_profiler) m_timer.start();
+        }
+        ~Call()
+        {
+            if (m_profiler)
+                m_profiler->recordCall(m_method, m_elapsedNs >= 0 ? m_elapsedNs : m_timer.nsecsElapsed(),
+                                       m_payloadBytes);
+        }
+        Q_DISABLE_COPY(Call)
+
+        /// Note the size of what goes back to the page; returns value unchanged.
+        /// The call's time stops here, so measuring the size is not counted.
+        template<typename T>
+        const T &payload(const T &value)
+        {
+            if (m_profiler) {
+                m_elapsedNs = m_timer.nsecsElapsed();
+                m_payloadBytes = payloadSize(value);
+            }
+            return value;
+        }
+
+    private:
+        BridgeProfiler *m_profiler;
+        const char     *m_method;
+        QElapsedTimer   m_timer;
+        qint64          m_elapsedNs = -1;     // set by payload()
+        qint64          m_payloadBytes = 0;
+    };
+
+    /// A signal carried `bytes` of payload to the page.
+    void recordSignal(const char *name, qint64 bytes);
+
+    /// Serialized size as QWebChannel would send it.
+    static qint64 payloadSize(const QJsonObject &value);
+    static qint64 payloadSize(const QJsonArray &value);
+    static qint64 payloadSize(const QString &value) { return value.size(); }
+
+    /// { enabled, sinceMs, blockingMs, methods: { name: {...} }, signals, slowCalls }.
+    QJsonObject toJson() const;
+
+private:
+    struct MethodStats
+    {
+        qint64 calls           = 0;
+        qint64 totalNs         = 0;
+        qint64 maxNs           = 0;
+        qint64 payloadBytes    = 0;
+        qint64 maxPayloadBytes = 0;
+        qint64 blockingCalls   = 0;
+        std::array<qint64, kBucketMs.size() + 1> histogram{};
+    };
+    struct SignalStats
+    {
+        qint64 count = 0;
+        qint64 bytes = 0;
+    };
+    struct SlowCall
+    {
+        QString method;
+        double  ms;
+        qint64  atMs;      // since epoch
+    };
+
+    void recordCall(const char *method, qint64 elapsedNs, qint64 payloadBytes);
+
+    bool                        m_enabled = false;
+    QElapsedTimer               m_since;
+    QHash<QString, MethodStats> m_methods;
+    QHash<QString, SignalStats> m_signals;
+    QList<SlowCall>             m_slowCalls;     // newest last, at most kSlowCallsKept
+};
@@ -0,0 +1,112 @@
+#include "app/BulkPayload.h"
+
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+constexpr int kHeaderSize = 12;       // magic, rows, columns
+
+template<typename T>
+void putLittleEndian(QByteArray &data, qsizetype offset, T value)
+{
+    qToLittleEndian<T>(value, data.data() + offset);
+}
+
+} // anonymous namespace
+
+BulkPayload::BulkPayload(int rows)
+    : m_rows(std::max(rows, 0))
+{
+    m_data.reserve(4096);
+    m_data.append("TBP1", 4);
+    m_data.append(kHeaderSize - 4, '\0');   // rows and columns, filled in by toBytes()
+}
+
+void BulkPayload::alignTo(int alignment)
+{
+    const qsizetype pad = (alignment - m_data.size() % alignment) % alignment;
+    m_data.append(pad, '\0');
+}
+
+qsizetype BulkPayload::beginColumn(ColumnType type, const QString &name, quint32 dataBytes)
+{
+    const QByteArray utf8 = name.toUtf8().left(255);
+    m_data.append(char(type));
+    m_data.append(char(utf8.size()));
+    m_data.append(utf8);
+
+    alignTo(4);
+    const qsizetype lengthAt = m_data.size();
+    m_data.append(4, '\0');
+    putLittleEndian<quint32>(m_data, lengthAt, dataBytes);
+
+    // 8-byte aligned from the buffer start, so Float64Array can view it in place
+    alignTo(8);
+    const qsizetype dataAt = m_data.size();
+    m_data.append(qsizetype(dataBytes), '\0');
+    ++m_columns;
+    return dataAt;
+}
+
+void BulkPayload::addFloat64(const QString &name, const QList<double> &values)
+{
+    const qsizetype at = beginColumn(ColumnType::Float64, name, quint32(m_rows * 8));
+    for (int i = 0; i < m_rows && i < values.size(); ++i)
+        putLittleEndian<double>(m_data, at + i * 8, values.at(i));
+}
+
+void BulkPayload::addFloat32(const QString &name, const QList<double> &values)
+{
+    const qsizetype at = beginColumn(ColumnType::Float32, name, quint32(m_rows * 4));
+    for (int i = 0; i < m_rows && i < values.size(); ++i)
+        putLittleEndian<float>(m_data, at + i * 4, float(values.at(i)));
+}
+
+void BulkPayload::addInt32(const QString &name, const QList<qint32> &values)
+{
+    const qsizetype at = beginColumn(ColumnType::Int32, name, quint32(m_rows * 4));
+    for (int i = 0; i < m_rows && i < values.size(); ++i)
+        putLittleEndian<qint32>(m_data, at + i * 4, values.at(i));
+}
+
+void BulkPayload::addBool(const QString &name, const QList<bool> &values)
+{
+    const qsizetype at = beginColumn(ColumnType::Bool, name, quint32(m_rows));
+    for (int i = 0; i < m_rows && i < values.size(); ++i)
+        m_data[at + i] = values.at(i) ? 1 : 0;
+}
+
+void BulkPayload::addString(const QString &name, const QStringList &values)
+{
+    QByteArray text;
+    QList<quint32> offsets;
+    offsets.reserve(m_rows + 1);
+    offsets.append(0);
+    for (int i = 0; i < m_rows; ++i) {
+        if (i < values.size())
+            text.append(values.at(i).toUtf8());
+        offsets.append(quint32(text.size()));
+    }
+
+    const quint32 offsetBytes = quint32(offsets.size() * 4);
+    const qsizetype at = beginColumn(ColumnType::String, name, offsetBytes + quint32(text.size()));
+    for (int i = 0; i < offsets.size(); ++i)
+        putLittleEndian<quint32>(m_data, at + i * 4, offsets.at(i));
+    std::memcpy(m_data.data() + at + offsetBytes, text.constData(), size_t(text.size()));
+}
+
+QByteArray BulkPayload::toBytes() const
+{
+    QByteArray out = m_data;
+    putLittleEndian<quint32>(out, 4, quint32(m_rows));
+    putLittleEndian<quint32>(out, 8, m_columns);
+    return out;
+}
+
+QString BulkPayload::toBase64() const
+{
+    return QString::fromLatin1(toBytes().toBase64());
+}
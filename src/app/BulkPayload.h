@@ -0,0 +1,47 @@
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/// Columnar binary container for large bridge transfers (tweak catalog,
+/// monitor history). One buffer holds every column back to back, so the
+/// page reads numeric columns as typed-array views instead of parsing JSON
+/// text — see readBulk() in web/index.html.
+///
+/// Layout, little-endian:
+///   "TBP1" | u32 rows | u32 columns
+///   per column: u8 type | u8 nameLength | name (UTF-8)
+///               | pad to 4 | u32 dataBytes | pad to 8 | data
+/// Strings are u32 offsets[rows + 1] into the UTF-8 bytes that follow.
+class BulkPayload
+{
+public:
+    enum class ColumnType : quint8 { Float64 = 1, Float32, Int32, Bool, String };
+
+    explicit BulkPayload(int rows);
+
+    int rows() const { return m_rows; }
+
+    /// Every column holds rows() values; shorter lists are zero-padded,
+    /// longer ones truncated.
+    void addFloat64(const QString &name, const QList<double> &values);
+    void addFloat32(const QString &name, const QList<double> &values);
+    void addInt32(const QString &name, const QList<qint32> &values);
+    void addBool(const QString &name, const QList<bool> &values);
+    void addString(const QString &name, const QStringList &values);
+
+    QByteArray toBytes() const;
+    /// What goes over QWebChannel: one string, no per-field JSON.
+    QString toBase64() const;
+
+private:
+    /// Column header; returns the offset where dataBytes of data start.
+    qsizetype beginColumn(ColumnType type, const QString &name, quint32 dataBytes);
+    void alignTo(int alignment);
+
+    QByteArray m_data;
+    int        m_rows;
+    quint32    m_columns = 0;
+};
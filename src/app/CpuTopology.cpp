@@ -0,0 +1,435 @@
+#include "app/CpuTopology.h"
+#include "app/HardwareDetector.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QHash>
+#include <QSet>
+
+#include <algorithm>
+#include <bitset>
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#include <powerbase.h>
+#pragma comment(lib, "powrprof.lib")
+#elif defined(Q_OS_LINUX)
+#include <sched.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+namespace {
+
+QString readAttr(const QString &path)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return {};
+    return QString::fromLatin1(f.read(4096)).trimmed();
+}
+
+/// Kernel cpu list format: "0-3,8,10-11".
+QList<int> parseCpuList(const QString &list)
+{
+    QList<int> cpus;
+    for (const QString &part : list.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        const int dash = part.indexOf(QLatin1Char('-'));
+        bool okA = false, okB = true;
+        const int a = part.left(dash < 0 ? part.size() : dash).toInt(&okA);
+        const int b = dash < 0 ? a : part.mid(dash + 1).toInt(&okB);
+        if (!okA || !okB || b < a)
+            continue;
+        for (int cpu = a; cpu <= b; ++cpu)
+            cpus.append(cpu);
+    }
+    return cpus;
+}
+
+const char *typeName(CpuTopology::CoreType type)
+{
+    switch (type) {
+    case CpuTopology::CoreType::Performance: return "performance";
+    case CpuTopology::CoreType::Efficiency:  return "efficiency";
+    default:                                 return "unknown";
+    }
+}
+
+#ifdef Q_OS_WIN
+/// Documented for CallNtPowerInformation(ProcessorInformation) but not
+/// declared by the SDK headers.
+struct ProcessorPowerInformation
+{
+    ULONG Number;
+    ULONG MaxMhz;
+    ULONG CurrentMhz;
+    ULONG MhzLimit;
+    ULONG MaxIdleState;
+    ULONG CurrentIdleState;
+};
+
+QList<int> maskCpus(const GROUP_AFFINITY &affinity)
+{
+    QList<int> cpus;
+    const std::bitset<sizeof(KAFFINITY) * 8> bits(affinity.Mask);
+    for (size_t bit = 0; bit < bits.size(); ++bit)
+        if (bits.test(bit))
+            cpus.append(affinity.Group * 64 + int(bit));
+    return cpus;
+}
+#endif
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Detection
+// ---------------------------------------------------------------------------
+const CpuTopology &CpuTopology::system()
+{
+    static const CpuTopology topology = [] {
+        QElapsedTimer timer;
+        timer.start();
+#ifdef Q_OS_WIN
+        CpuTopology t = fromWindows();
+#else
+        CpuTopology t = fromSysfs();
+#endif
+        qDebug() << "[HW] CPU topology:" << t.summary() << "in" << timer.elapsed() << "ms";
+        return t;
+    }();
+    return topology;
+}
+
+CpuTopology CpuTopology::fromSysfs(const QString &sysRoot)
+{
+    CpuTopology t;
+    const QDir cpuDir(sysRoot + QStringLiteral("/devices/system/cpu"));
+
+    // Hybrid Intel parts expose one PMU per core type; big.LITTLE ARM parts
+    // expose a relative capacity per CPU instead.
+    const QList<int> pCores = parseCpuList(readAttr(sysRoot + QStringLiteral("/devices/cpu_core/cpus")));
+    const QList<int> eCores = parseCpuList(readAttr(sysRoot + QStringLiteral("/devices/cpu_atom/cpus")));
+    QHash<int, int> capacity;
+
+    QHash<QString, int> coreBySiblings;   // sibling list → index into m_cores
+    QHash<QString, int> l3ByShared;       // shared_cpu_list → index into m_l3
+
+    const QStringList entries = cpuDir.entryList({ QStringLiteral("cpu[0-9]*") }, QDir::Dirs | QDir::System);
+    for (const QString &entry : entries) {
+        bool ok = false;
+        const int cpu = entry.mid(3).toInt(&ok);
+        if (!ok)
+            continue;
+        const QString base = cpuDir.filePath(entry);
+        if (readAttr(base + QStringLiteral("/online")) == QStringLiteral("0"))
+            continue;                        // offline CPUs have no topology
+
+        const QString topo = base + QStringLiteral("/topology/");
+        QString siblings = readAttr(topo + QStringLiteral("core_cpus_list"));
+        if (siblings.isEmpty())
+            siblings = readAttr(topo + QStringLiteral("thread_siblings_list"));
+        if (siblings.isEmpty())
+            siblings = QString::number(cpu);
+
+        auto it = coreBySiblings.constFind(siblings);
+        if (it == coreBySiblings.constEnd()) {
+            Core core;
+            core.package = readAttr(topo + QStringLiteral("physical_package_id")).toInt();
+            core.die     = readAttr(topo + QStringLiteral("die_id")).toInt();
+            if (pCores.contains(cpu))      core.type = CoreType::Performance;
+            else if (eCores.contains(cpu)) core.type = CoreType::Efficiency;
+            it = coreBySiblings.insert(siblings, int(t.m_cores.size()));
+            t.m_cores.append(core);
+        }
+        Core &core = t.m_cores[*it];
+        core.threads.append(cpu);
+        core.maxMhz = std::max(core.maxMhz,
+                               readAttr(base + QStringLiteral("/cpufreq/cpuinfo_max_freq")).toUInt() / 1000);
+
+        const QString cap = readAttr(base + QStringLiteral("/cpu_capacity"));
+        if (!cap.isEmpty())
+            capacity.insert(cpu, cap.toInt());
+
+        const QDir cacheDir(base + QStringLiteral("/cache"));
+        for (const QString &index : cacheDir.entryList({ QStringLiteral("index*") }, QDir::Dirs)) {
+            const QString cache = cacheDir.filePath(index) + QLatin1Char('/');
+            if (readAttr(cache + QStringLiteral("level")) != QStringLiteral("3"))
+                continue;
+            const QString shared = readAttr(cache + QStringLiteral("shared_cpu_list"));
+            if (shared.isEmpty() || l3ByShared.contains(shared))
+                continue;
+            CacheDomain domain;
+            QString size = readAttr(cache + QStringLiteral("size"));   // "32768K"
+            const quint32 scale = size.endsWith(QLatin1Char('M')) ? 1024 : 1;
+            if (size.endsWith(QLatin1Char('K')) || size.endsWith(QLatin1Char('M')))
+                size.chop(1);
+            domain.sizeKb = size.toUInt() * scale;
+            domain.cpus   = parseCpuList(shared);
+            l3ByShared.insert(shared, int(t.m_l3.size()));
+            t.m_l3.append(domain);
+        }
+    }
+
+    // big.LITTLE: the highest-capacity cores are the performance cores
+    if (pCores.isEmpty() && !capacity.isEmpty()) {
+        const int top = *std::max_element(capacity.cbegin(), capacity.cend());
+        const int low = *std::min_element(capacity.cbegin(), capacity.cend());
+        if (top != low)
+            for (Core &core : t.m_cores)
+                core.type = capacity.value(core.threads.first()) == top ? CoreType::Performance
+                                                                        : CoreType::Efficiency;
+    }
+
+    t.finish();
+    return t;
+}
+
+#ifdef Q_OS_WIN
+CpuTopology CpuTopology::fromWindows()
+{
+    CpuTopology t;
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+    QByteArray buffer(int(length), '\0');
+    if (length == 0 ||
+        !GetLogicalProcessorInformationEx(
+            RelationAll, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length))
+        return t;
+
+    QHash<int, int> packageOf;            // logical CPU → package index
+    QSet<BYTE> efficiencyClasses;
+    QList<BYTE> coreClass;
+    int packages = 0;
+    for (DWORD offset = 0; offset < length;) {
+        const auto *entry = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *>(
+            buffer.constData() + offset);
+        switch (entry->Relationship) {
+        case RelationProcessorPackage:
+            for (WORD g = 0; g < entry->Processor.GroupCount; ++g)
+                for (int cpu : maskCpus(entry->Processor.GroupMask[g]))
+                    packageOf.insert(cpu, packages);
+            ++packages;
+            break;
+        case RelationProcessorCore: {
+            Core core;
+            for (WORD g = 0; g < entry->Processor.GroupCount; ++g)
+                core.threads += maskCpus(entry->Processor.GroupMask[g]);
+            t.m_cores.append(core);
+            coreClass.append(entry->Processor.EfficiencyClass);
+            efficiencyClasses.insert(entry->Processor.EfficiencyClass);
+            break;
+        }
+        case RelationCache:
+            if (entry->Cache.Level == 3) {
+                CacheDomain domain;
+                domain.sizeKb = entry->Cache.CacheSize / 1024;
+                domain.cpus   = maskCpus(entry->Cache.GroupMask);
+                t.m_l3.append(domain);
+            }
+            break;
+        default:
+            break;
+        }
+        offset += entry->Size;
+    }
+
+    // EfficiencyClass only differs on hybrid parts; higher is faster
+    const BYTE topClass = efficiencyClasses.isEmpty() ? 0 : *std::max_element(efficiencyClasses.cbegin(),
+                                                                              efficiencyClasses.cend());
+    for (int i = 0; i < t.m_cores.size(); ++i) {
+        Core &core = t.m_cores[i];
+        core.package = packageOf.value(core.threads.value(0));
+        core.die     = core.package;         // dies are not reported before Windows 11
+        if (efficiencyClasses.size() > 1)
+            core.type = coreClass.at(i) == topClass ? CoreType::Performance : CoreType::Efficiency;
+    }
+
+    // Rated maximum clock per logical processor. The array holds one entry
+    // per active processor, group by group in mask order, so the index is
+    // the processor's rank among the active ones, not group * 64 + bit.
+    const DWORD count = GetActiveProcessorCount(ALL_PROCESSOR_GROUPS);
+    QList<ProcessorPowerInformation> power(int(count));
+    if (CallNtPowerInformation(ProcessorInformation, nullptr, 0, power.data(),
+                               ULONG(power.size() * sizeof(ProcessorPowerInformation))) == 0) {
+        QList<int> active;
+        for (const Core &core : t.m_cores)
+            active += core.threads;
+        std::sort(active.begin(), active.end());
+        for (Core &core : t.m_cores)
+            for (int cpu : core.threads) {
+                const auto rank = std::lower_bound(active.cbegin(), active.cend(), cpu) - active.cbegin();
+                if (rank < power.size())
+                    core.maxMhz = std::max(core.maxMhz, quint32(power.at(rank).MaxMhz));
+            }
+    }
+
+    t.finish();
+    return t;
+}
+#endif
+
+void CpuTopology::finish()
+{
+    for (Core &core : m_cores)
+        std::sort(core.threads.begin(), core.threads.end());
+    m_cores.erase(std::remove_if(m_cores.begin(), m_cores.end(),
+                                 [](const Core &c) { return c.threads.isEmpty(); }),
+                  m_cores.end());
+    std::sort(m_cores.begin(), m_cores.end(),
+              [](const Core &a, const Core &b) { return a.threads.first() < b.threads.first(); });
+
+    QSet<int> packages;
+    QSet<QPair<int, int>> dies;
+    for (Core &core : m_cores) {
+        packages.insert(core.package);
+        dies.insert({ core.package, core.die });
+        core.l3Domain = -1;
+        for (int d = 0; d < m_l3.size() && core.l3Domain < 0; ++d)
+            if (m_l3.at(d).cpus.contains(core.threads.first()))
+                core.l3Domain = d;
+    }
+    m_packages = int(packages.size());
+    m_dies     = int(dies.size());
+}
+
+// ---------------------------------------------------------------------------
+// Queries
+// ---------------------------------------------------------------------------
+int CpuTopology::threadCount() const
+{
+    int n = 0;
+    for (const Core &core : m_cores)
+        n += int(core.threads.size());
+    return n;
+}
+
+int CpuTopology::coreCount(CoreType type) const
+{
+    return int(std::count_if(m_cores.begin(), m_cores.end(),
+                             [type](const Core &c) { return c.type == type; }));
+}
+
+QList<int> CpuTopology::primaryThreads(CoreType type) const
+{
+    QList<int> cpus;
+    for (const Core &core : m_cores)
+        if (type == CoreType::Unknown || core.type == type)
+            cpus.append(core.threads.first());
+    return cpus;
+}
+
+QList<int> CpuTopology::allThreads() const
+{
+    QList<int> cpus;
+    for (const Core &core : m_cores)
+        cpus += core.threads;
+    std::sort(cpus.begin(), cpus.end());
+    return cpus;
+}
+
+QList<int> CpuTopology::domainThreads(int l3Domain, bool primaryOnly) const
+{
+    QList<int> cpus;
+    for (const Core &core : m_cores) {
+        if (core.l3Domain != l3Domain)
+            continue;
+        if (primaryOnly)
+            cpus.append(core.threads.first());
+        else
+            cpus += core.threads;
+    }
+    return cpus;
+}
+
+bool CpuTopology::pinCurrentThread(int cpu)
+{
+    if (cpu < 0)
+        return false;
+#ifdef Q_OS_WIN
+    GROUP_AFFINITY affinity = {};
+    affinity.Group = WORD(cpu / 64);
+    affinity.Mask  = KAFFINITY(1) << (cpu % 64);
+    return SetThreadGroupAffinity(GetCurrentThread(), &affinity, nullptr) != 0;
+#elif defined(Q_OS_LINUX)
+    if (cpu >= CPU_SETSIZE)
+        return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;   // 0 = calling thread
+#else
+    return false;
+#endif
+}
+
+void CpuTopology::applyTo(HardwareInfo &info) const
+{
+    if (isEmpty())
+        return;
+    info.cpuCores            = coreCount();
+    info.cpuThreads          = threadCount();
+    info.cpuPackages         = m_packages;
+    info.cpuPerformanceCores = coreCount(CoreType::Performance);
+    info.cpuEfficiencyCores  = coreCount(CoreType::Efficiency);
+    info.cpuL3Domains        = int(m_l3.size());
+    for (const Core &core : m_cores)
+        info.cpuMaxClockMhz = std::max<quint64>(info.cpuMaxClockMhz, core.maxMhz);
+}
+
+QString CpuTopology::summary(const HardwareInfo &info)
+{
+    if (info.cpuCores == 0)
+        return QStringLiteral("Unknown");
+    QStringList parts;
+    if (info.cpuEfficiencyCores > 0)
+        parts << QStringLiteral("%1P + %2E cores").arg(info.cpuPerformanceCores)
+                                                  .arg(info.cpuEfficiencyCores);
+    else
+        parts << QStringLiteral("%1 cores").arg(info.cpuCores);
+    parts << QStringLiteral("%1 threads").arg(info.cpuThreads);
+    if (info.cpuL3Domains > std::max(1, info.cpuPackages))
+        parts << QStringLiteral("%1 L3 domains").arg(info.cpuL3Domains);
+    if (info.cpuPackages > 1)
+        parts << QStringLiteral("%1 packages").arg(info.cpuPackages);
+    return parts.join(QStringLiteral(" · "));
+}
+
+QString CpuTopology::summary() const
+{
+    HardwareInfo info;
+    applyTo(info);
+    return summary(info);
+}
+
+QVariantMap CpuTopology::toVariant() const
+{
+    QVariantList cores;
+    for (const Core &core : m_cores) {
+        QVariantList threads;
+        for (int cpu : core.threads)
+            threads.append(cpu);
+        QVariantMap c;
+        c["package"]  = core.package;
+        c["die"]      = core.die;
+        c["l3Domain"] = core.l3Domain;
+        c["type"]     = QString::fromLatin1(typeName(core.type));
+        c["maxMhz"]   = core.maxMhz;
+        c["threads"]  = threads;
+        cores.append(c);
+    }
+    QVariantList domains;
+    for (const CacheDomain &d : m_l3)
+        domains.append(QVariantMap{ { "sizeKb", d.sizeKb }, { "cpus", int(d.cpus.size()) } });
+
+    QVariantMap m;
+    m["packages"]  = m_packages;
+    m["dies"]      = m_dies;
+    m["hybrid"]    = isHybrid();
+    m["summary"]   = summary();
+    m["cores"]     = cores;
+    m["l3Domains"] = domains;
+    return m;
+}
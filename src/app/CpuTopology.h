@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+#include <QVariantMap>
+
+struct HardwareInfo;
+
+/// Processor layout: packages, dies, L3 domains (a CCX/CCD on Ryzen),
+/// physical cores with their SMT siblings, core type on hybrid parts and
+/// per-core maximum clock. Read from /sys/devices/system/cpu on Linux and
+/// GetLogicalProcessorInformationEx on Windows. Logical CPUs are numbered
+/// as the OS does on Linux; on Windows a CPU is group * 64 + bit.
+class CpuTopology
+{
+public:
+    enum class CoreType { Unknown, Performance, Efficiency };
+
+    struct Core
+    {
+        int        package  = 0;
+        int        die      = 0;
+        int        l3Domain = -1;            // index into l3Domains(), -1 if no shared L3
+        CoreType   type     = CoreType::Unknown;
+        quint32    maxMhz   = 0;
+        QList<int> threads;                  // ascending; threads.first() is the primary
+    };
+
+    struct CacheDomain
+    {
+        quint32    sizeKb = 0;
+        QList<int> cpus;                     // logical CPUs sharing the cache
+    };
+
+    /// This machine, read once on first use.
+    static const CpuTopology &system();
+
+    /// Topology of a sysfs tree — the live /sys or a captured copy.
+    static CpuTopology fromSysfs(const QString &sysRoot = QStringLiteral("/sys"));
+
+    const QList<Core>        &cores() const     { return m_cores; }
+    const QList<CacheDomain> &l3Domains() const { return m_l3; }
+
+    bool isEmpty() const       { return m_cores.isEmpty(); }
+    int  packageCount() const  { return m_packages; }
+    int  dieCount() const      { return m_dies; }
+    int  coreCount() const     { return int(m_cores.size()); }
+    int  threadCount() const;
+    int  coreCount(CoreType type) const;
+    bool isHybrid() const      { return coreCount(CoreType::Efficiency) > 0; }
+
+    /// One logical CPU per physical core, optionally of one type only
+    /// (Unknown = every core).
+    QList<int> primaryThreads(CoreType type = CoreType::Unknown) const;
+    /// Every logical CPU, SMT siblings included.
+    QList<int> allThreads() const;
+    /// Logical CPUs of the cores behind one L3 domain.
+    QList<int> domainThreads(int l3Domain, bool primaryOnly) const;
+
+    /// Restrict the calling thread to one logical CPU, numbered as above.
+    /// False where the OS refused or has no affinity API.
+    static bool pinCurrentThread(int cpu);
+
+    /// Core counts, P/E split, packages, L3 domains and top clock into info;
+    /// leaves info alone if the topology is empty.
+    void applyTo(HardwareInfo &info) const;
+
+    /// "8P + 16E cores · 32 threads" / "16 cores · 32 threads · 2 L3 domains".
+    /// L3 domains are listed only when a package has more than one (a
+    /// multi-CCD Ryzen). The static form formats a cached HardwareInfo, so
+    /// the hardware page and the topology log read the same.
+    static QString summary(const HardwareInfo &info);
+    QString summary() const;
+    QVariantMap toVariant() const;
+
+private:
+#ifdef Q_OS_WIN
+    static CpuTopology fromWindows();
+#endif
+    /// Sort cores and threads, link cores to L3 domains, count packages/dies.
+    void finish();
+
+    QList<Core>        m_cores;
+    QList<CacheDomain> m_l3;
+    int                m_packages = 0;
+    int                m_dies = 0;
+};
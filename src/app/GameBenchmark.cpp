@@ -1,6 +1,5 @@
 #include "app/GameBenchmark.h"
 
-#include <QProcess>
 #include <QElapsedTimer>
 #include <QStorageInfo>
 #include <QTemporaryFile>
@@ -8,100 +7,237 @@
 #include <QFutureWatcher>
 #include <QtConcurrent/QtConcurrentRun>
 #include <QCoreApplication>
-#include <QRegularExpression>
 
 #include <cmath>
 #include <algorithm>
 #include <numeric>
 #include <random>
 #include <cstring>
+#include <iterator>
+
+namespace {
+
+struct Preset { const char *name; double multiplier; double vramScale; };
+
+// FPS relative to 1080p / Medium, which the profile FPS curves are tuned
+// for; VRAM relative to the profile's High-preset need. Resolution order
+// matches the GameProfileDb vramMb slots.
+constexpr Preset kResolutions[] = { {"1080p", 1.0, 1.0}, {"1440p", 0.72, 1.0}, {"4K", 0.45, 1.0} };
+constexpr Preset kQualities[]   = { {"Low", 1.4, 0.7}, {"Medium", 1.0, 0.85},
+                                    {"High", 0.7, 1.0}, {"Ultra", 0.5, 1.2} };
+
+constexpr int    kReferenceThreads = 12;    // thread count the profile curves assume
+constexpr double kReferenceL3Mb    = 16.0;
+constexpr int kResolutionCount  = int(std::size(kResolutions));
+constexpr int kQualityCount     = int(std::size(kQualities));
+
+constexpr quint64 splitmix64(quint64 x)
+{
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+/// FNV-1a of the profile id: a game keeps its noise stream when the list changes.
+quint64 idSeed(const QString &id)
+{
+    quint64 h = 0xCBF29CE484222325ull;
+    for (QChar c : id) {
+        h ^= c.unicode();
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+int presetIndex(const Preset *presets, int count, const QString &name, int fallback)
+{
+    for (int i = 0; i < count; ++i)
+        if (name == QLatin1String(presets[i].name))
+            return i;
+    return fallback;
+}
+
+} // anonymous namespace
 
 GameBenchmark::GameBenchmark(QObject *parent) : QObject(parent)
 {
-    // Initialise game profiles — tuned for 1080p medium settings (base)
-    m_profiles = {
-        {"valorant",   "Valorant",           "VAL", 0.45, 0.45, 0.10, 100, 500, 0.65},
-        {"fortnite",   "Fortnite",           "FN",  0.35, 0.55, 0.10, 60,  300, 0.60},
-        {"gta5",       "GTA V",              "GTA", 0.35, 0.55, 0.10, 40,  200, 0.55},
-        {"apex",       "Apex Legends",       "APX", 0.40, 0.50, 0.10, 80,  300, 0.60},
-        {"warzone",    "Call of Duty: Warzone","COD", 0.40, 0.50, 0.10, 50,  250, 0.55},
-        {"overwatch2", "Overwatch 2",        "OW2", 0.40, 0.50, 0.10, 90,  400, 0.65},
-        {"minecraft",  "Minecraft",          "MC",  0.55, 0.30, 0.15, 60,  500, 0.70},
-        {"rocketleague","Rocket League",     "RL",  0.40, 0.45, 0.15, 80,  400, 0.65},
-        {"pubg",       "PUBG",               "PBG", 0.40, 0.50, 0.10, 50,  250, 0.55},
-        {"lol",        "League of Legends",  "LOL", 0.50, 0.35, 0.15, 100, 500, 0.70},
-        {"roblox",     "Roblox",             "RBX", 0.50, 0.35, 0.15, 80,  400, 0.70},
-    };
+    connect(&m_latencyProbe, &LatencyProbe::targetUpdated, this, &GameBenchmark::latencyUpdated);
+    connect(&m_latencyProbe, &LatencyProbe::finished, this, [this]() {
+        m_networkLatency = m_latencyProbe.medianRttMs();
+        emit networkDone();
+    });
 }
 
-void GameBenchmark::setHardware(const HardwareInfo &, const HardwareScorer *scorer)
+void GameBenchmark::setHardware(const HardwareInfo &hw, const HardwareScorer *scorer)
 {
     if (!scorer) return;
     m_cpuScore = scorer->cpuScore();
     m_gpuScore = scorer->gpuScore();
     m_ramScore = scorer->ramScore();
+    m_traits.cpuThreads = hw.cpuThreads;
+    m_traits.l3Mb       = int(hw.cpuL3CacheKb / 1024);
+    m_traits.vramMb     = int(hw.gpuVramMb);
+
+    // The profile library is only loaded once there is hardware to estimate for
+    if (m_profiles.size() == 0)
+        m_profiles = toColumns(GameProfileDb::instance().profiles());
+
+    // A few microseconds for the whole matrix; no need to go async
+    m_matrix = computeMatrix(m_profiles, m_cpuScore, m_gpuScore, m_ramScore, m_traits);
+    selectResults();
+    emit resultsChanged();
 }
 
 void GameBenchmark::setSelectedResolution(const QString &res)
 {
     if (m_resolution == res) return;
     m_resolution = res;
+    selectResults();
     emit resolutionChanged();
+    emit resultsChanged();
 }
 
 void GameBenchmark::setSelectedQuality(const QString &q)
 {
     if (m_quality == q) return;
     m_quality = q;
+    selectResults();
     emit qualityChanged();
+    emit resultsChanged();
+}
+
+int GameBenchmark::resolutionIndex() const
+{
+    return presetIndex(kResolutions, kResolutionCount, m_resolution, 0);   // 1080p
 }
 
-double GameBenchmark::resolutionMultiplier() const
+int GameBenchmark::qualityIndex() const
 {
-    if (m_resolution == "1440p") return 0.72;
-    if (m_resolution == "4K")    return 0.45;
-    return 1.0; // 1080p
+    return presetIndex(kQualities, kQualityCount, m_quality, 1);   // Medium
 }
 
-double GameBenchmark::qualityMultiplier() const
+QVariantList GameBenchmark::gameList() const
 {
-    if (m_quality == "Low")   return 1.4;
-    if (m_quality == "High")  return 0.7;
-    if (m_quality == "Ultra") return 0.5;
-    return 1.0; // Medium
+    QVariantList list;
+    for (int g = 0; g < m_profiles.size(); ++g) {
+        QVariantMap m;
+        m["id"]   = m_profiles.ids.at(g);
+        m["name"] = m_profiles.names.at(g);
+        m["icon"] = m_profiles.icons.at(g);
+        if (const GameProfile *p = GameProfileDb::instance().find(m_profiles.ids.at(g))) {
+            m["engine"]            = p->engine;
+            m["shaderStutterRisk"] = p->shaderStutterRisk;
+        }
+        list.append(m);
+    }
+    return list;
 }
 
 // ─── FPS Estimation ────────────────────────────────────────────────────
 
-QVariantMap GameBenchmark::estimateGame(const GameProfile &game, int cpuScore,
-                                         int gpuScore, int ramScore) const
+GameBenchmark::ProfileColumns GameBenchmark::toColumns(const QList<GameProfile> &profiles)
 {
-    // Compute a weighted effective score for this game
-    double effScore = game.cpuWeight * cpuScore
-                    + game.gpuWeight * gpuScore
-                    + game.ramWeight * ramScore;
-
-    // Logistic curve mapping score→FPS:  fps = base + (max-base) * sigmoid((score-40)/25)
-    auto sigmoid = [](double x) { return 1.0 / (1.0 + std::exp(-x)); };
-    double t = sigmoid((effScore - 40.0) / 22.0);
-    double avgFps = game.baseFps + (game.maxFps - game.baseFps) * t;
+    ProfileColumns c;
+    for (const GameProfile &p : profiles) {
+        c.ids.append(p.id);
+        c.names.append(p.name);
+        c.icons.append(p.icon);
+        c.cpuWeight.push_back(p.cpuWeight);
+        c.gpuWeight.push_back(p.gpuWeight);
+        c.ramWeight.push_back(p.ramWeight);
+        c.baseFps.push_back(p.baseFps);
+        c.maxFps.push_back(p.maxFps);
+        c.onePercentMult.push_back(p.onePercentMult);
+        c.mainThreadFraction.push_back(p.mainThreadFraction);
+        c.l3Sensitivity.push_back(p.l3Sensitivity);
+        c.shaderStutterRisk.push_back(p.shaderStutterRisk);
+        for (int r = 0; r < 3; ++r)
+            c.vramMb[r].push_back(p.vramMb[r]);
+        c.seed.push_back(idSeed(p.id));
+    }
+    return c;
+}
 
-    // Apply resolution and quality multipliers
-    avgFps *= resolutionMultiplier();
-    avgFps *= qualityMultiplier();
+GameBenchmark::FpsMatrix GameBenchmark::computeMatrix(const ProfileColumns &games, int cpuScore,
+                                                      int gpuScore, int ramScore,
+                                                      const HardwareTraits &hw)
+{
+    const int n = games.size();
+    FpsMatrix m;
+    for (const Preset &r : kResolutions) m.resolutions.append(QLatin1String(r.name));
+    for (const Preset &q : kQualities)   m.qualities.append(QLatin1String(q.name));
+    m.games = n;
+    m.avgFps.resize(size_t(n) * kResolutionCount * kQualityCount);
+    m.onePercentLow.resize(m.avgFps.size());
+
+    // Hardware terms shared by all games. Extra threads only help the part
+    // of a game's CPU time that is not on the main thread; a large L3 helps
+    // cache-sensitive engines (and a small one hurts them).
+    const double coreScale = hw.cpuThreads > 0
+        ? std::clamp(double(hw.cpuThreads) / kReferenceThreads, 0.5, 1.25) : 1.0;
+    const double l3Gain = hw.l3Mb > 0
+        ? std::clamp(std::log2(hw.l3Mb / kReferenceL3Mb) * 0.12, -0.15, 0.3) : 0.0;
+    // Shader compilation hitches are shorter on faster CPUs
+    const double stutterDepth = 0.3 * (1.0 - std::clamp(cpuScore / 200.0, 0.0, 0.5));
+
+    // 1. Per game: effective score through the logistic FPS curve,
+    //    fps = base + (max-base) * sigmoid((score-40)/22). The only
+    //    transcendental work, done once per game instead of once per cell.
+    std::vector<double> baseFps(n), lowMult(n);
+    for (int g = 0; g < n; ++g) {
+        const double mt = games.mainThreadFraction[g];
+        const double cpuEff = cpuScore * (mt + (1.0 - mt) * coreScale)
+                                       * (1.0 + games.l3Sensitivity[g] * l3Gain);
+        const double eff = games.cpuWeight[g] * cpuEff
+                         + games.gpuWeight[g] * gpuScore
+                         + games.ramWeight[g] * ramScore;
+        const double t = 1.0 / (1.0 + std::exp(-(eff - 40.0) / 22.0));
+        baseFps[g] = games.baseFps[g] + (games.maxFps[g] - games.baseFps[g]) * t;
+        lowMult[g] = games.onePercentMult[g] * (1.0 - games.shaderStutterRisk[g] * stutterDepth);
+    }
 
-    // Add slight random variation (±3%) for realism
-    avgFps *= (0.97 + (std::rand() % 60) / 1000.0);
-    avgFps = std::max(avgFps, 10.0);
+    // 2. Per resolution/quality slice: scale, VRAM pressure, ±3% variation,
+    //    floor. Straight loops over contiguous columns that the compiler can
+    //    vectorize. Running out of VRAM costs up to 60% of the frame rate
+    //    and hits the 1% lows twice. The variation is a counter-based hash
+    //    of (scores, game, cell), so it is reproducible and safe on any thread.
+    const quint64 hwSeed = splitmix64((quint64(cpuScore) << 32) | (quint64(gpuScore) << 16) | quint64(ramScore));
+    const double vram = hw.vramMb;
+    for (int r = 0; r < kResolutionCount; ++r) {
+        const double *need = games.vramMb[r].data();
+        for (int q = 0; q < kQualityCount; ++q) {
+            const double scale = kResolutions[r].multiplier * kQualities[q].multiplier;
+            const double vramScale = kResolutions[r].vramScale * kQualities[q].vramScale;
+            const quint64 cell = quint64(r * kQualityCount + q);
+            float *avg = m.avgFps.data() + m.index(0, r, q);
+            float *low = m.onePercentLow.data() + m.index(0, r, q);
+            for (int g = 0; g < n; ++g) {
+                const double required = need[g] * vramScale;
+                const double fit = (vram > 0 && required > vram) ? vram / required : 1.0;
+                const double vramFactor = 0.4 + 0.6 * fit;
+                const quint64 h = splitmix64(hwSeed ^ games.seed[g] ^ (cell * 0x9E3779B97F4A7C15ull));
+                const double noise = 0.97 + 0.06 * double(h >> 11) * 0x1.0p-53;
+                const double fps = std::max(baseFps[g] * scale * vramFactor * noise, 10.0);
+                avg[g] = float(fps);
+                low[g] = float(fps * lowMult[g] * vramFactor);
+            }
+        }
+    }
+    return m;
+}
 
-    double onePercentLow = avgFps * game.onePercentMult;
+QVariantMap GameBenchmark::resultAt(int game, int res, int quality) const
+{
+    const int i = m_matrix.index(game, res, quality);
+    const double avgFps = m_matrix.avgFps[size_t(i)];
 
     QVariantMap result;
-    result["id"]           = game.id;
-    result["name"]         = game.name;
-    result["icon"]         = game.icon;
+    result["id"]           = m_profiles.ids.at(game);
+    result["name"]         = m_profiles.names.at(game);
+    result["icon"]         = m_profiles.icons.at(game);
     result["avgFps"]       = static_cast<int>(std::round(avgFps));
-    result["onePercentLow"]= static_cast<int>(std::round(onePercentLow));
+    result["onePercentLow"]= static_cast<int>(std::round(m_matrix.onePercentLow[size_t(i)]));
     result["rating"]       = avgFps >= 240 ? "Excellent" :
                              avgFps >= 144 ? "Great" :
                              avgFps >= 60  ? "Good" :
@@ -113,48 +249,18 @@ QVariantMap GameBenchmark::estimateGame(const GameProfile &game, int cpuScore,
     return result;
 }
 
-// ─── Network Latency ───────────────────────────────────────────────────
-
-double GameBenchmark::measureNetworkLatency() const
+void GameBenchmark::selectResults()
 {
-    // Ping multiple reliable targets, take median
-    QStringList targets = {
-        "1.1.1.1",       // Cloudflare
-        "8.8.8.8",       // Google
-        "208.67.222.222" // OpenDNS
-    };
-
-    QList<double> pings;
-
-    for (const auto &target : targets) {
-        QProcess proc;
-#ifdef Q_OS_WIN
-        proc.start("ping", QStringList() << "-n" << "3" << "-w" << "2000" << target);
-#else
-        proc.start("ping", QStringList() << "-c" << "3" << "-W" << "2" << target);
-#endif
-        if (!proc.waitForFinished(8000)) continue;
-
-        QString output = proc.readAllStandardOutput();
-        // Parse average from "Average = XXms" (Win) or "min/avg/max/mdev = .../XX/..." (Linux)
-#ifdef Q_OS_WIN
-        QRegularExpression re("Average\\s*=\\s*(\\d+)ms", QRegularExpression::CaseInsensitiveOption);
-#else
-        QRegularExpression re("([\\d.]+)/([\\d.]+)/([\\d.]+)/([\\d.]+)\\s*ms");
-#endif
-        auto match = re.match(output);
-        if (match.hasMatch()) {
-#ifdef Q_OS_WIN
-            pings.append(match.captured(1).toDouble());
-#else
-            pings.append(match.captured(2).toDouble()); // avg field
-#endif
-        }
-    }
-
-    if (pings.isEmpty()) return -1; // no connectivity
-    std::sort(pings.begin(), pings.end());
-    return pings[pings.size() / 2]; // median
+    m_gameResults.clear();
+    if (m_matrix.isEmpty()) return;
+    const int r = resolutionIndex(), q = qualityIndex();
+    for (int g = 0; g < m_matrix.games; ++g)
+        m_gameResults.append(resultAt(g, r, q));
+
+    // Compute system latency score: based on CPU score and RAM
+    m_systemLatencyScore = std::clamp(
+        static_cast<int>(m_cpuScore * 0.6 + m_ramScore * 0.25 + m_gpuScore * 0.15),
+        0, 100);
 }
 
 // ─── Storage Speed ─────────────────────────────────────────────────────
@@ -210,26 +316,23 @@ void GameBenchmark::runEstimation()
     m_running = true;
     emit runningChanged();
 
-    auto *watcher = new QFutureWatcher<QVariantList>(this);
+    auto *watcher = new QFutureWatcher<FpsMatrix>(this);
 
-    int cpu = m_cpuScore, gpu = m_gpuScore, ram = m_ramScore;
-    QList<GameProfile> profiles = m_profiles;
+    if (m_profiles.size() == 0)
+        m_profiles = toColumns(GameProfileDb::instance().profiles());
 
-    auto future = QtConcurrent::run([this, profiles, cpu, gpu, ram]() -> QVariantList {
-        QVariantList results;
-        for (const auto &game : profiles) {
-            results.append(estimateGame(game, cpu, gpu, ram));
-        }
-        return results;
-    });
+    const int cpu = m_cpuScore, gpu = m_gpuScore, ram = m_ramScore;
+    const ProfileColumns profiles = m_profiles;
+    const HardwareTraits traits = m_traits;
 
-    connect(watcher, &QFutureWatcher<QVariantList>::finished, this, [this, watcher]() {
-        m_gameResults = watcher->result();
+    // computeMatrix is a pure function of its arguments
+    auto future = QtConcurrent::run([profiles, cpu, gpu, ram, traits]() {
+        return computeMatrix(profiles, cpu, gpu, ram, traits);
+    });
 
-        // Compute system latency score: based on CPU score and RAM
-        m_systemLatencyScore = std::clamp(
-            static_cast<int>(m_cpuScore * 0.6 + m_ramScore * 0.25 + m_gpuScore * 0.15),
-            0, 100);
+    connect(watcher, &QFutureWatcher<FpsMatrix>::finished, this, [this, watcher]() {
+        m_matrix = watcher->result();
+        selectResults();
 
         m_running = false;
         emit resultsChanged();
@@ -242,14 +345,22 @@ void GameBenchmark::runEstimation()
 
 void GameBenchmark::runPingTest()
 {
-    auto *watcher = new QFutureWatcher<double>(this);
-    auto future = QtConcurrent::run([this]() { return measureNetworkLatency(); });
-    connect(watcher, &QFutureWatcher<double>::finished, this, [this, watcher]() {
-        m_networkLatency = watcher->result();
-        emit networkDone();
-        watcher->deleteLater();
-    });
-    watcher->setFuture(future);
+    probeLatency(LatencyProbe::defaultTargets());
+}
+
+void GameBenchmark::probeLatency(const QList<LatencyProbe::Target> &targets)
+{
+    // All targets are probed at once and each reply streams out, so a run
+    // takes about intervalMs * (probes - 1) + timeoutMs however many targets.
+    m_latencyProbe.start(targets, LatencyProbe::Options());
+}
+
+QVariantList GameBenchmark::latencyResults() const
+{
+    QVariantList list;
+    for (const LatencyProbe::Stats &s : m_latencyProbe.results())
+        list.append(s.toMap());
+    return list;
 }
 
 void GameBenchmark::runStorageTest()
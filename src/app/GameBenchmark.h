@@ -4,12 +4,24 @@
 #include <QVariantList>
 #include <QVariantMap>
 
+#include <vector>
+
+#include "app/GameProfileDb.h"
 #include "app/HardwareDetector.h"
 #include "app/HardwareScorer.h"
+#include "app/LatencyProbe.h"
 
 /// Game FPS estimation engine.
-/// Uses a hardware scoring model + per-game weight profiles to estimate
-/// average FPS, 1% low FPS, and expected latency for popular titles.
+/// Uses a hardware scoring model + per-game profiles (GameProfileDb) to
+/// estimate average FPS, 1% low FPS, and expected latency. Besides the
+/// score weights, each profile's main-thread share, L3 sensitivity, VRAM
+/// need and shader-stutter risk are weighed against the detected CPU
+/// threads, L3 size and VRAM.
+///
+/// Every game × resolution × quality cell is computed in one pass whenever
+/// the hardware scores change; the selected resolution/quality only picks
+/// a slice of that matrix. Variation is seeded from the scores, so the same
+/// hardware always gets the same numbers.
 class GameBenchmark : public QObject
 {
     Q_OBJECT
@@ -23,6 +35,19 @@ class GameBenchmark : public QObject
     Q_PROPERTY(QString selectedQuality READ selectedQuality WRITE setSelectedQuality NOTIFY qualityChanged)
 
 public:
+    /// Precomputed estimates. Cell (game g, resolution r, quality q) is at
+    /// (r * qualities.size() + q) * games + g, so one slice is contiguous.
+    struct FpsMatrix {
+        QStringList resolutions;
+        QStringList qualities;
+        int games = 0;
+        std::vector<float> avgFps;
+        std::vector<float> onePercentLow;
+
+        int index(int g, int r, int q) const { return (r * int(qualities.size()) + q) * games + g; }
+        bool isEmpty() const { return avgFps.empty(); }
+    };
+
     explicit GameBenchmark(QObject *parent = nullptr);
 
     void setHardware(const HardwareInfo &hw, const HardwareScorer *scorer);
@@ -34,6 +59,9 @@ public:
     int systemLatencyScore() const { return m_systemLatencyScore; }
     QString selectedResolution() const { return m_resolution; }
     QString selectedQuality() const { return m_quality; }
+    const FpsMatrix &fpsMatrix() const { return m_matrix; }
+    /// id, name, icon and engine for each matrix game index.
+    QVariantList gameList() const;
 
     void setSelectedResolution(const QString &res);
     void setSelectedQuality(const QString &q);
@@ -41,8 +69,13 @@ public:
     /// Run full estimation suite asynchronously.
     Q_INVOKABLE void runEstimation();
 
-    /// Run quick network ping test.
+    /// Probe network latency to the default targets; per-target results
+    /// stream through latencyUpdated, networkDone ends the run.
     Q_INVOKABLE void runPingTest();
+    void probeLatency(const QList<LatencyProbe::Target> &targets);
+
+    /// Per-target RTT statistics of the last/current ping test.
+    QVariantList latencyResults() const;
 
     /// Run storage speed test.
     Q_INVOKABLE void runStorageTest();
@@ -51,35 +84,47 @@ signals:
     void resultsChanged();
     void runningChanged();
     void networkDone();
+    void latencyUpdated(const QVariantMap &stats);
     void storageDone();
     void resolutionChanged();
     void qualityChanged();
 
 private:
-    struct GameProfile {
-        QString id;
-        QString name;
-        QString icon;
-        double cpuWeight;     // how CPU-bound the game is (0-1)
-        double gpuWeight;     // how GPU-bound
-        double ramWeight;
-        // FPS curve: baseFps at score=50, maxFps at score=100
-        double baseFps;
-        double maxFps;
-        double onePercentMult; // 1% low as fraction of avg (typically 0.55-0.75)
+    /// GameProfileDb profiles column by column for the batched estimate.
+    struct ProfileColumns {
+        QStringList ids, names, icons;
+        std::vector<double> cpuWeight, gpuWeight, ramWeight;
+        std::vector<double> baseFps, maxFps, onePercentMult;
+        std::vector<double> mainThreadFraction, l3Sensitivity, shaderStutterRisk;
+        std::vector<double> vramMb[3];   // per resolution slot
+        std::vector<quint64> seed;       // per-game noise stream
+
+        int size() const { return int(ids.size()); }
+    };
+
+    /// The parts of HardwareInfo the profiles react to.
+    struct HardwareTraits {
+        int cpuThreads = 0;
+        int l3Mb = 0;
+        int vramMb = 0;     // 0 = shared / unknown, no VRAM limit applied
     };
 
-    QVariantMap estimateGame(const GameProfile &game, int cpuScore, int gpuScore,
-                             int ramScore) const;
-    double resolutionMultiplier() const;
-    double qualityMultiplier() const;
-    double measureNetworkLatency() const;
+    static ProfileColumns toColumns(const QList<GameProfile> &profiles);
+    static FpsMatrix computeMatrix(const ProfileColumns &games, int cpuScore,
+                                   int gpuScore, int ramScore, const HardwareTraits &hw);
+    QVariantMap resultAt(int game, int res, int quality) const;
+    void selectResults();
+    int resolutionIndex() const;
+    int qualityIndex() const;
     double measureStorageSpeed() const;
 
-    QList<GameProfile> m_profiles;
+    ProfileColumns m_profiles;      // filled on first use from GameProfileDb
+    HardwareTraits m_traits;
+    FpsMatrix m_matrix;
     QVariantList m_gameResults;
     bool m_running = false;
-    double m_networkLatency = 0;  // ms
+    LatencyProbe m_latencyProbe;
+    double m_networkLatency = 0;  // ms, median across targets; -1 = unreachable
     double m_storageSpeed = 0;    // MB/s
     int m_systemLatencyScore = 0; // 0-100
 
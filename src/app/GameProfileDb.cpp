@@ -0,0 +1,101 @@
+#include "app/GameProfileDb.h"
+#include "app/VersionedJson.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QStandardPaths>
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+namespace {
+
+const QString kBuiltinPath = QStringLiteral(":/data/games.json");
+
+// GameProfile::vramMb slots
+const QString kResolutionNames[] = {
+    QStringLiteral("1080p"), QStringLiteral("1440p"), QStringLiteral("4K")
+};
+
+double unit(const QJsonObject &o, const char *key, double fallback)
+{
+    return std::clamp(o.value(QLatin1String(key)).toDouble(fallback), 0.0, 1.0);
+}
+
+GameProfile readProfile(const QJsonObject &o)
+{
+    GameProfile p;
+    p.id                 = o.value(QStringLiteral("id")).toString();
+    p.name               = o.value(QStringLiteral("name")).toString(p.id);
+    p.icon               = o.value(QStringLiteral("icon")).toString(p.id.left(3).toUpper());
+    p.engine             = o.value(QStringLiteral("engine")).toString();
+    p.cpuWeight          = unit(o, "cpuWeight", 0.4);
+    p.gpuWeight          = unit(o, "gpuWeight", 0.5);
+    p.ramWeight          = unit(o, "ramWeight", 0.1);
+    p.baseFps            = o.value(QStringLiteral("baseFps")).toDouble();
+    p.maxFps             = std::max(o.value(QStringLiteral("maxFps")).toDouble(), p.baseFps);
+    p.onePercentMult     = unit(o, "onePercentLow", 0.6);
+    p.mainThreadFraction = unit(o, "mainThreadFraction", 0.5);
+    p.l3Sensitivity      = unit(o, "l3Sensitivity", 0.0);
+    p.shaderStutterRisk  = unit(o, "shaderStutterRisk", 0.0);
+
+    const QJsonObject vram = o.value(QStringLiteral("vramMb")).toObject();
+    for (int i = 0; i < 3; ++i)
+        p.vramMb[i] = vram.value(kResolutionNames[i]).toInt();
+    return p;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// GameProfileDb
+// ---------------------------------------------------------------------------
+const GameProfileDb &GameProfileDb::instance()
+{
+    static const GameProfileDb db;   // loaded on first use, thread-safe
+    return db;
+}
+
+QString GameProfileDb::overridePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + QStringLiteral("/games.json");
+}
+
+const GameProfile *GameProfileDb::find(const QString &id) const
+{
+    const auto it = m_byId.constFind(id);
+    return it != m_byId.constEnd() ? &m_profiles.at(*it) : nullptr;
+}
+
+GameProfileDb::GameProfileDb()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const VersionedJson db = VersionedJson::load(kBuiltinPath, overridePath(), "[GAMES]");
+    load(db.root.value(QStringLiteral("profiles")).toArray());
+    m_version = db.version;
+    m_source  = db.source;
+
+    qDebug() << "[GAMES] Loaded" << m_profiles.size() << "profiles version" << m_version
+             << "from" << m_source << "in" << timer.elapsed() << "ms";
+}
+
+void GameProfileDb::load(const QJsonArray &array)
+{
+    m_profiles.clear();
+    m_byId.clear();
+    m_profiles.reserve(array.size());
+    for (const QJsonValue &v : array) {
+        GameProfile p = readProfile(v.toObject());
+        if (p.id.isEmpty() || p.baseFps <= 0 || m_byId.contains(p.id))
+            continue;   // first definition of an id wins
+        m_byId.insert(p.id, int(m_profiles.size()));
+        m_profiles.append(std::move(p));
+    }
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonArray>
+#include <QList>
+#include <QString>
+
+/// Performance characteristics of one game, as stored in games.json.
+struct GameProfile
+{
+    QString id;
+    QString name;
+    QString icon;
+    QString engine;
+    double cpuWeight = 0;           // how CPU-bound the game is (0-1)
+    double gpuWeight = 0;           // how GPU-bound
+    double ramWeight = 0;
+    // FPS curve: baseFps at score=50, maxFps at score=100
+    double baseFps = 0;
+    double maxFps = 0;
+    double onePercentMult = 0.6;    // 1% low as fraction of avg (typically 0.55-0.75)
+    double mainThreadFraction = 0.5;// share of CPU time on the main/render thread; 1 = extra cores do not help
+    double l3Sensitivity = 0;       // 0-1, how much a large L3 (X3D parts) pays off
+    int    vramMb[3] = {};          // need at 1080p / 1440p / 4K, High preset
+    double shaderStutterRisk = 0;   // 0-1, hitching from runtime shader compilation
+};
+
+/// Game profile library. The built-in copy is the :/data/games.json
+/// resource; a games.json in AppDataLocation replaces it when its version is
+/// at least as new. Loaded on first use and indexed by profile id.
+class GameProfileDb
+{
+public:
+    static const GameProfileDb &instance();
+
+    const QList<GameProfile> &profiles() const { return m_profiles; }
+    const GameProfile *find(const QString &id) const;
+
+    int     version() const { return m_version; }
+    QString source() const  { return m_source; }
+
+    static QString overridePath();
+
+private:
+    GameProfileDb();
+    void load(const QJsonArray &array);
+
+    QList<GameProfile>  m_profiles;
+    QHash<QString, int> m_byId;
+    int                 m_version = 0;
+    QString             m_source;
+};
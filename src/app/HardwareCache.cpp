@@ -0,0 +1,129 @@
+#include "app/HardwareCache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+namespace {
+
+constexpr quint32 kMagic         = 0x48574331; // "HWC1"
+constexpr quint16 kFormatVersion = 4;          // bump when HardwareInfo or its detection changes
+
+void writeInfo(QDataStream &out, const HardwareInfo &hw)
+{
+    out << hw.cpuName << hw.gpuName << hw.gpuVendor << hw.ramMb
+        << qint32(hw.cpuCores) << qint32(hw.cpuThreads) << hw.cpuMaxClockMhz
+        << hw.motherboard << hw.storage << hw.hasSsd << hw.hasNvme;
+    out << hw.ramType << hw.ramSpeedMhz << hw.gpuVramMb << hw.gpuDriverVersion
+        << hw.cpuL2CacheKb << hw.cpuL3CacheKb << hw.diskInterfaces << hw.diskSizesGb;
+    out << qint32(hw.ramChannels) << qint32(hw.ramRanks) << qint32(hw.ramSlots) << hw.ramModulesMb;
+    out << qint32(hw.cpuPackages) << qint32(hw.cpuPerformanceCores) << qint32(hw.cpuEfficiencyCores)
+        << qint32(hw.cpuL3Domains);
+    out << hw.biosVersion << hw.biosDate << hw.tpmVersion << hw.secureBootEnabled
+        << hw.chassisType;
+}
+
+void readInfo(QDataStream &in, HardwareInfo &hw)
+{
+    qint32 cores = 0, threads = 0, channels = 0, ranks = 0, slots = 0;
+    qint32 packages = 0, pCores = 0, eCores = 0, l3Domains = 0;
+    in >> hw.cpuName >> hw.gpuName >> hw.gpuVendor >> hw.ramMb
+       >> cores >> threads >> hw.cpuMaxClockMhz
+       >> hw.motherboard >> hw.storage >> hw.hasSsd >> hw.hasNvme;
+    in >> hw.ramType >> hw.ramSpeedMhz >> hw.gpuVramMb >> hw.gpuDriverVersion
+       >> hw.cpuL2CacheKb >> hw.cpuL3CacheKb >> hw.diskInterfaces >> hw.diskSizesGb;
+    in >> channels >> ranks >> slots >> hw.ramModulesMb;
+    in >> packages >> pCores >> eCores >> l3Domains;
+    in >> hw.biosVersion >> hw.biosDate >> hw.tpmVersion >> hw.secureBootEnabled
+       >> hw.chassisType;
+    hw.cpuCores   = cores;
+    hw.cpuThreads = threads;
+    hw.ramChannels = channels;
+    hw.ramRanks    = ranks;
+    hw.ramSlots    = slots;
+    hw.cpuPackages         = packages;
+    hw.cpuPerformanceCores = pCores;
+    hw.cpuEfficiencyCores  = eCores;
+    hw.cpuL3Domains        = l3Domains;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// HardwareCache
+// ---------------------------------------------------------------------------
+HardwareCache::HardwareCache(const QString &path)
+    : m_path(path)
+{
+}
+
+QString HardwareCache::defaultPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + QStringLiteral("/hardware.cache");
+}
+
+bool HardwareCache::load(CachedHardware &out) const
+{
+    QFile f(m_path);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&f);
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != kMagic || version != kFormatVersion)
+        return false;
+
+    CachedHardware c;
+    in >> c.fingerprint >> c.savedAtMs;
+    readInfo(in, c.info);
+    if (in.status() != QDataStream::Ok) {
+        qWarning() << "[HW] Hardware cache is corrupt, ignoring" << m_path;
+        return false;
+    }
+
+    out = c;
+    return true;
+}
+
+bool HardwareCache::save(const HardwareInfo &info, const QString &fingerprint) const
+{
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+
+    QSaveFile f(m_path);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&f);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << kMagic << kFormatVersion << fingerprint << QDateTime::currentMSecsSinceEpoch();
+    writeInfo(out, info);
+
+    return out.status() == QDataStream::Ok && f.commit();
+}
+
+void HardwareCache::clear() const
+{
+    QFile::remove(m_path);
+}
+
+bool HardwareCache::needsRefresh(const CachedHardware &cached, const QString &fingerprint)
+{
+    if (cached.fingerprint != fingerprint)
+        return true;
+    const qint64 age = QDateTime::currentMSecsSinceEpoch() - cached.savedAtMs;
+    return age < 0 || age > kMaxAgeMs;
+}
+
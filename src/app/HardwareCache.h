@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QString>
+
+#include "app/HardwareDetector.h"
+
+/// A HardwareInfo snapshot as persisted by HardwareCache.
+struct CachedHardware
+{
+    HardwareInfo info;
+    QString      fingerprint;
+    qint64       savedAtMs = 0;   // ms since epoch
+};
+
+/// Persists the last complete HardwareInfo in a small binary file under
+/// AppDataLocation so startup can show hardware details without waiting for
+/// probes. The snapshot is keyed by MachineIdentity::fingerprint() (DMI
+/// product UUID, CPU model, device counts); a mismatch or an old snapshot
+/// means a background re-detection is due.
+class HardwareCache
+{
+public:
+    explicit HardwareCache(const QString &path = defaultPath());
+
+    /// Read the snapshot. Returns false if missing, corrupt or of another format version.
+    bool load(CachedHardware &out) const;
+
+    /// Write info atomically together with the fingerprint it was detected under.
+    bool save(const HardwareInfo &info, const QString &fingerprint) const;
+
+    /// Remove the snapshot (next start re-detects).
+    void clear() const;
+
+    /// True when cached must be re-detected against the given fingerprint.
+    static bool needsRefresh(const CachedHardware &cached, const QString &fingerprint);
+
+    static QString defaultPath();
+
+    static constexpr qint64 kMaxAgeMs = 7LL * 24 * 60 * 60 * 1000;  // one week
+
+private:
+    QString m_path;
+};
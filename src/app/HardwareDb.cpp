@@ -0,0 +1,187 @@
+#include "app/HardwareDb.h"
+#include "app/VersionedJson.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QStandardPaths>
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+namespace {
+
+const QString kBuiltinPath = QStringLiteral(":/data/hwdb.json");
+
+constexpr int kMaxKeyTokens = 32;       // match state is a 32-bit mask per entry
+constexpr int kMinPrefixLength = 4;
+
+bool hasLetterAndDigit(const QString &token)
+{
+    bool letter = false, digit = false;
+    for (QChar c : token) {
+        letter = letter || c.isLetter();
+        digit  = digit  || c.isDigit();
+    }
+    return letter && digit;
+}
+
+QList<HwDbEntry> readEntries(const QJsonArray &array)
+{
+    QList<HwDbEntry> entries;
+    entries.reserve(array.size());
+    for (const QJsonValue &v : array) {
+        const QJsonObject o = v.toObject();
+        HwDbEntry e;
+        e.key      = o.value(QStringLiteral("key")).toString();
+        e.model    = o.value(QStringLiteral("model")).toString(e.key);
+        e.vendor   = o.value(QStringLiteral("vendor")).toString();
+        e.arch     = o.value(QStringLiteral("arch")).toString();
+        e.cores    = o.value(QStringLiteral("cores")).toInt();
+        e.threads  = o.value(QStringLiteral("threads")).toInt();
+        e.l3Mb     = o.value(QStringLiteral("l3Mb")).toInt();
+        e.vramMb   = o.value(QStringLiteral("vramMb")).toInt();
+        e.boostMhz = o.value(QStringLiteral("boostMhz")).toInt();
+        e.score    = o.value(QStringLiteral("score")).toInt();
+        if (!e.key.isEmpty())
+            entries.append(e);
+    }
+    return entries;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// HwDbIndex
+// ---------------------------------------------------------------------------
+QStringList HwDbIndex::tokenize(const QString &text)
+{
+    QStringList tokens;
+    QString current;
+    for (QChar c : text) {
+        if (c.isLetterOrNumber()) {
+            current.append(c.toUpper());
+        } else if (!current.isEmpty()) {
+            tokens.append(current);
+            current.clear();
+        }
+    }
+    if (!current.isEmpty())
+        tokens.append(current);
+    return tokens;
+}
+
+void HwDbIndex::build(QList<HwDbEntry> entries)
+{
+    m_entries = std::move(entries);
+    m_tokenCount.clear();
+    m_keyLength.clear();
+    m_postings.clear();
+    m_exact.clear();
+
+    for (int i = 0; i < m_entries.size(); ++i) {
+        QStringList tokens = tokenize(m_entries.at(i).key);
+        tokens.removeDuplicates();
+        if (tokens.size() > kMaxKeyTokens)
+            tokens = tokens.mid(0, kMaxKeyTokens);
+
+        int length = 0;
+        for (int t = 0; t < tokens.size(); ++t) {
+            m_postings[tokens.at(t)].append({ i, t });
+            length += tokens.at(t).size();
+        }
+        m_tokenCount.append(tokens.size());
+        m_keyLength.append(length);
+        m_exact.insert(tokens.join(QLatin1Char(' ')), i);   // first entry wins
+    }
+}
+
+const HwDbEntry *HwDbIndex::find(const QString &name) const
+{
+    if (m_entries.isEmpty())
+        return nullptr;
+
+    const QStringList tokens = tokenize(name);
+
+    // Fast path: the name is exactly a key
+    const auto exact = m_exact.constFind(tokens.join(QLatin1Char(' ')));
+    if (exact != m_exact.constEnd())
+        return &m_entries.at(*exact);
+
+    // Which key tokens of which entries occur in the name
+    struct Hit { quint32 matched = 0; quint32 exact = 0; };
+    QHash<int, Hit> hits;
+    auto collect = [&](const QString &token, bool isExact) {
+        const auto it = m_postings.constFind(token);
+        if (it == m_postings.constEnd())
+            return;
+        for (const Posting &p : *it) {
+            Hit &h = hits[p.entry];
+            h.matched |= 1u << p.token;
+            if (isExact) h.exact |= 1u << p.token;
+        }
+    };
+    for (const QString &token : tokens) {
+        collect(token, true);
+        if (hasLetterAndDigit(token)) {
+            for (int len = token.size() - 1; len >= kMinPrefixLength; --len)
+                collect(token.left(len), false);
+        }
+    }
+
+    // Longest fully matched key; then fewest prefix matches, higher score, table order
+    int best = -1, bestLength = 0, bestRelaxed = 0;
+    for (auto it = hits.constBegin(); it != hits.constEnd(); ++it) {
+        const int i = it.key();
+        const int count = m_tokenCount.at(i);
+        const quint32 all = count >= 32 ? 0xffffffffu : ((1u << count) - 1);
+        if (it->matched != all)
+            continue;
+        const int length  = m_keyLength.at(i);
+        const int relaxed = count - qPopulationCount(it->exact);
+        const bool better =
+            best < 0
+            || length > bestLength
+            || (length == bestLength && relaxed < bestRelaxed)
+            || (length == bestLength && relaxed == bestRelaxed
+                && (m_entries.at(i).score > m_entries.at(best).score
+                    || (m_entries.at(i).score == m_entries.at(best).score && i < best)));
+        if (better) {
+            best = i;
+            bestLength = length;
+            bestRelaxed = relaxed;
+        }
+    }
+    return best >= 0 ? &m_entries.at(best) : nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// HardwareDb
+// ---------------------------------------------------------------------------
+const HardwareDb &HardwareDb::instance()
+{
+    static const HardwareDb db;   // loaded on first use, thread-safe
+    return db;
+}
+
+QString HardwareDb::overridePath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + QStringLiteral("/hwdb.json");
+}
+
+HardwareDb::HardwareDb()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    const VersionedJson db = VersionedJson::load(kBuiltinPath, overridePath(), "[HWDB]");
+    m_cpus.build(readEntries(db.root.value(QStringLiteral("cpus")).toArray()));
+    m_gpus.build(readEntries(db.root.value(QStringLiteral("gpus")).toArray()));
+    m_version = db.version;
+    m_source  = db.source;
+
+    qDebug() << "[HWDB] Loaded" << m_cpus.size() << "CPUs," << m_gpus.size() << "GPUs"
+             << "version" << m_version << "from" << m_source << "in" << timer.elapsed() << "ms";
+}
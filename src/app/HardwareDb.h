@@ -0,0 +1,72 @@
+#pragma once
+
+#include <QHash>
+#include <QJsonObject>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+/// One CPU or GPU model from the hardware database.
+struct HwDbEntry
+{
+    QString model;          // display name, "AMD Ryzen 7 7800X3D"
+    QString key;            // match key as written in the DB, "7800X3D"
+    QString vendor;
+    QString arch;
+    int     cores    = 0;   // CPU only
+    int     threads  = 0;   // CPU only
+    int     l3Mb     = 0;   // CPU only
+    int     vramMb   = 0;   // GPU only (0 = shared memory)
+    int     boostMhz = 0;
+    int     score    = 0;   // relative performance, 0–100
+};
+
+/// Token index over one table of the DB. Keys and device names are
+/// normalized to upper-case alphanumeric tokens; an entry matches a name when
+/// every key token occurs in it. Mixed letter/digit tokens in the name also
+/// match by prefix ("13700KF" → "13700K"), exact tokens preferred. The
+/// longest matching key wins.
+class HwDbIndex
+{
+public:
+    void build(QList<HwDbEntry> entries);
+    const HwDbEntry *find(const QString &name) const;
+    int size() const { return m_entries.size(); }
+
+    static QStringList tokenize(const QString &text);
+
+private:
+    struct Posting { int entry; int token; };
+
+    QList<HwDbEntry>                m_entries;
+    QList<int>                      m_tokenCount;   // per entry
+    QList<int>                      m_keyLength;    // per entry, letters/digits only
+    QHash<QString, QList<Posting>>  m_postings;     // token → entries containing it
+    QHash<QString, int>             m_exact;        // whole normalized key → entry
+};
+
+/// Hardware performance database. The built-in copy is the :/data/hwdb.json
+/// resource; a hwdb.json in AppDataLocation replaces it when its version is
+/// at least as new. Loaded on first use.
+class HardwareDb
+{
+public:
+    static const HardwareDb &instance();
+
+    const HwDbEntry *findCpu(const QString &cpuName) const { return m_cpus.find(cpuName); }
+    const HwDbEntry *findGpu(const QString &gpuName) const { return m_gpus.find(gpuName); }
+
+    int     version() const { return m_version; }
+    QString source() const  { return m_source; }
+    bool    isEmpty() const { return m_cpus.size() == 0 && m_gpus.size() == 0; }
+
+    static QString overridePath();
+
+private:
+    HardwareDb();
+
+    HwDbIndex m_cpus;
+    HwDbIndex m_gpus;
+    int       m_version = 0;
+    QString   m_source;
+};
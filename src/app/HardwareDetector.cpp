@@ -1,4 +1,8 @@
 #include "app/HardwareDetector.h"
+#include "app/CpuTopology.h"
+#include "app/SmbiosDecoder.h"
+#include "app/SysfsProbe.h"
+#include "app/Trace.h"
 
 #include <QSysInfo>
 #include <QProcess>
@@ -6,846 +10,629 @@
 #include <QTextStream>
 #include <QRegularExpression>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QPointer>
+#include <QThread>
+#include <QThreadPool>
+#include <QTimer>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
 
 #ifdef Q_OS_WIN
 #include <Windows.h>
-#include <comdef.h>
-#include <Wbemidl.h>
-#pragma comment(lib, "wbemuuid.lib")
+#include <winioctl.h>
+#include <dxgi.h>
+#include <intrin.h>
+#pragma comment(lib, "dxgi.lib")
 #endif
 
 // ---------------------------------------------------------------------------
-// WMI helpers (Windows-only)
+// Native helpers (Windows-only)
 // ---------------------------------------------------------------------------
 #ifdef Q_OS_WIN
 namespace {
 
-struct ComInitGuard
+/// Processor brand string from CPUID leaves 0x80000002-4, empty where CPUID
+/// is unavailable (ARM64) or the leaves are not implemented.
+QString cpuidBrandString()
 {
-    HRESULT hr;
-    bool ownsInit = false;
-    ComInitGuard()
-    {
-        // Qt (especially WebEngine) already calls CoInitializeEx with APARTMENTTHREADED.
-        // Try MTA first, then STA, then assume COM is already initialized.
-        hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
-        if (hr == RPC_E_CHANGED_MODE) {
-            // Already initialized as STA — that's fine, use it
-            hr = CoInitializeEx(nullptr, COINIT_APARTMENTTHREADED);
-        }
-        ownsInit = SUCCEEDED(hr);
-        // Even if CoInit fails with S_FALSE (already init'd) or RPC_E_CHANGED_MODE,
-        // WMI can still work if COM is already initialized by Qt.
-
-        // CoInitializeSecurity — call it, ignore if already set
-        HRESULT secHr = CoInitializeSecurity(
-            nullptr, -1, nullptr, nullptr,
-            RPC_C_AUTHN_LEVEL_DEFAULT,
-            RPC_C_IMP_LEVEL_IMPERSONATE,
-            nullptr, EOAC_NONE, nullptr);
-        (void)secHr; // RPC_E_TOO_LATE is OK
-    }
-    ~ComInitGuard() { if (ownsInit) CoUninitialize(); }
-};
+#if defined(_M_X64) || defined(_M_IX86)
+    int regs[4] = {};
+    __cpuid(regs, 0x80000000);
+    if (static_cast<unsigned>(regs[0]) < 0x80000004)
+        return {};
+    char brand[49] = {};
+    for (int leaf = 0; leaf < 3; ++leaf) {
+        __cpuid(regs, 0x80000002 + leaf);
+        std::memcpy(brand + leaf * 16, regs, sizeof(regs));
+    }
+    return QString::fromLatin1(brand).simplified();
+#else
+    return {};
+#endif
+}
 
-class WmiSession
+/// STORAGE_PROPERTY_QUERY for one standard property; empty on failure.
+QByteArray storageProperty(HANDLE disk, STORAGE_PROPERTY_ID id)
 {
-public:
-    bool open()
-    {
-        HRESULT hr = CoCreateInstance(CLSID_WbemLocator, nullptr,
-                                      CLSCTX_INPROC_SERVER, IID_IWbemLocator,
-                                      reinterpret_cast<void **>(&m_locator));
-        if (FAILED(hr) || !m_locator) {
-            qWarning() << "[HW] CoCreateInstance WbemLocator failed:" << Qt::hex << hr;
-            return false;
-        }
+    STORAGE_PROPERTY_QUERY query = {};
+    query.PropertyId = id;
+    query.QueryType  = PropertyStandardQuery;
+    QByteArray out(1024, '\0');
+    DWORD returned = 0;
+    if (!DeviceIoControl(disk, IOCTL_STORAGE_QUERY_PROPERTY, &query, sizeof(query),
+                         out.data(), DWORD(out.size()), &returned, nullptr))
+        return {};
+    out.resize(int(returned));
+    return out;
+}
 
-        hr = m_locator->ConnectServer(_bstr_t(L"ROOT\\CIMV2"), nullptr, nullptr,
-                                      nullptr, 0, nullptr, nullptr, &m_services);
-        if (FAILED(hr) || !m_services) {
-            qWarning() << "[HW] ConnectServer ROOT\\CIMV2 failed:" << Qt::hex << hr;
-            return false;
-        }
+/// NUL-terminated string at an offset into a storage descriptor.
+QString descriptorString(const QByteArray &desc, DWORD offset)
+{
+    if (offset == 0 || offset >= DWORD(desc.size()))
+        return {};
+    const char *s = desc.constData() + offset;
+    return QString::fromLatin1(s, int(qstrnlen(s, size_t(desc.size()) - offset))).simplified();
+}
 
-        hr = CoSetProxyBlanket(m_services, RPC_C_AUTHN_WINNT, RPC_C_AUTHZ_NONE,
-                               nullptr, RPC_C_AUTHN_LEVEL_CALL,
-                               RPC_C_IMP_LEVEL_IMPERSONATE, nullptr, EOAC_NONE);
-        if (FAILED(hr))
-            qWarning() << "[HW] CoSetProxyBlanket failed:" << Qt::hex << hr;
-        return SUCCEEDED(hr);
+/// Same names SysfsProbe reports on Linux; empty for virtual disks.
+QString busTypeName(STORAGE_BUS_TYPE bus)
+{
+    switch (bus) {
+    case BusTypeNvme:  return QStringLiteral("NVMe");
+    case BusTypeSata:
+    case BusTypeAta:   return QStringLiteral("SATA");
+    case BusTypeUsb:   return QStringLiteral("USB");
+    case BusTypeSd:
+    case BusTypeMmc:   return QStringLiteral("MMC");
+    case BusTypeScsi:
+    case BusTypeSas:
+    case BusTypeRAID:  return QStringLiteral("SCSI");
+    default:           return {};
     }
+}
 
-    ~WmiSession()
-    {
-        if (m_services) m_services->Release();
-        if (m_locator) m_locator->Release();
-    }
+} // anonymous namespace
+#endif // Q_OS_WIN
 
-    QString querySingleString(const wchar_t *wql, const wchar_t *field) const
-    {
-        IEnumWbemClassObject *pEnum = nullptr;
-        HRESULT hr = m_services->ExecQuery(
-            _bstr_t(L"WQL"), _bstr_t(wql),
-            WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
-            nullptr, &pEnum);
-        if (FAILED(hr) || !pEnum) return {};
-
-        IWbemClassObject *pObj = nullptr;
-        ULONG ret = 0;
-        hr = pEnum->Next(WBEM_INFINITE, 1, &pObj, &ret);
-        QString result;
-        if (SUCCEEDED(hr) && ret > 0 && pObj) {
-            VARIANT v; VariantInit(&v);
-            if (SUCCEEDED(pObj->Get(field, 0, &v, nullptr, nullptr)) && v.vt == VT_BSTR)
-                result = QString::fromWCharArray(v.bstrVal);
-            VariantClear(&v);
-            pObj->Release();
-        }
-        pEnum->Release();
-        return result.trimmed();
-    }
+// ---------------------------------------------------------------------------
+// Probe scheduling
+// ---------------------------------------------------------------------------
+namespace {
 
-    quint32 querySingleUInt32(const wchar_t *wql, const wchar_t *field) const
-    {
-        IEnumWbemClassObject *pEnum = nullptr;
-        HRESULT hr = m_services->ExecQuery(
-            _bstr_t(L"WQL"), _bstr_t(wql),
-            WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
-            nullptr, &pEnum);
-        if (FAILED(hr) || !pEnum) return 0;
-
-        IWbemClassObject *pObj = nullptr;
-        ULONG ret = 0;
-        hr = pEnum->Next(WBEM_INFINITE, 1, &pObj, &ret);
-        quint32 result = 0;
-        if (SUCCEEDED(hr) && ret > 0 && pObj) {
-            VARIANT v; VariantInit(&v);
-            if (SUCCEEDED(pObj->Get(field, 0, &v, nullptr, nullptr))) {
-                if (v.vt == VT_I4 || v.vt == VT_UI4 || v.vt == VT_INT || v.vt == VT_UINT)
-                    result = v.ulVal;
-            }
-            VariantClear(&v);
-            pObj->Release();
-        }
-        pEnum->Release();
-        return result;
-    }
+/// Dedicated pool so slow subprocess probes never starve QtConcurrent's
+/// global pool. Intentionally leaked: a hung probe must not block exit.
+QThreadPool *probePool()
+{
+    static QThreadPool *pool = [] {
+        auto *p = new QThreadPool;
+        p->setMaxThreadCount(qMax(4, QThread::idealThreadCount()));
+        p->setExpiryTimeout(10000);
+        return p;
+    }();
+    return pool;
+}
 
-    QStringList queryStringList(const wchar_t *wql, const wchar_t *field) const
-    {
-        QStringList items;
-        IEnumWbemClassObject *pEnum = nullptr;
-        HRESULT hr = m_services->ExecQuery(
-            _bstr_t(L"WQL"), _bstr_t(wql),
-            WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
-            nullptr, &pEnum);
-        if (FAILED(hr) || !pEnum) return items;
-
-        while (true) {
-            IWbemClassObject *pObj = nullptr;
-            ULONG ret = 0;
-            hr = pEnum->Next(WBEM_INFINITE, 1, &pObj, &ret);
-            if (FAILED(hr) || ret == 0 || !pObj) break;
-
-            VARIANT v; VariantInit(&v);
-            if (SUCCEEDED(pObj->Get(field, 0, &v, nullptr, nullptr)) && v.vt == VT_BSTR) {
-                QString s = QString::fromWCharArray(v.bstrVal).trimmed();
-                if (!s.isEmpty()) items.append(s);
-            }
-            VariantClear(&v);
-            pObj->Release();
-        }
-        pEnum->Release();
-        return items;
-    }
+int longestTimeout(const QList<HardwareProbe> &probes)
+{
+    int ms = 0;
+    for (const HardwareProbe &p : probes)
+        ms = qMax(ms, p.timeoutMs);
+    return ms;
+}
 
-    quint64 querySumUInt64(const wchar_t *wql, const wchar_t *field) const
-    {
-        quint64 sum = 0;
-        IEnumWbemClassObject *pEnum = nullptr;
-        HRESULT hr = m_services->ExecQuery(
-            _bstr_t(L"WQL"), _bstr_t(wql),
-            WBEM_FLAG_FORWARD_ONLY | WBEM_FLAG_RETURN_IMMEDIATELY,
-            nullptr, &pEnum);
-        if (FAILED(hr) || !pEnum) return sum;
-
-        while (true) {
-            IWbemClassObject *pObj = nullptr;
-            ULONG ret = 0;
-            hr = pEnum->Next(WBEM_INFINITE, 1, &pObj, &ret);
-            if (FAILED(hr) || ret == 0 || !pObj) break;
-
-            VARIANT v; VariantInit(&v);
-            if (SUCCEEDED(pObj->Get(field, 0, &v, nullptr, nullptr))) {
-                if (v.vt == VT_BSTR)        sum += _wtoi64(v.bstrVal);
-                else if (v.vt == VT_UI8)     sum += v.ullVal;
-                else if (v.vt == VT_I8)      sum += static_cast<quint64>(v.llVal);
-            }
-            VariantClear(&v);
-            pObj->Release();
-        }
-        pEnum->Release();
-        return sum;
-    }
+/// Run a probe and report whether it came back inside its deadline.
+bool runProbe(const HardwareProbe &probe, HardwareInfo &out)
+{
+    TRACE_SCOPE("hw", probe.name);
+    QElapsedTimer clock;
+    clock.start();
+    out = probe.run(probe.timeoutMs);
+    const qint64 elapsed = clock.elapsed();
+    if (elapsed > probe.timeoutMs) {
+        qWarning() << "[HW] Probe" << probe.name << "missed its deadline:"
+                   << elapsed << "ms >" << probe.timeoutMs << "ms";
+        return false;
+    }
+    qDebug() << "[HW] Probe" << probe.name << "finished in" << elapsed << "ms";
+    return true;
+}
+
+#ifndef Q_OS_WIN
+/// Start a subprocess and wait for it within timeoutMs; kills it on timeout.
+QString runTool(const QString &program, const QStringList &args, int timeoutMs)
+{
+    QProcess proc;
+    proc.start(program, args);
+    if (!proc.waitForFinished(timeoutMs)) {
+        proc.kill();
+        proc.waitForFinished(250);
+        return {};
+    }
+    return QString::fromUtf8(proc.readAllStandardOutput());
+}
 
-private:
-    IWbemLocator  *m_locator  = nullptr;
-    IWbemServices *m_services = nullptr;
-};
+QString readSysFile(const QString &path)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+        return {};
+    return QString::fromUtf8(f.readAll()).trimmed();
+}
+#endif
 
 } // anonymous namespace
-#endif // Q_OS_WIN
 
 // ---------------------------------------------------------------------------
 // Public API
 // ---------------------------------------------------------------------------
-HardwareInfo HardwareDetector::detect() const
+void HardwareDetector::detectAsync(QObject *context,
+                                   std::function<void(const HardwareInfo &, const QString &)> onProbe,
+                                   std::function<void()> onFinished) const
+{
+    // All fields except `context` are only touched on the context's thread.
+    struct AsyncRun
+    {
+        QPointer<QObject> context;
+        std::function<void(const HardwareInfo &, const QString &)> onProbe;
+        std::function<void()> onFinished;
+        int  pending  = 0;
+        bool finished = false;
+
+        void finish()
+        {
+            if (finished) return;
+            finished = true;
+            if (onFinished) onFinished();
+        }
+    };
+
+    const QList<HardwareProbe> all = probes();
+    auto run = std::make_shared<AsyncRun>();
+    run->context    = context;
+    run->onProbe    = std::move(onProbe);
+    run->onFinished = std::move(onFinished);
+    run->pending    = all.size();
+
+    for (const HardwareProbe &probe : all) {
+        probePool()->start([run, probe]() {
+            HardwareInfo partial;
+            const bool inTime = runProbe(probe, partial);
+            QObject *ctx = run->context.data();
+            if (!ctx) return;
+            QMetaObject::invokeMethod(ctx, [run, partial, inTime, name = QString::fromLatin1(probe.name)]() {
+                if (run->finished) return;
+                if (inTime && run->onProbe)
+                    run->onProbe(partial, name);
+                if (--run->pending == 0)
+                    run->finish();
+            }, Qt::QueuedConnection);
+        });
+    }
+
+    // Global deadline: whatever has not reported by now is abandoned.
+    QTimer::singleShot(longestTimeout(all) + 250, context, [run]() {
+        if (!run->finished && run->pending > 0)
+            qWarning() << "[HW]" << run->pending << "probe(s) abandoned at deadline";
+        run->finish();
+    });
+}
+
+QList<HardwareProbe> HardwareDetector::probes()
 {
 #ifdef Q_OS_WIN
-    return detectWindows();
+    return {
+        { "cpu",               1000, &HardwareDetector::probeWindowsCpu },
+        { "memory",            1000, &HardwareDetector::probeWindowsMemory },
+        { "gpu",               1000, &HardwareDetector::probeWindowsGpu },
+        { "smbios",            1000, &HardwareDetector::probeWindowsSmbios },
+        { "storage",           2000, &HardwareDetector::probeWindowsStorage },
+        { "firmware-registry", 1000, &HardwareDetector::probeWindowsFirmwareRegistry },
+    };
 #else
-    return detectLinux();
+    return {
+        { "cpu",         1000, &HardwareDetector::probeLinuxCpu },
+        { "memory",      1000, &HardwareDetector::probeLinuxMemory },
+        { "gpu",         1000, &HardwareDetector::probeLinuxGpu },
+        { "dmi",         1000, &HardwareDetector::probeLinuxDmi },
+        { "storage",     1000, &HardwareDetector::probeLinuxStorage },
+        { "cpu-cache",   1000, &HardwareDetector::probeLinuxCpuCache },
+        { "secure-boot", 3000, &HardwareDetector::probeLinuxSecureBoot },
+        { "tpm",         1000, &HardwareDetector::probeLinuxTpm },
+    };
 #endif
 }
 
+void HardwareDetector::merge(HardwareInfo &into, const HardwareInfo &partial)
+{
+    auto str  = [](QString &dst, const QString &src)         { if (!src.isEmpty()) dst = src; };
+    auto list = [](auto &dst, const auto &src)               { if (!src.isEmpty()) dst = src; };
+    auto num  = [](auto &dst, auto src)                      { if (src != 0) dst = src; };
+
+    str(into.cpuName, partial.cpuName);
+    str(into.gpuName, partial.gpuName);
+    str(into.gpuVendor, partial.gpuVendor);
+    num(into.ramMb, partial.ramMb);
+    num(into.cpuCores, partial.cpuCores);
+    num(into.cpuThreads, partial.cpuThreads);
+    num(into.cpuMaxClockMhz, partial.cpuMaxClockMhz);
+    str(into.motherboard, partial.motherboard);
+    list(into.storage, partial.storage);
+    into.hasSsd  = into.hasSsd  || partial.hasSsd;
+    into.hasNvme = into.hasNvme || partial.hasNvme;
+
+    str(into.ramType, partial.ramType);
+    num(into.ramSpeedMhz, partial.ramSpeedMhz);
+    num(into.gpuVramMb, partial.gpuVramMb);
+    str(into.gpuDriverVersion, partial.gpuDriverVersion);
+    num(into.cpuL2CacheKb, partial.cpuL2CacheKb);
+    num(into.cpuL3CacheKb, partial.cpuL3CacheKb);
+    num(into.cpuPackages, partial.cpuPackages);
+    num(into.cpuPerformanceCores, partial.cpuPerformanceCores);
+    num(into.cpuEfficiencyCores, partial.cpuEfficiencyCores);
+    num(into.cpuL3Domains, partial.cpuL3Domains);
+    list(into.diskInterfaces, partial.diskInterfaces);
+    list(into.diskSizesGb, partial.diskSizesGb);
+    num(into.ramChannels, partial.ramChannels);
+    num(into.ramRanks, partial.ramRanks);
+    num(into.ramSlots, partial.ramSlots);
+    list(into.ramModulesMb, partial.ramModulesMb);
+
+    str(into.biosVersion, partial.biosVersion);
+    str(into.biosDate, partial.biosDate);
+    str(into.tpmVersion, partial.tpmVersion);
+    into.secureBootEnabled = into.secureBootEnabled || partial.secureBootEnabled;
+    str(into.chassisType, partial.chassisType);
+}
+
+void HardwareDetector::finalize(HardwareInfo &info)
+{
+    TRACE_SCOPE("hw", "finalize");
+    if (info.gpuVendor.isEmpty() && !info.gpuName.isEmpty())
+        info.gpuVendor = classifyGpuVendor(info.gpuName);
+
+    if (info.cpuName.isEmpty()) info.cpuName = QSysInfo::currentCpuArchitecture();
+    if (info.cpuCores == 0) info.cpuCores = info.cpuThreads;
+    if (info.gpuName.isEmpty()) info.gpuName = QStringLiteral("Unknown");
+    if (info.gpuVendor.isEmpty()) info.gpuVendor = QStringLiteral("Unknown");
+    if (info.motherboard.isEmpty()) info.motherboard = QStringLiteral("Unknown");
+    if (info.ramType.isEmpty()) info.ramType = QStringLiteral("Unknown");
+    if (info.biosVersion.isEmpty()) info.biosVersion = QStringLiteral("Unknown");
+    if (info.chassisType.isEmpty()) info.chassisType = QStringLiteral("Unknown");
+    if (info.tpmVersion.isEmpty()) info.tpmVersion = QStringLiteral("Not detected");
+
+    qDebug() << "[HW] Detected:" << info.cpuName << "|" << info.gpuName
+             << "|" << info.gpuVendor << "| RAM" << info.ramMb << "MB"
+             << info.ramType << "@" << info.ramSpeedMhz << "MHz"
+             << info.ramModulesMb.size() << "modules /" << info.ramChannels << "ch"
+             << "| Cores" << info.cpuCores << "/" << info.cpuThreads
+             << "(" << info.cpuPerformanceCores << "P" << info.cpuEfficiencyCores << "E,"
+             << info.cpuL3Domains << "L3 )"
+             << "| VRAM" << info.gpuVramMb << "MB"
+             << "| BIOS" << info.biosVersion
+             << "| Chassis" << info.chassisType;
+}
+
+#ifndef Q_OS_WIN
 // ---------------------------------------------------------------------------
-// Linux fallback — reads /proc, /sys, lspci for dev-time testing
+// Linux probes — /proc and /sys (storage/GPU via SysfsProbe, firmware and
+// memory via SmbiosDecoder); mokutil remains a subprocess
 // ---------------------------------------------------------------------------
-HardwareInfo HardwareDetector::detectLinux() const
+HardwareInfo HardwareDetector::probeLinuxCpu(int)
 {
     HardwareInfo info;
-
-    // CPU from /proc/cpuinfo
+    quint64 currentMhz = 0;
     QFile cpuFile(QStringLiteral("/proc/cpuinfo"));
     if (cpuFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
         QTextStream in(&cpuFile);
-        int logicalCores = 0;
-        QSet<int> coreIds;
         while (!in.atEnd()) {
             const QString line = in.readLine();
             if (line.startsWith(QStringLiteral("model name")) && info.cpuName.isEmpty()) {
                 info.cpuName = line.mid(line.indexOf(QLatin1Char(':')) + 1).trimmed();
             }
-            if (line.startsWith(QStringLiteral("cpu MHz")) && info.cpuMaxClockMhz == 0) {
-                info.cpuMaxClockMhz = static_cast<quint64>(
+            if (line.startsWith(QStringLiteral("cpu MHz")) && currentMhz == 0) {
+                currentMhz = static_cast<quint64>(
                     line.mid(line.indexOf(QLatin1Char(':')) + 1).trimmed().toDouble());
             }
             if (line.startsWith(QStringLiteral("processor")))
-                ++logicalCores;
-            if (line.startsWith(QStringLiteral("core id"))) {
-                int id = line.mid(line.indexOf(QLatin1Char(':')) + 1).trimmed().toInt();
-                coreIds.insert(id);
-            }
+                ++info.cpuThreads;
         }
-        cpuFile.close();
-        info.cpuThreads = logicalCores;
-        info.cpuCores = coreIds.isEmpty() ? logicalCores : coreIds.size();
     }
 
-    // RAM from /proc/meminfo
-    QFile memFile(QStringLiteral("/proc/meminfo"));
-    if (memFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QTextStream in(&memFile);
-        while (!in.atEnd()) {
-            const QString line = in.readLine();
-            if (line.startsWith(QStringLiteral("MemTotal"))) {
-                // "MemTotal:       16384000 kB"
-                static QRegularExpression rx(QStringLiteral("(\\d+)"));
-                auto match = rx.match(line);
-                if (match.hasMatch())
-                    info.ramMb = match.captured(1).toULongLong() / 1024ULL;
-                break;
-            }
-        }
-        memFile.close();
-    }
-
-    // GPU via lspci
-    {
-        QProcess proc;
-        proc.start(QStringLiteral("lspci"), QStringList() << QStringLiteral("-mm"));
-        if (proc.waitForFinished(3000)) {
-            const QString output = QString::fromUtf8(proc.readAllStandardOutput());
-            for (const QString &line : output.split(QLatin1Char('\n'))) {
-                if (line.contains(QStringLiteral("VGA"), Qt::CaseInsensitive) ||
-                    line.contains(QStringLiteral("3D controller"), Qt::CaseInsensitive) ||
-                    line.contains(QStringLiteral("Display"), Qt::CaseInsensitive))
-                {
-                    // Take the last quoted field or the whole line as GPU name
-                    static QRegularExpression rxQuote(QStringLiteral("\"([^\"]+)\""));
-                    QStringList parts;
-                    auto it = rxQuote.globalMatch(line);
-                    while (it.hasNext()) parts << it.next().captured(1);
-                    if (parts.size() >= 3)
-                        info.gpuName = parts.at(2); // device name
-                    else if (!parts.isEmpty())
-                        info.gpuName = parts.last();
-                    break;
-                }
-            }
-        }
-        info.gpuVendor = classifyGpuVendor(info.gpuName);
-    }
-
-    // Motherboard from DMI
-    {
-        QFile f(QStringLiteral("/sys/devices/virtual/dmi/id/board_name"));
-        if (f.open(QIODevice::ReadOnly | QIODevice::Text))
-            info.motherboard = QString::fromUtf8(f.readAll()).trimmed();
-    }
-
-    // Storage from /sys/block
-    {
-        QProcess proc;
-        proc.start(QStringLiteral("lsblk"),
-                    QStringList() << QStringLiteral("-d") << QStringLiteral("-o")
-                                  << QStringLiteral("NAME,MODEL,ROTA,TRAN") << QStringLiteral("-n"));
-        if (proc.waitForFinished(3000)) {
-            const QString output = QString::fromUtf8(proc.readAllStandardOutput());
-            for (const QString &line : output.split(QLatin1Char('\n'))) {
-                const QStringList parts = line.simplified().split(QLatin1Char(' '));
-                if (parts.size() >= 2) {
-                    // Reconstruct model name (may have spaces)
-                    QString model = parts.mid(1, parts.size() - 3).join(QLatin1Char(' ')).trimmed();
-                    if (model.isEmpty()) model = parts.at(0);
-                    if (!model.isEmpty()) info.storage.append(model);
-
-                    // Check rotation (0 = SSD) and transport (nvme)
-                    if (parts.size() >= 3 && parts.at(parts.size() - 2) == QStringLiteral("0"))
-                        info.hasSsd = true;
-                    if (parts.size() >= 4 && parts.last().contains(QStringLiteral("nvme"), Qt::CaseInsensitive)) {
-                        info.hasNvme = true;
-                        info.hasSsd = true;
-                    }
-                }
-            }
-        }
-    }
-
-    if (info.cpuName.isEmpty()) info.cpuName = QSysInfo::currentCpuArchitecture();
-    if (info.gpuName.isEmpty()) info.gpuName = QStringLiteral("Unknown");
-    if (info.gpuVendor.isEmpty()) info.gpuVendor = QStringLiteral("Unknown");
-    if (info.motherboard.isEmpty()) info.motherboard = QStringLiteral("Unknown");
-
-    // ── Lag 2: Low-Level (Linux) ──
-
-    // CPU Cache from /sys
-    {
-        QFile l2(QStringLiteral("/sys/devices/system/cpu/cpu0/cache/index2/size"));
-        if (l2.open(QIODevice::ReadOnly)) {
-            QString val = QString::fromUtf8(l2.readAll()).trimmed();
-            if (val.endsWith(QLatin1Char('K')))
-                info.cpuL2CacheKb = val.chopped(1).toUInt();
-            else
-                info.cpuL2CacheKb = val.toUInt();
-        }
-        QFile l3(QStringLiteral("/sys/devices/system/cpu/cpu0/cache/index3/size"));
-        if (l3.open(QIODevice::ReadOnly)) {
-            QString val = QString::fromUtf8(l3.readAll()).trimmed();
-            if (val.endsWith(QLatin1Char('K')))
-                info.cpuL3CacheKb = val.chopped(1).toUInt();
-            else if (val.endsWith(QLatin1Char('M')))
-                info.cpuL3CacheKb = val.chopped(1).toUInt() * 1024;
-            else
-                info.cpuL3CacheKb = val.toUInt();
-        }
-    }
+    // Cores per package/die from sysfs; "core id" repeats across sockets.
+    // The clock is the highest rated core, not the current "cpu MHz".
+    CpuTopology::system().applyTo(info);
+    if (info.cpuMaxClockMhz == 0)
+        info.cpuMaxClockMhz = currentMhz;   // no cpufreq (VMs)
+    return info;
+}
 
-    // RAM type & speed from dmidecode (requires root — best effort)
-    {
-        QProcess proc;
-        proc.start(QStringLiteral("dmidecode"), QStringList()
-                    << QStringLiteral("-t") << QStringLiteral("memory"));
-        if (proc.waitForFinished(3000)) {
-            QString out = QString::fromUtf8(proc.readAllStandardOutput());
-            for (const QString &line : out.split(QLatin1Char('\n'))) {
-                QString trimmed = line.trimmed();
-                if (trimmed.startsWith(QStringLiteral("Type:")) && info.ramType.isEmpty()) {
-                    info.ramType = trimmed.mid(5).trimmed();
-                }
-                if (trimmed.startsWith(QStringLiteral("Configured Memory Speed:")) && info.ramSpeedMhz == 0) {
-                    static QRegularExpression rxNum(QStringLiteral("(\\d+)"));
-                    auto m = rxNum.match(trimmed);
-                    if (m.hasMatch()) info.ramSpeedMhz = m.captured(1).toUInt();
-                }
-            }
-        }
-    }
+HardwareInfo HardwareDetector::probeLinuxMemory(int)
+{
+    HardwareInfo info;
+    QFile memFile(QStringLiteral("/proc/meminfo"));
+    if (!memFile.open(QIODevice::ReadOnly | QIODevice::Text))
+        return info;
 
-    // Disk sizes
-    {
-        QProcess proc;
-        proc.start(QStringLiteral("lsblk"),
-                    QStringList() << QStringLiteral("-d") << QStringLiteral("-b")
-                                  << QStringLiteral("-o") << QStringLiteral("SIZE,TRAN")
-                                  << QStringLiteral("-n"));
-        if (proc.waitForFinished(3000)) {
-            QString out = QString::fromUtf8(proc.readAllStandardOutput());
-            for (const QString &line : out.split(QLatin1Char('\n'))) {
-                QStringList parts = line.simplified().split(QLatin1Char(' '));
-                if (parts.size() >= 1) {
-                    quint64 bytes = parts.at(0).toULongLong();
-                    if (bytes > 0)
-                        info.diskSizesGb.append(bytes / (1024ULL * 1024ULL * 1024ULL));
-                    if (parts.size() >= 2)
-                        info.diskInterfaces.append(parts.at(1));
-                }
-            }
+    QTextStream in(&memFile);
+    while (!in.atEnd()) {
+        const QString line = in.readLine();
+        if (line.startsWith(QStringLiteral("MemTotal"))) {
+            // "MemTotal:       16384000 kB"
+            static const QRegularExpression rx(QStringLiteral("(\\d+)"));
+            auto match = rx.match(line);
+            if (match.hasMatch())
+                info.ramMb = match.captured(1).toULongLong() / 1024ULL;
+            break;
         }
     }
+    return info;
+}
 
-    // ── Lag 3: Firmware / SMBIOS (Linux) ──
-
-    // BIOS version & date
-    {
-        QFile bv(QStringLiteral("/sys/devices/virtual/dmi/id/bios_version"));
-        if (bv.open(QIODevice::ReadOnly))
-            info.biosVersion = QString::fromUtf8(bv.readAll()).trimmed();
-        QFile bd(QStringLiteral("/sys/devices/virtual/dmi/id/bios_date"));
-        if (bd.open(QIODevice::ReadOnly))
-            info.biosDate = QString::fromUtf8(bd.readAll()).trimmed();
-    }
+HardwareInfo HardwareDetector::probeLinuxGpu(int)
+{
+    return SysfsProbe::gpu();
+}
 
-    // Chassis type
-    {
-        QFile ct(QStringLiteral("/sys/devices/virtual/dmi/id/chassis_type"));
-        if (ct.open(QIODevice::ReadOnly)) {
-            quint32 code = QString::fromUtf8(ct.readAll()).trimmed().toUInt();
-            info.chassisType = classifyChassisType(code);
-        }
+HardwareInfo HardwareDetector::probeLinuxDmi(int)
+{
+    // The raw table has firmware and memory layout in one pass but needs
+    // root; the world-readable dmi/id attributes still cover the firmware.
+    HardwareInfo info = SmbiosDecoder::decode(SmbiosDecoder::readSysfsTable());
+
+    const QString dmi = QStringLiteral("/sys/devices/virtual/dmi/id/");
+    if (info.motherboard.isEmpty())
+        info.motherboard = readSysFile(dmi + QStringLiteral("board_name"));
+    if (info.biosVersion.isEmpty()) {
+        info.biosVersion = readSysFile(dmi + QStringLiteral("bios_version"));
+        info.biosDate    = readSysFile(dmi + QStringLiteral("bios_date"));
+    }
+    if (info.chassisType.isEmpty()) {
+        const QString chassis = readSysFile(dmi + QStringLiteral("chassis_type"));
+        if (!chassis.isEmpty())
+            info.chassisType = SmbiosDecoder::chassisTypeName(chassis.toUInt());
     }
+    return info;
+}
 
-    // Secure Boot
-    {
-        QProcess proc;
-        proc.start(QStringLiteral("mokutil"), QStringList() << QStringLiteral("--sb-state"));
-        if (proc.waitForFinished(3000)) {
-            QString out = QString::fromUtf8(proc.readAllStandardOutput());
-            info.secureBootEnabled = out.contains(QStringLiteral("enabled"), Qt::CaseInsensitive);
-        }
-    }
+HardwareInfo HardwareDetector::probeLinuxStorage(int)
+{
+    return SysfsProbe::storage();
+}
 
-    // TPM
-    {
-        info.tpmVersion = QStringLiteral("Not detected");
-        QFile tpm(QStringLiteral("/sys/class/tpm/tpm0/tpm_version_major"));
-        if (tpm.open(QIODevice::ReadOnly)) {
-            QString ver = QString::fromUtf8(tpm.readAll()).trimmed();
-            info.tpmVersion = ver + QStringLiteral(".0");
-        }
-    }
+HardwareInfo HardwareDetector::probeLinuxCpuCache(int)
+{
+    HardwareInfo info;
+    const QString l2 = readSysFile(QStringLiteral("/sys/devices/system/cpu/cpu0/cache/index2/size"));
+    if (l2.endsWith(QLatin1Char('K')))
+        info.cpuL2CacheKb = l2.chopped(1).toUInt();
+    else
+        info.cpuL2CacheKb = l2.toUInt();
+
+    const QString l3 = readSysFile(QStringLiteral("/sys/devices/system/cpu/cpu0/cache/index3/size"));
+    if (l3.endsWith(QLatin1Char('K')))
+        info.cpuL3CacheKb = l3.chopped(1).toUInt();
+    else if (l3.endsWith(QLatin1Char('M')))
+        info.cpuL3CacheKb = l3.chopped(1).toUInt() * 1024;
+    else
+        info.cpuL3CacheKb = l3.toUInt();
+    return info;
+}
 
-    if (info.ramType.isEmpty()) info.ramType = QStringLiteral("Unknown");
-    if (info.biosVersion.isEmpty()) info.biosVersion = QStringLiteral("Unknown");
-    if (info.chassisType.isEmpty()) info.chassisType = QStringLiteral("Unknown");
+HardwareInfo HardwareDetector::probeLinuxSecureBoot(int timeoutMs)
+{
+    HardwareInfo info;
+    const QString out = runTool(QStringLiteral("mokutil"), { QStringLiteral("--sb-state") }, timeoutMs);
+    info.secureBootEnabled = out.contains(QStringLiteral("enabled"), Qt::CaseInsensitive);
+    return info;
+}
 
+HardwareInfo HardwareDetector::probeLinuxTpm(int)
+{
+    HardwareInfo info;
+    const QString ver = readSysFile(QStringLiteral("/sys/class/tpm/tpm0/tpm_version_major"));
+    if (!ver.isEmpty())
+        info.tpmVersion = ver + QStringLiteral(".0");
     return info;
 }
 
+#else // Q_OS_WIN
 // ---------------------------------------------------------------------------
-// Windows — PowerShell-first detection with WMI fallback
-// Uses Get-CimInstance (PowerShell) as primary since it avoids all COM
-// initialization issues with Qt WebEngine. Falls back to direct WMI if
-// PowerShell is unavailable.
+// Windows probes — all in-process (registry, CPUID, DXGI, SMBIOS firmware
+// table, storage IOCTLs); each reports within milliseconds.
 // ---------------------------------------------------------------------------
-HardwareInfo HardwareDetector::detectWindows() const
+HardwareInfo HardwareDetector::probeWindowsCpu(int)
 {
     HardwareInfo info;
-#ifdef Q_OS_WIN
-
-    // ═══════════════ PRIMARY: PowerShell (Get-CimInstance) ═══════════════
-    // PowerShell manages its own CIM session — no COM conflicts with Qt.
-    {
-        QProcess ps;
-        ps.setProgram(QStringLiteral("powershell.exe"));
-        ps.setArguments(QStringList()
-            << QStringLiteral("-NoProfile")
-            << QStringLiteral("-NoLogo")
-            << QStringLiteral("-ExecutionPolicy") << QStringLiteral("Bypass")
-            << QStringLiteral("-Command")
-            << QStringLiteral(
-                "try {"
-                "$cpu = Get-CimInstance Win32_Processor -ErrorAction Stop | Select -First 1;"
-                "$gpus = Get-CimInstance Win32_VideoController -ErrorAction Stop;"
-                "$gpu = $gpus | Where-Object {$_.Name -notmatch 'Microsoft|Virtual|Basic'} | Select -First 1;"
-                "if(-not $gpu){$gpu = $gpus | Select -First 1};"
-                "$ram = Get-CimInstance Win32_PhysicalMemory -ErrorAction Stop;"
-                "$ramTotal = ($ram | Measure-Object -Property Capacity -Sum).Sum;"
-                "$ramFirst = $ram | Select -First 1;"
-                "$mb = (Get-CimInstance Win32_BaseBoard -ErrorAction Stop).Product;"
-                "$disks = Get-CimInstance Win32_DiskDrive -ErrorAction Stop;"
-                "$bios = Get-CimInstance Win32_BIOS -ErrorAction Stop;"
-                "$cs = Get-CimInstance Win32_ComputerSystem -ErrorAction Stop;"
-                "Write-Output \"CPU=$($cpu.Name)\";"
-                "Write-Output \"CORES=$($cpu.NumberOfCores)\";"
-                "Write-Output \"THREADS=$($cpu.ThreadCount)\";"
-                "Write-Output \"CLOCK=$($cpu.MaxClockSpeed)\";"
-                "Write-Output \"L2=$($cpu.L2CacheSize)\";"
-                "Write-Output \"L3=$($cpu.L3CacheSize)\";"
-                "Write-Output \"GPU=$($gpu.Name)\";"
-                "Write-Output \"GPUDRIVER=$($gpu.DriverVersion)\";"
-                "Write-Output \"GPUVRAM=$($gpu.AdapterRAM)\";"
-                "Write-Output \"RAM=$ramTotal\";"
-                "Write-Output \"RAMTYPE=$($ramFirst.SMBIOSMemoryType)\";"
-                "Write-Output \"RAMSPEED=$($ramFirst.ConfiguredClockSpeed)\";"
-                "Write-Output \"MB=$mb\";"
-                "Write-Output \"BIOS=$($bios.SMBIOSBIOSVersion)\";"
-                "Write-Output \"BIOSDATE=$($bios.ReleaseDate.ToString('yyyy-MM-dd'))\";"
-                "Write-Output \"CHASSIS=$($cs.PCSystemType)\";"
-                "foreach($d in $disks){"
-                "  Write-Output \"DISK=$($d.Model)\";"
-                "  Write-Output \"DISKSIZE=$($d.Size)\";"
-                "  Write-Output \"DISKIFACE=$($d.InterfaceType)\";"
-                "}"
-                "} catch { Write-Output \"PS_ERROR=$($_.Exception.Message)\" }"
-            ));
-
-        qDebug() << "[HW] Starting PowerShell hardware detection...";
-        ps.start();
-
-        bool finished = ps.waitForFinished(20000);
-        QString psOut = QString::fromUtf8(ps.readAllStandardOutput());
-        QString psErr = QString::fromUtf8(ps.readAllStandardError());
-
-        if (!finished || psOut.isEmpty()) {
-            qWarning() << "[HW] PowerShell failed or timed out."
-                        << "Exit:" << ps.exitCode()
-                        << "Err:" << psErr.left(200);
-            // Fall through to WMI fallback below
-        } else {
-            qDebug() << "[HW] PowerShell output:" << psOut.left(200);
-
-            if (psOut.contains(QStringLiteral("PS_ERROR="))) {
-                qWarning() << "[HW] PowerShell error:" << psOut;
-                // Fall through to WMI
-            } else {
-                // Parse successful PowerShell output
-                for (const QString &line : psOut.split(QLatin1Char('\n'))) {
-                    QString l = line.trimmed();
-                    if (l.startsWith(QStringLiteral("CPU=")))        info.cpuName = l.mid(4);
-                    else if (l.startsWith(QStringLiteral("CORES=")))      info.cpuCores = l.mid(6).toInt();
-                    else if (l.startsWith(QStringLiteral("THREADS=")))    info.cpuThreads = l.mid(8).toInt();
-                    else if (l.startsWith(QStringLiteral("CLOCK=")))      info.cpuMaxClockMhz = l.mid(6).toULongLong();
-                    else if (l.startsWith(QStringLiteral("L2=")))         info.cpuL2CacheKb = l.mid(3).toUInt();
-                    else if (l.startsWith(QStringLiteral("L3=")))         info.cpuL3CacheKb = l.mid(3).toUInt();
-                    else if (l.startsWith(QStringLiteral("GPU=")))        info.gpuName = l.mid(4);
-                    else if (l.startsWith(QStringLiteral("GPUDRIVER=")))  info.gpuDriverVersion = l.mid(10);
-                    else if (l.startsWith(QStringLiteral("GPUVRAM="))) {
-                        quint64 vram = l.mid(8).toULongLong();
-                        info.gpuVramMb = static_cast<quint32>(vram / (1024ULL * 1024ULL));
-                    }
-                    else if (l.startsWith(QStringLiteral("RAM=")))        info.ramMb = l.mid(4).toULongLong() / (1024ULL * 1024ULL);
-                    else if (l.startsWith(QStringLiteral("RAMTYPE=")))    info.ramType = classifyRamType(l.mid(8).toUInt());
-                    else if (l.startsWith(QStringLiteral("RAMSPEED=")))   info.ramSpeedMhz = l.mid(9).toUInt();
-                    else if (l.startsWith(QStringLiteral("MB=")))         info.motherboard = l.mid(3);
-                    else if (l.startsWith(QStringLiteral("BIOS=")))       info.biosVersion = l.mid(5);
-                    else if (l.startsWith(QStringLiteral("BIOSDATE=")))   info.biosDate = l.mid(9);
-                    else if (l.startsWith(QStringLiteral("CHASSIS="))) {
-                        int ct = l.mid(8).toInt();
-                        if (ct == 2) info.chassisType = QStringLiteral("Laptop");
-                        else if (ct == 1 || ct == 3) info.chassisType = QStringLiteral("Desktop");
-                        else info.chassisType = QStringLiteral("Unknown");
-                    }
-                    else if (l.startsWith(QStringLiteral("DISK="))) {
-                        QString model = l.mid(5);
-                        if (!model.isEmpty()) info.storage.append(model);
-                        if (model.contains(QStringLiteral("SSD"), Qt::CaseInsensitive) ||
-                            model.contains(QStringLiteral("NVMe"), Qt::CaseInsensitive))
-                            info.hasSsd = true;
-                        if (model.contains(QStringLiteral("NVMe"), Qt::CaseInsensitive))
-                            info.hasNvme = true;
-                    }
-                    else if (l.startsWith(QStringLiteral("DISKSIZE="))) {
-                        quint64 bytes = l.mid(9).toULongLong();
-                        if (bytes > 0)
-                            info.diskSizesGb.append(bytes / (1024ULL * 1024ULL * 1024ULL));
-                    }
-                    else if (l.startsWith(QStringLiteral("DISKIFACE="))) {
-                        info.diskInterfaces.append(l.mid(10));
-                    }
-                }
-
-                info.gpuVendor = classifyGpuVendor(info.gpuName);
-
-                // RAM fallback via GlobalMemoryStatusEx if PowerShell reported 0
-                if (info.ramMb == 0) {
-                    MEMORYSTATUSEX memInfo;
-                    memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-                    if (GlobalMemoryStatusEx(&memInfo))
-                        info.ramMb = memInfo.ullTotalPhys / (1024ULL * 1024ULL);
-                }
-
-                // Secure Boot from registry
-                {
-                    HKEY hKey;
-                    if (RegOpenKeyExW(HKEY_LOCAL_MACHINE,
-                                      L"SYSTEM\\CurrentControlSet\\Control\\SecureBoot\\State",
-                                      0, KEY_READ, &hKey) == ERROR_SUCCESS) {
-                        DWORD val = 0, size = sizeof(val);
-                        if (RegQueryValueExW(hKey, L"UEFISecureBootEnabled", nullptr, nullptr,
-                                             reinterpret_cast<LPBYTE>(&val), &size) == ERROR_SUCCESS)
-                            info.secureBootEnabled = (val == 1);
-                        RegCloseKey(hKey);
-                    }
-                }
-
-                // TPM from registry
-                {
-                    info.tpmVersion = QStringLiteral("Not detected");
-                    HKEY hKey;
-                    if (RegOpenKeyExW(HKEY_LOCAL_MACHINE,
-                                      L"SYSTEM\\CurrentControlSet\\Services\\TPM\\WMI",
-                                      0, KEY_READ, &hKey) == ERROR_SUCCESS) {
-                        info.tpmVersion = QStringLiteral("Present");
-                        RegCloseKey(hKey);
-                    }
-                }
-
-                // Apply fallback values
-                if (info.cpuName.isEmpty()) info.cpuName = QSysInfo::currentCpuArchitecture();
-                if (info.gpuName.isEmpty()) info.gpuName = QStringLiteral("Unknown");
-                if (info.motherboard.isEmpty()) info.motherboard = QStringLiteral("Unknown");
-                if (info.ramType.isEmpty()) info.ramType = QStringLiteral("Unknown");
-                if (info.biosVersion.isEmpty()) info.biosVersion = QStringLiteral("Unknown");
-                if (info.chassisType.isEmpty()) info.chassisType = QStringLiteral("Unknown");
-
-                qDebug() << "[HW] PowerShell detected:" << info.cpuName << "|" << info.gpuName
-                         << "|" << info.gpuVendor << "| RAM" << info.ramMb << "MB"
-                         << info.ramType << "@" << info.ramSpeedMhz << "MHz"
-                         << "| Cores" << info.cpuCores << "/" << info.cpuThreads;
-
-                return info;
-            }
+    info.cpuName = cpuidBrandString();
+
+    HKEY hKey;
+    if (RegOpenKeyExW(HKEY_LOCAL_MACHINE,
+                      L"HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+                      0, KEY_READ, &hKey) == ERROR_SUCCESS) {
+        wchar_t name[256] = {};
+        DWORD size = sizeof(name);
+        if (info.cpuName.isEmpty() &&
+            RegQueryValueExW(hKey, L"ProcessorNameString", nullptr, nullptr,
+                             reinterpret_cast<LPBYTE>(name), &size) == ERROR_SUCCESS)
+            info.cpuName = QString::fromWCharArray(name).trimmed();
+
+        DWORD mhz = 0;
+        size = sizeof(mhz);
+        if (RegQueryValueExW(hKey, L"~MHz", nullptr, nullptr,
+                             reinterpret_cast<LPBYTE>(&mhz), &size) == ERROR_SUCCESS)
+            info.cpuMaxClockMhz = mhz;
+        RegCloseKey(hKey);
+    }
+
+    // L2/L3 totals: one entry per cache instance, as Win32_Processor reported
+    DWORD length = 0;
+    GetLogicalProcessorInformationEx(RelationCache, nullptr, &length);
+    QByteArray buffer(int(length), '\0');
+    if (length > 0 &&
+        GetLogicalProcessorInformationEx(
+            RelationCache, reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(buffer.data()), &length)) {
+        for (DWORD offset = 0; offset < length;) {
+            const auto *entry = reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *>(
+                buffer.constData() + offset);
+            if (entry->Cache.Level == 2)
+                info.cpuL2CacheKb += entry->Cache.CacheSize / 1024;
+            else if (entry->Cache.Level == 3)
+                info.cpuL3CacheKb += entry->Cache.CacheSize / 1024;
+            offset += entry->Size;
         }
     }
 
-    // ═══════════════ FALLBACK: Direct WMI ═══════════════
-    qDebug() << "[HW] Falling back to WMI...";
-
-    ComInitGuard comInit;
-    WmiSession wmi;
-    if (!wmi.open()) {
-        qWarning() << "[HW] WMI fallback also failed. Using basic info only.";
-        info.cpuName = QSysInfo::currentCpuArchitecture();
-        info.gpuName = QStringLiteral("Unknown");
-        info.motherboard = QStringLiteral("Unknown");
-        // At least get RAM via Win32 API
-        MEMORYSTATUSEX memInfo;
-        memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-        if (GlobalMemoryStatusEx(&memInfo))
-            info.ramMb = memInfo.ullTotalPhys / (1024ULL * 1024ULL);
-        return info;
-    }
+    CpuTopology::system().applyTo(info);
+    if (info.cpuThreads == 0)
+        info.cpuThreads = static_cast<int>(GetActiveProcessorCount(ALL_PROCESSOR_GROUPS));
+    return info;
+}
 
-    // CPU
-    info.cpuName        = wmi.querySingleString(L"SELECT Name FROM Win32_Processor", L"Name");
-    info.cpuCores       = static_cast<int>(wmi.querySingleUInt32(L"SELECT NumberOfCores FROM Win32_Processor", L"NumberOfCores"));
-    info.cpuThreads     = static_cast<int>(wmi.querySingleUInt32(L"SELECT ThreadCount FROM Win32_Processor", L"ThreadCount"));
-    info.cpuMaxClockMhz = wmi.querySingleUInt32(L"SELECT MaxClockSpeed FROM Win32_Processor", L"MaxClockSpeed");
-
-    // GPU — skip virtual/Microsoft Basic Display
-    QStringList gpuNames = wmi.queryStringList(L"SELECT Name FROM Win32_VideoController", L"Name");
-    for (const QString &g : gpuNames) {
-        if (g.contains(QStringLiteral("Microsoft"), Qt::CaseInsensitive) ||
-            g.contains(QStringLiteral("Virtual"), Qt::CaseInsensitive))
-            continue;
-        info.gpuName = g;
-        break;
-    }
-    if (info.gpuName.isEmpty() && !gpuNames.isEmpty())
-        info.gpuName = gpuNames.first();
-    info.gpuVendor = classifyGpuVendor(info.gpuName);
-
-    // Motherboard
-    info.motherboard = wmi.querySingleString(L"SELECT Product FROM Win32_BaseBoard", L"Product");
-
-    // RAM (sum of all DIMMs)
-    const quint64 totalBytes = wmi.querySumUInt64(L"SELECT Capacity FROM Win32_PhysicalMemory", L"Capacity");
-    info.ramMb = totalBytes / (1024ULL * 1024ULL);
-
-    // If WMI RAM query returns 0, try GlobalMemoryStatusEx as fallback
-    if (info.ramMb == 0) {
-        MEMORYSTATUSEX memInfo;
-        memInfo.dwLength = sizeof(MEMORYSTATUSEX);
-        if (GlobalMemoryStatusEx(&memInfo)) {
-            info.ramMb = static_cast<quint64>(memInfo.ullTotalPhys / (1024ULL * 1024ULL));
-        }
-    }
+HardwareInfo HardwareDetector::probeWindowsMemory(int)
+{
+    HardwareInfo info;
+    MEMORYSTATUSEX memInfo;
+    memInfo.dwLength = sizeof(MEMORYSTATUSEX);
+    if (GlobalMemoryStatusEx(&memInfo))
+        info.ramMb = memInfo.ullTotalPhys / (1024ULL * 1024ULL);
+    return info;
+}
 
-    // Storage
-    info.storage = wmi.queryStringList(L"SELECT Model FROM Win32_DiskDrive", L"Model");
-    const QStringList mediaTypes = wmi.queryStringList(L"SELECT MediaType FROM Win32_DiskDrive", L"MediaType");
-    const QStringList interfaces = wmi.queryStringList(L"SELECT InterfaceType FROM Win32_DiskDrive", L"InterfaceType");
+HardwareInfo HardwareDetector::probeWindowsGpu(int)
+{
+    HardwareInfo info;
+    IDXGIFactory1 *factory = nullptr;
+    if (FAILED(CreateDXGIFactory1(__uuidof(IDXGIFactory1), reinterpret_cast<void **>(&factory))))
+        return info;
 
-    for (const QString &m : info.storage) {
-        if (m.contains(QStringLiteral("SSD"), Qt::CaseInsensitive) ||
-            m.contains(QStringLiteral("NVMe"), Qt::CaseInsensitive))
-        {
-            info.hasSsd = true;
-        }
-        if (m.contains(QStringLiteral("NVMe"), Qt::CaseInsensitive))
-            info.hasNvme = true;
-    }
-    for (const QString &mt : mediaTypes) {
-        if (mt.contains(QStringLiteral("SSD"), Qt::CaseInsensitive))
-            info.hasSsd = true;
-    }
-    for (const QString &iface : interfaces) {
-        if (iface.contains(QStringLiteral("NVMe"), Qt::CaseInsensitive) ||
-            iface.contains(QStringLiteral("SCSI"), Qt::CaseInsensitive))
-        {
-            info.hasNvme = true;
-            info.hasSsd = true;
+    // Prefer the adapter with the most dedicated memory: discrete over integrated
+    SIZE_T bestVram = 0;
+    UINT bestVendor = 0;
+    IDXGIAdapter1 *adapter = nullptr;
+    for (UINT i = 0; factory->EnumAdapters1(i, &adapter) != DXGI_ERROR_NOT_FOUND; ++i) {
+        DXGI_ADAPTER_DESC1 desc;
+        const bool usable = SUCCEEDED(adapter->GetDesc1(&desc))
+                         && !(desc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE)
+                         && desc.VendorId != 0x1414;      // Microsoft Basic Render Driver
+        if (usable && (info.gpuName.isEmpty() || desc.DedicatedVideoMemory > bestVram)) {
+            info.gpuName = QString::fromWCharArray(desc.Description).trimmed();
+            bestVram   = desc.DedicatedVideoMemory;
+            bestVendor = desc.VendorId;
+
+            // UMD version, packed the way Device Manager shows it: 31.0.15.5222
+            LARGE_INTEGER umd;
+            if (SUCCEEDED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &umd)))
+                info.gpuDriverVersion = QStringLiteral("%1.%2.%3.%4")
+                                            .arg(HIWORD(umd.HighPart)).arg(LOWORD(umd.HighPart))
+                                            .arg(HIWORD(umd.LowPart)).arg(LOWORD(umd.LowPart));
         }
+        adapter->Release();
     }
+    factory->Release();
 
-    // ── Lag 2: Low-Level ──
+    // 64-bit on x64, so unlike Win32_VideoController.AdapterRAM not capped at 4 GB
+    info.gpuVramMb = static_cast<quint32>(bestVram / (1024ULL * 1024ULL));
+    info.gpuVendor = SysfsProbe::pciVendorName(quint16(bestVendor));
+    if (info.gpuVendor.isEmpty())
+        info.gpuVendor = classifyGpuVendor(info.gpuName);
+    return info;
+}
 
-    // RAM type & speed from SMBIOS (Win32_PhysicalMemory)
-    {
-        quint32 memType = wmi.querySingleUInt32(
-            L"SELECT SMBIOSMemoryType FROM Win32_PhysicalMemory", L"SMBIOSMemoryType");
-        info.ramType = classifyRamType(memType);
-        info.ramSpeedMhz = wmi.querySingleUInt32(
-            L"SELECT ConfiguredClockSpeed FROM Win32_PhysicalMemory", L"ConfiguredClockSpeed");
-        if (info.ramSpeedMhz == 0)
-            info.ramSpeedMhz = wmi.querySingleUInt32(
-                L"SELECT Speed FROM Win32_PhysicalMemory", L"Speed");
-    }
+HardwareInfo HardwareDetector::probeWindowsSmbios(int)
+{
+    const UINT size = GetSystemFirmwareTable('RSMB', 0, nullptr, 0);
+    if (size == 0)
+        return {};
+    QByteArray raw(int(size), '\0');
+    if (GetSystemFirmwareTable('RSMB', 0, raw.data(), size) != size)
+        return {};
+    return SmbiosDecoder::decode(SmbiosDecoder::tableFromRawSmbiosData(raw));
+}
 
-    // GPU VRAM & driver from Win32_VideoController
-    {
-        quint32 vram = wmi.querySingleUInt32(
-            L"SELECT AdapterRAM FROM Win32_VideoController", L"AdapterRAM");
-        info.gpuVramMb = vram / (1024U * 1024U);
-        // AdapterRAM caps at 4 GB (32-bit). For modern GPUs, try registry fallback.
-        if (info.gpuVramMb <= 4096 && !info.gpuName.isEmpty()) {
-            // Try qvideo memory size from DXGI via WMI MSFT namespace (simpler: just report capped)
-            // Most games tools do the same unless using DXGI directly
+HardwareInfo HardwareDetector::probeWindowsStorage(int)
+{
+    HardwareInfo info;
+    for (int n = 0; n < 32; ++n) {
+        // Property queries need no access rights, so this works unelevated
+        const QString path = QStringLiteral("\\\\.\\PhysicalDrive%1").arg(n);
+        HANDLE disk = CreateFileW(reinterpret_cast<LPCWSTR>(path.utf16()), 0,
+                                  FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                  OPEN_EXISTING, 0, nullptr);
+        if (disk == INVALID_HANDLE_VALUE)
+            continue;                        // numbering can have gaps
+
+        const QByteArray desc = storageProperty(disk, StorageDeviceProperty);
+        if (desc.size() < int(sizeof(STORAGE_DEVICE_DESCRIPTOR))) {
+            CloseHandle(disk);
+            continue;
         }
-        info.gpuDriverVersion = wmi.querySingleString(
-            L"SELECT DriverVersion FROM Win32_VideoController", L"DriverVersion");
-    }
-
-    // CPU Cache from Win32_CacheMemory
-    {
-        // L2 (Purpose = "L2 Cache" or Level = 4)
-        info.cpuL2CacheKb = wmi.querySingleUInt32(
-            L"SELECT MaxCacheSize FROM Win32_CacheMemory WHERE Level = 4", L"MaxCacheSize");
-        // L3 (Level = 5)
-        info.cpuL3CacheKb = wmi.querySingleUInt32(
-            L"SELECT MaxCacheSize FROM Win32_CacheMemory WHERE Level = 5", L"MaxCacheSize");
-        // Some systems report total L2 across cores. Also try Processor class.
-        if (info.cpuL3CacheKb == 0)
-            info.cpuL3CacheKb = wmi.querySingleUInt32(
-                L"SELECT L3CacheSize FROM Win32_Processor", L"L3CacheSize");
-        if (info.cpuL2CacheKb == 0)
-            info.cpuL2CacheKb = wmi.querySingleUInt32(
-                L"SELECT L2CacheSize FROM Win32_Processor", L"L2CacheSize");
-    }
-
-    // Disk interfaces and sizes
-    {
-        info.diskInterfaces = wmi.queryStringList(
-            L"SELECT InterfaceType FROM Win32_DiskDrive", L"InterfaceType");
-        // Disk sizes in GB
-        IEnumWbemClassObject *pEnum = nullptr;
-        // We'll use querySumUInt64 per drive — simplified approach: just get sizes
-        QStringList sizesStr = wmi.queryStringList(
-            L"SELECT Size FROM Win32_DiskDrive", L"Size");
-        for (const QString &s : sizesStr) {
-            quint64 bytes = s.toULongLong();
-            if (bytes > 0)
-                info.diskSizesGb.append(bytes / (1024ULL * 1024ULL * 1024ULL));
+        const auto *device = reinterpret_cast<const STORAGE_DEVICE_DESCRIPTOR *>(desc.constData());
+        const QString iface = busTypeName(device->BusType);
+        if (iface.isEmpty()) {
+            CloseHandle(disk);               // VHDs, storage spaces, virtual disks
+            continue;
         }
-    }
 
-    // ── Lag 3: Firmware / SMBIOS ──
-
-    // BIOS info
-    info.biosVersion = wmi.querySingleString(
-        L"SELECT SMBIOSBIOSVersion FROM Win32_BIOS", L"SMBIOSBIOSVersion");
-    if (info.biosVersion.isEmpty())
-        info.biosVersion = wmi.querySingleString(
-            L"SELECT Version FROM Win32_BIOS", L"Version");
-    info.biosDate = wmi.querySingleString(
-        L"SELECT ReleaseDate FROM Win32_BIOS", L"ReleaseDate");
-    // Format BIOS date: "20231215000000.000000+000" → "2023-12-15"
-    if (info.biosDate.length() >= 8) {
-        info.biosDate = info.biosDate.left(4) + QStringLiteral("-")
-                      + info.biosDate.mid(4, 2) + QStringLiteral("-")
-                      + info.biosDate.mid(6, 2);
-    }
+        const QString vendor  = descriptorString(desc, device->VendorIdOffset);
+        const QString product = descriptorString(desc, device->ProductIdOffset);
+        QString model = product;
+        if (!vendor.isEmpty() && !product.startsWith(vendor, Qt::CaseInsensitive))
+            model = vendor + QLatin1Char(' ') + product;
+        info.storage.append(model.isEmpty() ? path.mid(4) : model);
+        info.diskInterfaces.append(iface);
 
-    // Chassis type (Desktop / Laptop)
-    {
-        quint32 chassisCode = wmi.querySingleUInt32(
-            L"SELECT ChassisTypes FROM Win32_SystemEnclosure", L"ChassisTypes");
-        // ChassisTypes is actually an array; querySingleUInt32 gets first element usually
-        // Fallback: use PCSystemType
-        if (chassisCode == 0) {
-            chassisCode = wmi.querySingleUInt32(
-                L"SELECT PCSystemType FROM Win32_ComputerSystem", L"PCSystemType");
-            // 1=Desktop, 2=Mobile/Laptop, 3=Workstation
-            if (chassisCode == 2) info.chassisType = QStringLiteral("Laptop");
-            else if (chassisCode == 1 || chassisCode == 3) info.chassisType = QStringLiteral("Desktop");
-            else info.chassisType = QStringLiteral("Unknown");
+        if (device->BusType == BusTypeNvme) {
+            info.hasNvme = true;
+            info.hasSsd  = true;
         } else {
-            info.chassisType = classifyChassisType(chassisCode);
+            const QByteArray seek = storageProperty(disk, StorageDeviceSeekPenaltyProperty);
+            if (seek.size() >= int(sizeof(DEVICE_SEEK_PENALTY_DESCRIPTOR)) &&
+                !reinterpret_cast<const DEVICE_SEEK_PENALTY_DESCRIPTOR *>(seek.constData())->IncursSeekPenalty)
+                info.hasSsd = true;
         }
-    }
 
-    // Secure Boot via registry (faster than WMI UEFI namespace)
-    {
-        HKEY hKey;
-        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE,
-                          L"SYSTEM\\CurrentControlSet\\Control\\SecureBoot\\State",
-                          0, KEY_READ, &hKey) == ERROR_SUCCESS) {
-            DWORD val = 0, size = sizeof(val);
-            if (RegQueryValueExW(hKey, L"UEFISecureBootEnabled", nullptr, nullptr,
-                                 reinterpret_cast<LPBYTE>(&val), &size) == ERROR_SUCCESS)
-                info.secureBootEnabled = (val == 1);
-            RegCloseKey(hKey);
-        }
-    }
-
-    // TPM version via Win32_Tpm (requires WMI ROOT\CIMV2\Security\MicrosoftTpm namespace)
-    // This often requires admin privileges. Try it, fallback to "Not detected".
-    {
-        info.tpmVersion = QStringLiteral("Not detected");
-        // Try reading from registry as non-admin fallback
-        HKEY hKey;
-        if (RegOpenKeyExW(HKEY_LOCAL_MACHINE,
-                          L"SYSTEM\\CurrentControlSet\\Services\\TPM\\WMI",
-                          0, KEY_READ, &hKey) == ERROR_SUCCESS) {
-            // If the key exists, TPM is present
-            info.tpmVersion = QStringLiteral("Present");
-            RegCloseKey(hKey);
-        }
-        // For the actual version, try WMI (may fail without admin)
-        // The ManufacturerVersion from ROOT\CIMV2\Security\MicrosoftTpm
-        // is unreachable from user-mode WMI without elevation, so skip.
+        DISK_GEOMETRY_EX geometry = {};
+        DWORD returned = 0;
+        if (DeviceIoControl(disk, IOCTL_DISK_GET_DRIVE_GEOMETRY_EX, nullptr, 0,
+                            &geometry, sizeof(geometry), &returned, nullptr) &&
+            geometry.DiskSize.QuadPart > 0)
+            info.diskSizesGb.append(quint64(geometry.DiskSize.QuadPart) / (1024ULL * 1024ULL * 1024ULL));
+        CloseHandle(disk);
     }
+    return info;
+}
 
-    // Fallbacks for empty values
-    if (info.cpuName.isEmpty()) info.cpuName = QSysInfo::currentCpuArchitecture();
-    if (info.gpuName.isEmpty()) info.gpuName = QStringLiteral("Unknown");
-    if (info.motherboard.isEmpty()) info.motherboard = QStringLiteral("Unknown");
-    if (info.ramType.isEmpty()) info.ramType = QStringLiteral("Unknown");
-    if (info.biosVersion.isEmpty()) info.biosVersion = QStringLiteral("Unknown");
-    if (info.chassisType.isEmpty()) info.chassisType = QStringLiteral("Unknown");
+HardwareInfo HardwareDetector::probeWindowsFirmwareRegistry(int)
+{
+    HardwareInfo info;
 
-    qDebug() << "[HW] Detected:" << info.cpuName << "|" << info.gpuName
-             << "|" << info.gpuVendor << "| RAM" << info.ramMb << "MB"
-             << info.ramType << "@" << info.ramSpeedMhz << "MHz"
-             << "| Cores" << info.cpuCores << "/" << info.cpuThreads
-             << "| VRAM" << info.gpuVramMb << "MB"
-             << "| BIOS" << info.biosVersion
-             << "| Chassis" << info.chassisType;
-#endif
+    // Secure Boot via registry (faster than WMI UEFI namespace)
+    HKEY hKey;
+    if (RegOpenKeyExW(HKEY_LOCAL_MACHINE,
+                      L"SYSTEM\\CurrentControlSet\\Control\\SecureBoot\\State",
+                      0, KEY_READ, &hKey) == ERROR_SUCCESS) {
+        DWORD val = 0, size = sizeof(val);
+        if (RegQueryValueExW(hKey, L"UEFISecureBootEnabled", nullptr, nullptr,
+                             reinterpret_cast<LPBYTE>(&val), &size) == ERROR_SUCCESS)
+            info.secureBootEnabled = (val == 1);
+        RegCloseKey(hKey);
+    }
+
+    // TPM presence. The version lives in ROOT\CIMV2\Security\MicrosoftTpm,
+    // which is unreachable from user-mode WMI without elevation, so skip it.
+    if (RegOpenKeyExW(HKEY_LOCAL_MACHINE,
+                      L"SYSTEM\\CurrentControlSet\\Services\\TPM\\WMI",
+                      0, KEY_READ, &hKey) == ERROR_SUCCESS) {
+        info.tpmVersion = QStringLiteral("Present");
+        RegCloseKey(hKey);
+    }
     return info;
 }
+#endif // Q_OS_WIN
 
 QString HardwareDetector::classifyGpuVendor(const QString &gpuName)
 {
@@ -865,41 +652,3 @@ QString HardwareDetector::classifyGpuVendor(const QString &gpuName)
         return QStringLiteral("Intel");
     return QStringLiteral("Unknown");
 }
-
-QString HardwareDetector::classifyRamType(quint32 smbiosType)
-{
-    // SMBIOS Memory Type codes (from DMTF spec)
-    switch (smbiosType) {
-    case 20: return QStringLiteral("DDR");
-    case 21: return QStringLiteral("DDR2");
-    case 22: // DDR2 FB-DIMM
-             return QStringLiteral("DDR2");
-    case 24: return QStringLiteral("DDR3");
-    case 26: return QStringLiteral("DDR4");
-    case 30: // LPDDR4
-             return QStringLiteral("LPDDR4");
-    case 34: return QStringLiteral("DDR5");
-    case 35: // LPDDR5
-             return QStringLiteral("LPDDR5");
-    default: return QStringLiteral("Unknown");
-    }
-}
-
-QString HardwareDetector::classifyChassisType(quint32 code)
-{
-    // SMBIOS System Enclosure types
-    switch (code) {
-    case 3: case 4: case 5: case 6: case 7: case 15: case 16:
-        return QStringLiteral("Desktop");
-    case 8: case 9: case 10: case 14: case 31:
-        return QStringLiteral("Laptop");
-    case 11: case 12:
-        return QStringLiteral("Handheld");
-    case 17: case 23:
-        return QStringLiteral("Server");
-    case 30:
-        return QStringLiteral("Tablet");
-    default:
-        return QStringLiteral("Unknown");
-    }
-}
@@ -3,6 +3,10 @@
 #include <QString>
 #include <QStringList>
 
+#include <functional>
+
+class QObject;
+
 struct HardwareInfo
 {
     // ── Lag 1: OS-niveau ──
@@ -25,8 +29,16 @@ struct HardwareInfo
     QString gpuDriverVersion;
     quint32 cpuL2CacheKb = 0;
     quint32 cpuL3CacheKb = 0;
+    int cpuPackages = 0;
+    int cpuPerformanceCores = 0; // hybrid parts only; 0 when all cores are alike
+    int cpuEfficiencyCores = 0;
+    int cpuL3Domains = 0;        // L3 caches (CCX/CCD on Ryzen) across all packages
     QStringList diskInterfaces;  // "NVMe", "SATA", "SCSI" per drive
     QList<quint64> diskSizesGb;  // size per drive in GB
+    int ramChannels = 0;         // populated memory channels, 0 if unknown
+    int ramRanks = 0;            // ranks per module, 0 if unknown
+    int ramSlots = 0;            // DIMM slots on the board
+    QList<quint32> ramModulesMb; // capacity per populated module
 
     // ── Lag 3: Firmware / SMBIOS ──
     QString biosVersion;
@@ -36,16 +48,56 @@ struct HardwareInfo
     QString chassisType;     // "Desktop" | "Laptop" | "Unknown"
 };
 
+/// One independent piece of hardware detection. run() returns a partial
+/// HardwareInfo holding only the fields this probe owns; partials are
+/// combined with HardwareDetector::merge(). Probes run concurrently, so
+/// run() must not touch shared state. timeoutMs is passed to run() so
+/// subprocess waits stay inside the probe's deadline.
+struct HardwareProbe
+{
+    const char *name;
+    int timeoutMs;            // result is dropped if it arrives later than this
+    HardwareInfo (*run)(int timeoutMs);
+};
+
 class HardwareDetector
 {
 public:
     HardwareDetector() = default;
-    HardwareInfo detect() const;
+
+    /// Non-blocking detection. onProbe(partial, probeName) is called on
+    /// context's thread as each probe finishes in time; onFinished() is
+    /// called once, after the last probe or when the deadline expires.
+    void detectAsync(QObject *context,
+                     std::function<void(const HardwareInfo &, const QString &)> onProbe,
+                     std::function<void()> onFinished) const;
+
+    /// Probes for the current platform.
+    static QList<HardwareProbe> probes();
+
+    /// Copy every field that is set in partial (non-empty / non-zero) into into.
+    static void merge(HardwareInfo &into, const HardwareInfo &partial);
+
+    /// Fill "Unknown"-style fallbacks for anything no probe reported.
+    static void finalize(HardwareInfo &info);
 
 private:
-    HardwareInfo detectWindows() const;
-    HardwareInfo detectLinux() const;
+#ifdef Q_OS_WIN
+    static HardwareInfo probeWindowsCpu(int timeoutMs);
+    static HardwareInfo probeWindowsMemory(int timeoutMs);
+    static HardwareInfo probeWindowsGpu(int timeoutMs);
+    static HardwareInfo probeWindowsSmbios(int timeoutMs);
+    static HardwareInfo probeWindowsStorage(int timeoutMs);
+    static HardwareInfo probeWindowsFirmwareRegistry(int timeoutMs);
+#else
+    static HardwareInfo probeLinuxCpu(int timeoutMs);
+    static HardwareInfo probeLinuxMemory(int timeoutMs);
+    static HardwareInfo probeLinuxGpu(int timeoutMs);
+    static HardwareInfo probeLinuxDmi(int timeoutMs);
+    static HardwareInfo probeLinuxStorage(int timeoutMs);
+    static HardwareInfo probeLinuxCpuCache(int timeoutMs);
+    static HardwareInfo probeLinuxSecureBoot(int timeoutMs);
+    static HardwareInfo probeLinuxTpm(int timeoutMs);
+#endif
     static QString classifyGpuVendor(const QString &gpuName);
-    static QString classifyRamType(quint32 smbiosMemoryType);
-    static QString classifyChassisType(quint32 chassisTypeCode);
 };
@@ -1,4 +1,7 @@
 #include "app/HardwareScorer.h"
+#include "app/HardwareDb.h"
+#include "app/PatternAutomaton.h"
+
 #include <algorithm>
 
 HardwareScorer::HardwareScorer(QObject *parent)
@@ -11,7 +14,7 @@ HardwareScorer::HardwareScorer(QObject *parent)
 struct GpuEntry { const char *keyword; int score; };
 struct CpuEntry { const char *keyword; int score; };
 
-static const GpuEntry gpuDb[] = {
+constexpr GpuEntry gpuDb[] = {
     // NVIDIA — high end
     {"RTX 4090", 98}, {"RTX 4080", 94}, {"RTX 4070 Ti Super", 90},
     {"RTX 4070 Ti", 88}, {"RTX 4070 Super", 86}, {"RTX 4070", 83},
@@ -42,7 +45,7 @@ static const GpuEntry gpuDb[] = {
     {"Radeon 780M", 28}, {"Radeon 760M", 24}, {"Radeon 680M", 22},
 };
 
-static const CpuEntry cpuDb[] = {
+constexpr CpuEntry cpuDb[] = {
     // Intel — 14th gen
     {"14900K", 97}, {"14700K", 92}, {"14600K", 86}, {"14400F", 78},
     {"14100F", 62},
@@ -67,14 +70,34 @@ static const CpuEntry cpuDb[] = {
     {"3600", 62}, {"3500X", 55}, {"3300X", 52}, {"3100", 48},
 };
 
+// Built-in fallback for when the hardware DB (HardwareDb) is missing or does
+// not know the model. Both tables are compiled into longest-match automata
+// at build time.
+static_assert(PatternMatch::validKeywords(gpuDb), "gpuDb keywords: letters, digits and spaces only");
+static_assert(PatternMatch::validKeywords(cpuDb), "cpuDb keywords: letters, digits and spaces only");
+
+static constexpr auto gpuMatcher =
+    PatternMatch::Automaton<PatternMatch::stateBound(gpuDb)>::build(gpuDb);
+static constexpr auto cpuMatcher =
+    PatternMatch::Automaton<PatternMatch::stateBound(cpuDb)>::build(cpuDb);
+
 // ─── Public ────────────────────────────────────────────────────────────
 
 void HardwareScorer::score(const HardwareInfo &hw)
 {
-    m_cpuScore     = scoreCpu(hw);
-    m_gpuScore     = scoreGpu(hw);
-    m_ramScore     = scoreRam(hw);
-    m_storageScore = scoreStorage(hw);
+    m_estCpu     = scoreCpu(hw);
+    m_estGpu     = scoreGpu(hw);
+    m_estRam     = scoreRam(hw);
+    m_estStorage = scoreStorage(hw);
+
+    // Measured memory speed is half of the RAM score; capacity is the other half.
+    MeasuredScore ram = m_calibration.memory;
+    ram.score = (m_estRam + ram.score) / 2;
+
+    m_cpuScore     = ScoreCalibration::blend(m_estCpu, m_calibration.cpu);
+    m_gpuScore     = m_estGpu;
+    m_ramScore     = ScoreCalibration::blend(m_estRam, ram);
+    m_storageScore = ScoreCalibration::blend(m_estStorage, m_calibration.storage);
 
     m_gamingScore      = static_cast<int>(m_gpuScore * 0.45 + m_cpuScore * 0.35
                                         + m_ramScore * 0.10 + m_storageScore * 0.10);
@@ -88,20 +111,40 @@ void HardwareScorer::score(const HardwareInfo &hw)
     emit scored();
 }
 
+QVariantMap HardwareScorer::calibration() const
+{
+    auto component = [](int estimated, const MeasuredScore &measured, int final) {
+        QVariantMap m;
+        m["estimated"]  = estimated;
+        m["measured"]   = measured.isValid() ? QVariant(measured.score) : QVariant();
+        m["confidence"] = measured.confidence;
+        m["score"]      = final;
+        return m;
+    };
+
+    QVariantMap map;
+    map["samples"] = m_calibration.samples;
+    map["cpu"]     = component(m_estCpu, m_calibration.cpu, m_cpuScore);
+    map["gpu"]     = component(m_estGpu, MeasuredScore(), m_gpuScore);
+    map["ram"]     = component(m_estRam, m_calibration.memory, m_ramScore);
+    map["storage"] = component(m_estStorage, m_calibration.storage, m_storageScore);
+    return map;
+}
+
 // ─── Private scoring ───────────────────────────────────────────────────
 
 int HardwareScorer::scoreCpu(const HardwareInfo &hw) const
 {
-    const QString name = hw.cpuName.toUpper();
-    int best = 0;
-    for (const auto &e : cpuDb) {
-        if (name.contains(QString::fromLatin1(e.keyword).toUpper())) {
-            best = std::max(best, e.score);
-        }
-    }
+    const HwDbEntry *entry = HardwareDb::instance().findCpu(hw.cpuName);
+    int best = entry ? entry->score
+                     : cpuMatcher.find(hw.cpuName.utf16(), size_t(hw.cpuName.size())).score;
     if (best == 0) {
-        // Heuristic fallback based on core/thread count + clock
-        int base = std::min(hw.cpuCores * 5, 60);
+        // Heuristic fallback based on core/thread count + clock;
+        // an E-core is worth roughly half a P-core in games
+        const int effectiveCores = hw.cpuEfficiencyCores > 0
+                                 ? hw.cpuPerformanceCores + hw.cpuEfficiencyCores / 2
+                                 : hw.cpuCores;
+        int base = std::min(effectiveCores * 5, 60);
         if (hw.cpuMaxClockMhz > 4500) base += 20;
         else if (hw.cpuMaxClockMhz > 3500) base += 10;
         if (hw.cpuThreads > hw.cpuCores) base += 10; // has HT/SMT
@@ -112,13 +155,9 @@ int HardwareScorer::scoreCpu(const HardwareInfo &hw) const
 
 int HardwareScorer::scoreGpu(const HardwareInfo &hw) const
 {
-    const QString name = hw.gpuName.toUpper();
-    int best = 0;
-    for (const auto &e : gpuDb) {
-        if (name.contains(QString::fromLatin1(e.keyword).toUpper())) {
-            best = std::max(best, e.score);
-        }
-    }
+    const HwDbEntry *entry = HardwareDb::instance().findGpu(hw.gpuName);
+    int best = entry ? entry->score
+                     : gpuMatcher.find(hw.gpuName.utf16(), size_t(hw.gpuName.size())).score;
     if (best == 0) {
         // Fallback: integrated ≈ 10, unknown discrete ≈ 40
         if (hw.gpuVendor == "Intel" || hw.gpuName.contains("Vega", Qt::CaseInsensitive)
@@ -135,13 +174,29 @@ int HardwareScorer::scoreGpu(const HardwareInfo &hw) const
 int HardwareScorer::scoreRam(const HardwareInfo &hw) const
 {
     const double gb = hw.ramMb / 1024.0;
-    if (gb >= 64) return 95;
-    if (gb >= 32) return 85;
-    if (gb >= 16) return 70;
-    if (gb >= 12) return 55;
-    if (gb >= 8)  return 40;
-    if (gb >= 4)  return 20;
-    return 10;
+    int score = 10;
+    if (gb >= 64)      score = 95;
+    else if (gb >= 32) score = 85;
+    else if (gb >= 16) score = 70;
+    else if (gb >= 12) score = 55;
+    else if (gb >= 8)  score = 40;
+    else if (gb >= 4)  score = 20;
+
+    // Layout from SMBIOS, where available. A single channel halves the
+    // bandwidth, which CPU-bound games feel more than a missing 16 GB.
+    if (hw.ramChannels == 1)
+        score -= 15;
+    if (hw.ramRanks >= 2)
+        score += 2;   // rank interleaving
+
+    // Speed relative to what the generation typically runs at
+    const quint32 typical = hw.ramType == QLatin1String("DDR5") ? 5600
+                          : hw.ramType == QLatin1String("DDR4") ? 3200
+                          : hw.ramType == QLatin1String("DDR3") ? 1600 : 0;
+    if (typical > 0 && hw.ramSpeedMhz > 0)
+        score += std::clamp((int(hw.ramSpeedMhz) - int(typical)) / 400 * 3, -9, 6);
+
+    return std::clamp(score, 5, 100);
 }
 
 int HardwareScorer::scoreStorage(const HardwareInfo &hw) const
@@ -198,6 +253,12 @@ QVariantList HardwareScorer::generateInsights(const HardwareInfo &hw) const
     else
         addInsight("🔴", "CPU Weak", "Your processor may cause significant frame drops in demanding games.", "critical");
 
+    // CPU layout: what the scheduler has to get right
+    if (hw.cpuPackages <= 1 && hw.cpuL3Domains > 1)
+        addInsight("🟡", "Multiple CCDs", QString::number(hw.cpuL3Domains) + " L3 domains — games run best kept on one. Leave core parking and Game Mode on so Windows can do that.", "warning");
+    if (hw.cpuEfficiencyCores > 0)
+        addInsight("🟢", "Hybrid CPU", QString::number(hw.cpuPerformanceCores) + " performance + " + QString::number(hw.cpuEfficiencyCores) + " efficiency cores — keep Windows 11 and chipset drivers current so games land on P-cores.", "good");
+
     // GPU insights
     if (m_gpuScore >= 80)
         addInsight("🟢", "GPU Powerful", "Your graphics card can handle high/ultra settings in most games.", "good");
@@ -216,6 +277,8 @@ QVariantList HardwareScorer::generateInsights(const HardwareInfo &hw) const
         addInsight("🟡", "RAM Tight", QString::number(gb, 'f', 0) + " GB — close background apps while gaming for best performance.", "warning");
     else
         addInsight("🔴", "RAM Low", QString::number(gb, 'f', 0) + " GB — strongly consider upgrading to 16 GB.", "critical");
+    if (hw.ramChannels == 1 && hw.ramSlots > 1)
+        addInsight("🟡", "Single-Channel Memory", "Only one memory channel is populated. A second matching module doubles memory bandwidth and lifts 1% lows.", "warning");
 
     // Storage
     if (hw.hasNvme)
@@ -6,9 +6,14 @@
 #include <QVariantMap>
 
 #include "app/HardwareDetector.h"
+#include "app/ScoreCalibration.h"
 
 /// Hardware scoring system — computes Gaming Score, Performance Score,
 /// identifies bottlenecks, and classifies system tier.
+///
+/// Component scores start as name-based estimates; with a calibration model
+/// (setCalibration) the CPU, RAM and storage scores are blended with what
+/// the benchmarks actually measured on this machine.
 class HardwareScorer : public QObject
 {
     Q_OBJECT
@@ -22,12 +27,17 @@ class HardwareScorer : public QObject
     Q_PROPERTY(QString tier          READ tier              NOTIFY scored)
     Q_PROPERTY(QString bottleneck    READ bottleneck        NOTIFY scored)
     Q_PROPERTY(QVariantList insights READ insights          NOTIFY scored)
+    Q_PROPERTY(bool calibrated       READ calibrated        NOTIFY scored)
+    Q_PROPERTY(QVariantMap calibration READ calibration     NOTIFY scored)
 
 public:
     explicit HardwareScorer(QObject *parent = nullptr);
 
     void score(const HardwareInfo &hw);
 
+    /// Use measured scores from now on; call score() again to apply.
+    void setCalibration(const CalibrationModel &model) { m_calibration = model; }
+
     int gamingScore() const       { return m_gamingScore; }
     int performanceScore() const  { return m_performanceScore; }
     int cpuScore() const          { return m_cpuScore; }
@@ -37,6 +47,10 @@ public:
     QString tier() const          { return m_tier; }
     QString bottleneck() const    { return m_bottleneck; }
     QVariantList insights() const { return m_insights; }
+    bool calibrated() const       { return m_calibration.isValid(); }
+
+    /// Per component: estimated, measured, confidence and final score.
+    QVariantMap calibration() const;
 
 signals:
     void scored();
@@ -59,4 +73,10 @@ private:
     QString m_tier;
     QString m_bottleneck;
     QVariantList m_insights;
+
+    CalibrationModel m_calibration;
+    int m_estCpu = 0;
+    int m_estGpu = 0;
+    int m_estRam = 0;
+    int m_estStorage = 0;
 };
@@ -0,0 +1,245 @@
+#include "app/LatencyProbe.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QHash>
+#include <QHostAddress>
+#include <QNetworkDatagram>
+#include <QTcpSocket>
+#include <QTimer>
+#include <QUdpSocket>
+
+#include <algorithm>
+#include <cmath>
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+namespace {
+
+constexpr quint32 kUdpMagic = 0x544C5031;   // "TLP1", first word of every echo payload
+
+double round2(double v) { return std::round(v * 100.0) / 100.0; }
+
+} // anonymous namespace
+
+struct LatencyProbe::TargetState
+{
+    Target              target;
+    Stats               stats;
+    int                 nextSeq = 0;
+    QHash<int, qint64>  sentAtNs;     // seq → m_clock time, removed once answered or lost
+    QTimer             *sendTimer = nullptr;
+    QUdpSocket         *udp = nullptr;
+};
+
+QVariantMap LatencyProbe::Stats::toMap() const
+{
+    QVariantMap m;
+    m["name"]     = name;
+    m["host"]     = host;
+    m["sent"]     = sent;
+    m["received"] = received;
+    m["lossPct"]  = round2(lossPct());
+    m["minMs"]    = round2(minMs);
+    m["medianMs"] = round2(medianMs);
+    m["p95Ms"]    = round2(p95Ms);
+    m["maxMs"]    = round2(maxMs);
+    m["jitterMs"] = round2(jitterMs);
+    return m;
+}
+
+// ---------------------------------------------------------------------------
+// LatencyProbe
+// ---------------------------------------------------------------------------
+LatencyProbe::LatencyProbe(QObject *parent)
+    : QObject(parent)
+{
+}
+
+QList<LatencyProbe::Target> LatencyProbe::defaultTargets()
+{
+    return {
+        { QStringLiteral("Cloudflare"), QStringLiteral("1.1.1.1"),        443, Protocol::TcpConnect },
+        { QStringLiteral("Google"),     QStringLiteral("8.8.8.8"),        443, Protocol::TcpConnect },
+        { QStringLiteral("Quad9"),      QStringLiteral("9.9.9.9"),        443, Protocol::TcpConnect },
+        { QStringLiteral("OpenDNS"),    QStringLiteral("208.67.222.222"), 443, Protocol::TcpConnect },
+    };
+}
+
+void LatencyProbe::start(const QList<Target> &targets, const Options &options)
+{
+    cancel();
+    if (targets.isEmpty()) {
+        emit finished();
+        return;
+    }
+
+    m_options = options;
+    m_options.probesPerTarget = std::max(1, m_options.probesPerTarget);
+    m_run = new QObject(this);
+    m_running = true;
+    m_pending = int(targets.size()) * m_options.probesPerTarget;
+    m_clock.start();
+
+    for (const Target &target : targets) {
+        auto t = std::make_shared<TargetState>();
+        t->target = target;
+        t->stats.name = target.name.isEmpty() ? target.host : target.name;
+        t->stats.host = target.host;
+        m_targets.append(t);
+
+        if (target.protocol == Protocol::UdpEcho) {
+            t->udp = new QUdpSocket(m_run);
+            t->udp->bind(QHostAddress(QHostAddress::AnyIPv4), 0);
+            connect(t->udp, &QUdpSocket::readyRead, m_run, [this, t]() {
+                while (t->udp->hasPendingDatagrams()) {
+                    const QByteArray data = t->udp->receiveDatagram().data();
+                    QDataStream in(data);
+                    quint32 magic = 0;
+                    qint32 seq = -1;
+                    in >> magic >> seq;
+                    const auto sent = t->sentAtNs.constFind(seq);
+                    if (magic != kUdpMagic || sent == t->sentAtNs.constEnd())
+                        continue;   // stray, duplicate or already timed out
+                    complete(t, seq, (m_clock.nsecsElapsed() - *sent) / 1e6);
+                }
+            });
+        }
+
+        // All targets start at once; probes to one target are spaced out
+        t->sendTimer = new QTimer(m_run);
+        t->sendTimer->setInterval(m_options.intervalMs);
+        connect(t->sendTimer, &QTimer::timeout, m_run, [this, t]() { sendProbe(t); });
+        sendProbe(t);
+        if (t->nextSeq < m_options.probesPerTarget)
+            t->sendTimer->start();
+    }
+}
+
+void LatencyProbe::cancel()
+{
+    if (m_run)
+        m_run->deleteLater();   // closes sockets, stops timers, drops pending callbacks
+    m_run = nullptr;
+    m_targets.clear();
+    m_pending = 0;
+    m_running = false;
+}
+
+void LatencyProbe::sendProbe(const std::shared_ptr<TargetState> &t)
+{
+    if (!m_targets.contains(t))
+        return;   // from a cancelled run
+    if (t->nextSeq >= m_options.probesPerTarget) {
+        t->sendTimer->stop();
+        return;
+    }
+    const int seq = t->nextSeq++;
+    t->stats.sent++;
+    t->sentAtNs.insert(seq, m_clock.nsecsElapsed());
+
+    if (t->target.protocol == Protocol::UdpEcho)
+        sendUdpProbe(t, seq);
+    else
+        sendTcpProbe(t, seq);
+
+    if (t->nextSeq >= m_options.probesPerTarget)
+        t->sendTimer->stop();
+}
+
+void LatencyProbe::sendTcpProbe(const std::shared_ptr<TargetState> &t, int seq)
+{
+    auto *socket = new QTcpSocket(m_run);
+    auto answered = [this, t, seq, socket]() {
+        const auto sent = t->sentAtNs.constFind(seq);
+        if (sent != t->sentAtNs.constEnd())
+            complete(t, seq, (m_clock.nsecsElapsed() - *sent) / 1e6);
+        socket->abort();
+        socket->deleteLater();
+    };
+
+    connect(socket, &QTcpSocket::connected, socket, answered);
+    connect(socket, &QTcpSocket::errorOccurred, socket, [this, t, seq, socket, answered](QAbstractSocket::SocketError error) {
+        // A refusal (RST) is still a round trip to the host
+        if (error == QAbstractSocket::ConnectionRefusedError) {
+            answered();
+            return;
+        }
+        if (t->sentAtNs.contains(seq))
+            complete(t, seq, -1);
+        socket->deleteLater();
+    });
+    QTimer::singleShot(m_options.timeoutMs, socket, [this, t, seq, socket]() {
+        if (t->sentAtNs.contains(seq))
+            complete(t, seq, -1);
+        socket->abort();
+        socket->deleteLater();
+    });
+
+    socket->connectToHost(t->target.host, t->target.port);
+}
+
+void LatencyProbe::sendUdpProbe(const std::shared_ptr<TargetState> &t, int seq)
+{
+    QByteArray payload;
+    QDataStream out(&payload, QIODevice::WriteOnly);
+    out << kUdpMagic << qint32(seq);
+    t->udp->writeDatagram(payload, QHostAddress(t->target.host), t->target.port);
+
+    QTimer::singleShot(m_options.timeoutMs, m_run, [this, t, seq]() {
+        if (t->sentAtNs.contains(seq))
+            complete(t, seq, -1);
+    });
+}
+
+void LatencyProbe::complete(const std::shared_ptr<TargetState> &t, int seq, double rttMs)
+{
+    if (!m_targets.contains(t) || !t->sentAtNs.remove(seq))
+        return;   // cancelled run, or already answered / timed out
+
+    Stats &s = t->stats;
+    if (rttMs >= 0) {
+        if (!s.rttMs.isEmpty())
+            s.jitterMs += (std::abs(rttMs - s.rttMs.last()) - s.jitterMs) / s.rttMs.size();
+        s.rttMs.append(rttMs);
+        s.received++;
+
+        QList<double> sorted = s.rttMs;
+        std::sort(sorted.begin(), sorted.end());
+        const int n = int(sorted.size());
+        s.minMs    = sorted.first();
+        s.maxMs    = sorted.last();
+        s.medianMs = n % 2 ? sorted.at(n / 2) : (sorted.at(n / 2 - 1) + sorted.at(n / 2)) / 2.0;
+        s.p95Ms    = sorted.at(std::min(n - 1, int(std::ceil(0.95 * n)) - 1));
+    }
+
+    emit probeFinished(s.name, seq, rttMs);
+    emit targetUpdated(s.toMap());
+
+    if (--m_pending == 0) {
+        m_running = false;
+        qDebug() << "[NET] Latency probe done in" << m_clock.elapsed() << "ms, median" << medianRttMs() << "ms";
+        emit finished();
+    }
+}
+
+QList<LatencyProbe::Stats> LatencyProbe::results() const
+{
+    QList<Stats> list;
+    for (const auto &t : m_targets)
+        list.append(t->stats);
+    return list;
+}
+
+double LatencyProbe::medianRttMs() const
+{
+    QList<double> medians;
+    for (const auto &t : m_targets)
+        if (t->stats.received > 0)
+            medians.append(t->stats.medianMs);
+    if (medians.isEmpty())
+        return -1;
+    std::sort(medians.begin(), medians.end());
+    return medians.at(medians.size() / 2);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QVariantMap>
+
+#include <memory>
+
+/// In-process network latency measurement. Probes every target at once —
+/// TCP connect time (a refused connection still answers, so any reachable
+/// host works) or UDP echo round trips — and keeps per-target RTT
+/// distributions with jitter and loss. Each reply is reported as it
+/// arrives. Targets are plain host:port pairs, so a local echo server can
+/// stand in for the internet.
+class LatencyProbe : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Protocol { TcpConnect, UdpEcho };
+
+    struct Target {
+        QString  name;
+        QString  host;                // UDP needs an IP address; TCP also takes names
+        quint16  port = 443;
+        Protocol protocol = Protocol::TcpConnect;
+    };
+
+    struct Options {
+        int probesPerTarget = 5;
+        int intervalMs      = 200;    // between probes to the same target
+        int timeoutMs       = 1000;   // per probe
+    };
+
+    struct Stats {
+        QString name;
+        QString host;
+        int     sent     = 0;
+        int     received = 0;
+        double  minMs    = 0;
+        double  medianMs = 0;
+        double  p95Ms    = 0;
+        double  maxMs    = 0;
+        double  jitterMs = 0;         // mean change between consecutive replies
+        QList<double> rttMs;          // in arrival order
+
+        double lossPct() const { return sent ? 100.0 * (sent - received) / sent : 0.0; }
+        QVariantMap toMap() const;
+    };
+
+    explicit LatencyProbe(QObject *parent = nullptr);
+
+    /// Public anycast resolvers on 443/TCP.
+    static QList<Target> defaultTargets();
+
+    /// Probe targets concurrently. Cancels a run still in progress.
+    void start(const QList<Target> &targets, const Options &options);
+    void cancel();
+
+    bool running() const { return m_running; }
+    QList<Stats> results() const;
+
+    /// Median of the per-target medians of reachable targets, -1 if none answered.
+    double medianRttMs() const;
+
+signals:
+    /// One probe finished; rttMs < 0 means it was lost.
+    void probeFinished(const QString &target, int seq, double rttMs);
+    /// Running statistics of a target after each of its probes.
+    void targetUpdated(const QVariantMap &stats);
+    void finished();
+
+private:
+    struct TargetState;
+
+    void sendProbe(const std::shared_ptr<TargetState> &t);
+    void sendTcpProbe(const std::shared_ptr<TargetState> &t, int seq);
+    void sendUdpProbe(const std::shared_ptr<TargetState> &t, int seq);
+    void complete(const std::shared_ptr<TargetState> &t, int seq, double rttMs);
+
+    QList<std::shared_ptr<TargetState>> m_targets;
+    QPointer<QObject> m_run;          // parent of this run's sockets and timers
+    QElapsedTimer     m_clock;
+    Options           m_options;
+    int               m_pending = 0;  // probes not yet answered or timed out
+    bool              m_running = false;
+};
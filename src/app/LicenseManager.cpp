@@ -1,4 +1,5 @@
 #include "app/LicenseManager.h"
+#include "app/MachineIdentity.h"
 
 #include <QCryptographicHash>
 #include <QJsonDocument>
@@ -6,16 +7,24 @@
 #include <QJsonArray>
 #include <QNetworkRequest>
 #include <QNetworkReply>
-#include <QSysInfo>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
 #include <QDateTime>
 #include <QRandomGenerator>
+#include <QMessageAuthenticationCode>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QDebug>
+#include <QTimer>
+
+#include <memory>
 
 // ── Default config (override via setRepo) ──
 static const char *kDefaultOwner = "pedziito";
 static const char *kDefaultRepo  = "tweak-licenses";
-static const char *kLicenseFile  = "licenses.enc";
+static const char *kDefaultApi   = "https://api.github.com";
+static const char *kTokenFile    = "license.token";
 
 // Access token (XOR-encoded at compile time, decoded at runtime)
 static const unsigned char kTokenEnc[] = {
@@ -43,6 +52,8 @@ static const unsigned char kXorKey[32] = {
 
 LicenseManager::LicenseManager(QObject *parent)
     : QObject(parent)
+    , m_apiBase(qEnvironmentVariableIsEmpty("TWEAK_LICENSE_API")
+                    ? QLatin1String(kDefaultApi) : qEnvironmentVariable("TWEAK_LICENSE_API"))
     , m_owner(QLatin1String(kDefaultOwner))
     , m_repo(QLatin1String(kDefaultRepo))
     , m_token(decodeToken())
@@ -57,37 +68,33 @@ void LicenseManager::setRepo(const QString &owner, const QString &repo, const QS
     m_token = token;
 }
 
+void LicenseManager::setApiBase(const QString &url)
+{
+    m_apiBase = url;
+}
+
+QString LicenseManager::contentsUrl(const QString &path) const
+{
+    QString base = m_apiBase;
+    while (base.endsWith(QLatin1Char('/')))
+        base.chop(1);
+    return QStringLiteral("%1/repos/%2/%3/contents/%4").arg(base, m_owner, m_repo, path);
+}
+
 // ── HWID ──
 
 QString LicenseManager::hwid() const
 {
-    if (!m_cachedHwid.isEmpty())
-        return m_cachedHwid;
-    m_cachedHwid = generateHwid();
-    return m_cachedHwid;
+    return MachineIdentity::instance().hwid();
 }
 
-QString LicenseManager::generateHwid() const
+bool LicenseManager::identityReady(const std::function<void()> &retry)
 {
-    // Collect hardware identifiers
-    QStringList parts;
-    parts << QSysInfo::machineUniqueId();
-    parts << QSysInfo::prettyProductName();
-    parts << QSysInfo::currentCpuArchitecture();
-
-#ifdef Q_OS_WIN
-    // On Windows, also use the machine GUID from registry
-    // (already handled by QSysInfo::machineUniqueId on most Qt builds)
-#else
-    // On Linux, read /etc/machine-id as fallback
-    QFile mid(QStringLiteral("/etc/machine-id"));
-    if (mid.open(QIODevice::ReadOnly))
-        parts << QString::fromUtf8(mid.readAll().trimmed());
-#endif
-
-    QByteArray combined = parts.join(QStringLiteral("|")).toUtf8();
-    QByteArray hash = QCryptographicHash::hash(combined, QCryptographicHash::Sha256);
-    return QString::fromLatin1(hash.toHex()).left(32).toUpper();
+    MachineIdentity &identity = MachineIdentity::instance();
+    if (identity.isReady())
+        return true;
+    identity.whenReady(this, retry);
+    return false;
 }
 
 // ── Encryption ──
@@ -108,14 +115,163 @@ QByteArray LicenseManager::decrypt(const QByteArray &data) const
     return raw;
 }
 
-// ── GitHub API helpers ──
+// ── Signed local token ──
+//
+// "<payload>.<signature>", both base64url. The HMAC key is derived from
+// the at-rest key and this machine's HWID, so a token copied to another
+// machine, or edited, fails verification and is ignored.
+
+QString LicenseManager::tokenPath() const
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + QLatin1Char('/') + QLatin1String(kTokenFile);
+}
+
+QByteArray LicenseManager::tokenSignature(const QByteArray &payload) const
+{
+    const QByteArray key = QCryptographicHash::hash(m_cryptKey + hwid().toLatin1(),
+                                                    QCryptographicHash::Sha256);
+    return QMessageAuthenticationCode::hash(payload, key, QCryptographicHash::Sha256);
+}
+
+LicenseManager::Token LicenseManager::readToken() const
+{
+    Token token;
+    QFile f(tokenPath());
+    if (!f.open(QIODevice::ReadOnly))
+        return token;
+    const QList<QByteArray> parts = f.readAll().trimmed().split('.');
+    if (parts.size() != 2)
+        return token;
+
+    const auto options = QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals;
+    const QByteArray payload   = QByteArray::fromBase64(parts[0], options);
+    const QByteArray signature = QByteArray::fromBase64(parts[1], options);
+    if (signature != tokenSignature(payload))
+        return token;
+
+    const QJsonObject obj = QJsonDocument::fromJson(payload).object();
+    token.username    = obj.value(QStringLiteral("username")).toString();
+    token.passHash    = obj.value(QStringLiteral("password")).toString();
+    token.hwid        = obj.value(QStringLiteral("hwid")).toString();
+    token.validatedAt = qint64(obj.value(QStringLiteral("validated_at")).toDouble());
+    token.valid       = !token.username.isEmpty() && token.validatedAt > 0;
+    return token;
+}
+
+LicenseManager::Token LicenseManager::usableToken(const QString &username) const
+{
+    Token token = readToken();
+    const qint64 age = QDateTime::currentSecsSinceEpoch() - token.validatedAt;
+    const qint64 limit = qint64(kTokenLifetimeDays + kTokenGraceDays) * 86400;
+    // A clock set back past the validation time can't extend a token
+    if (!token.valid || token.hwid != hwid()
+        || token.username.compare(username, Qt::CaseInsensitive) != 0
+        || age < -86400 || age >= limit)
+        token.valid = false;
+    token.fresh = token.valid && age < qint64(kTokenLifetimeDays) * 86400;
+    return token;
+}
+
+void LicenseManager::writeToken(const QString &username, const QString &passHash)
+{
+    QJsonObject obj;
+    obj[QStringLiteral("username")]     = username;
+    obj[QStringLiteral("password")]     = passHash;
+    obj[QStringLiteral("hwid")]         = hwid();
+    obj[QStringLiteral("validated_at")] = double(QDateTime::currentSecsSinceEpoch());
+    const QByteArray payload = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+
+    const auto options = QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals;
+    QDir().mkpath(QFileInfo(tokenPath()).absolutePath());
+    QSaveFile f(tokenPath());
+    if (!f.open(QIODevice::WriteOnly))
+        return;
+    f.write(payload.toBase64(options) + '.' + tokenSignature(payload).toBase64(options));
+    f.commit();
+}
 
-void LicenseManager::fetchLicenses(std::function<void(bool, QJsonArray, QString)> callback)
+void LicenseManager::clearToken()
 {
-    QString url = QStringLiteral("https://api.github.com/repos/%1/%2/contents/%3")
-                      .arg(m_owner, m_repo, QLatin1String(kLicenseFile));
+    QFile::remove(tokenPath());
+}
+
+// ── Storage layout ──
+//
+//   licenses/keys/XX.enc    JSON array of the licenses whose key hashes to XX
+//   licenses/users/XX.enc   JSON object: lower-case username -> license key
+//
+// XX is the first byte of SHA-256(key upper-cased, or username lower-cased)
+// modulo kShardCount, as two hex digits (tools/license_store.py computes
+// the same). A lookup reads one file from each; a write replaces one shard,
+// guarded by the sha it read.
+
+static QString shardName(const QString &id)
+{
+    const QByteArray hash = QCryptographicHash::hash(id.toUtf8(), QCryptographicHash::Sha256);
+    return QStringLiteral("%1").arg(uchar(hash[0]) % LicenseManager::kShardCount, 2, 16, QLatin1Char('0'));
+}
+
+QString LicenseManager::keyShardPath(const QString &key)
+{
+    return QStringLiteral("licenses/keys/%1.enc").arg(shardName(key.toUpper()));
+}
+
+QString LicenseManager::userShardPath(const QString &username)
+{
+    return QStringLiteral("licenses/users/%1.enc").arg(shardName(username.toLower()));
+}
+
+static int findLicense(const QJsonArray &licenses, const QString &key)
+{
+    for (int i = 0; i < licenses.size(); ++i)
+        if (licenses[i].toObject().value(QStringLiteral("key")).toString().compare(key, Qt::CaseInsensitive) == 0)
+            return i;
+    return -1;
+}
+
+// ── HWID rebinding rules ──
 
-    QNetworkRequest req{QUrl(url)};
+namespace {
+
+/// Whether a license bound elsewhere may move to this machine.
+struct RebindCheck
+{
+    int resets = 0;
+    int maxResets = 3;
+    int cooldownDays = 0;           // days until the 30-day cooldown ends
+};
+
+RebindCheck checkRebind(const QJsonObject &lic)
+{
+    RebindCheck c;
+    c.resets    = lic.value(QStringLiteral("hwid_resets")).toInt(0);
+    c.maxResets = lic.value(QStringLiteral("max_resets")).toInt(3);
+    const QString lastChange = lic.value(QStringLiteral("last_hwid_change")).toString();
+    if (!lastChange.isEmpty()) {
+        const QDateTime lastDt = QDateTime::fromString(lastChange, Qt::ISODate);
+        if (lastDt.isValid() && lastDt.daysTo(QDateTime::currentDateTimeUtc()) < 30)
+            c.cooldownDays = 30 - lastDt.daysTo(QDateTime::currentDateTimeUtc());
+    }
+    return c;
+}
+
+void rebind(QJsonObject &lic, const QString &hwid)
+{
+    const QString now = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    lic[QStringLiteral("hwid")] = hwid;
+    lic[QStringLiteral("hwid_resets")] = lic.value(QStringLiteral("hwid_resets")).toInt(0) + 1;
+    lic[QStringLiteral("last_hwid_change")] = now;
+    lic[QStringLiteral("activated_at")] = now;
+}
+
+} // anonymous namespace
+
+// ── GitHub API helpers ──
+
+void LicenseManager::fetchFile(const QString &path, FetchCallback callback)
+{
+    QNetworkRequest req{QUrl(contentsUrl(path))};
     req.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
     req.setRawHeader("Accept", "application/vnd.github.v3+json");
     req.setRawHeader("User-Agent", "Tweak-App");
@@ -125,14 +281,14 @@ void LicenseManager::fetchLicenses(std::function<void(bool, QJsonArray, QString)
         reply->deleteLater();
 
         if (reply->error() == QNetworkReply::ContentNotFoundError) {
-            // File doesn't exist yet — empty database
-            callback(true, QJsonArray(), QString());
+            // Shard doesn't exist yet — nothing stored in it
+            callback(true, QJsonDocument(), QString());
             return;
         }
 
         if (reply->error() != QNetworkReply::NoError) {
-            callback(false, QJsonArray(),
-                     QStringLiteral("Network error: %1").arg(reply->errorString()));
+            qWarning() << "[License] Fetch failed:" << reply->errorString();
+            callback(false, QJsonDocument(), QString());
             return;
         }
 
@@ -143,33 +299,29 @@ void LicenseManager::fetchLicenses(std::function<void(bool, QJsonArray, QString)
             obj.value(QStringLiteral("content")).toString().replace(QStringLiteral("\n"), QString()).toUtf8());
 
         // Decrypt
-        QByteArray decrypted = decrypt(content);
-        QJsonDocument doc = QJsonDocument::fromJson(decrypted);
-
-        if (!doc.isArray()) {
-            callback(false, QJsonArray(), QStringLiteral("Corrupt license database"));
+        QJsonDocument doc = QJsonDocument::fromJson(decrypt(content));
+        if (doc.isNull()) {
+            qWarning() << "[License] Corrupt license shard";
+            callback(false, QJsonDocument(), QString());
             return;
         }
 
-        callback(true, doc.array(), sha);
+        callback(true, doc, sha);
     });
 }
 
-void LicenseManager::saveLicenses(const QJsonArray &licenses, const QString &sha,
-                                   std::function<void(bool)> callback)
+void LicenseManager::saveFile(const QString &path, const QJsonDocument &doc, const QString &sha,
+                              SaveCallback callback)
 {
-    QString url = QStringLiteral("https://api.github.com/repos/%1/%2/contents/%3")
-                      .arg(m_owner, m_repo, QLatin1String(kLicenseFile));
-
-    QByteArray encrypted = encrypt(QJsonDocument(licenses).toJson(QJsonDocument::Compact));
+    QByteArray encrypted = encrypt(doc.toJson(QJsonDocument::Compact));
 
     QJsonObject body;
-    body[QStringLiteral("message")] = QStringLiteral("Update licenses");
+    body[QStringLiteral("message")] = QStringLiteral("Update %1").arg(path);
     body[QStringLiteral("content")] = QString::fromLatin1(encrypted.toBase64());
     if (!sha.isEmpty())
         body[QStringLiteral("sha")] = sha;
 
-    QNetworkRequest req{QUrl(url)};
+    QNetworkRequest req{QUrl(contentsUrl(path))};
     req.setRawHeader("Authorization", QStringLiteral("Bearer %1").arg(m_token).toUtf8());
     req.setRawHeader("Accept", "application/vnd.github.v3+json");
     req.setRawHeader("Content-Type", "application/json");
@@ -178,185 +330,291 @@ void LicenseManager::saveLicenses(const QJsonArray &licenses, const QString &sha
     QNetworkReply *reply = m_net.put(req, QJsonDocument(body).toJson());
     connect(reply, &QNetworkReply::finished, this, [reply, callback]() {
         reply->deleteLater();
-        callback(reply->error() == QNetworkReply::NoError);
+        // 409: the sha is stale; 422: the file appeared since we saw it missing
+        const int status = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+        if (reply->error() == QNetworkReply::NoError)
+            callback(SaveStatus::Saved);
+        else if (status == 409 || status == 422)
+            callback(SaveStatus::Conflict);
+        else
+            callback(SaveStatus::Failed);
     });
 }
 
+void LicenseManager::updateFile(const QString &path, Mutation mutate, VerdictCallback done,
+                                int attempt)
+{
+    fetchFile(path, [this, path, mutate, done, attempt](bool ok, QJsonDocument doc, QString sha) {
+        if (!ok) {
+            done(Verdict::Unreachable, QStringLiteral("Could not connect to license server."));
+            return;
+        }
+
+        const Edit edit = mutate(doc);
+        if (edit.action == Edit::Abort) {
+            done(Verdict::Rejected, edit.message);
+            return;
+        }
+        if (edit.action == Edit::Keep) {
+            done(Verdict::Accepted, edit.message);
+            return;
+        }
+
+        saveFile(path, doc, sha, [this, path, mutate, done, attempt, edit](SaveStatus status) {
+            if (status == SaveStatus::Saved) {
+                done(Verdict::Accepted, edit.message);
+            } else if (status == SaveStatus::Conflict && attempt < kMaxWriteAttempts) {
+                // Another client wrote the shard since we read it: back off
+                // with jitter, then redo the edit on its current contents
+                const int delayMs = attempt * QRandomGenerator::global()->bounded(50, 150);
+                qDebug() << "[License] Write conflict on" << path << "- retry" << attempt;
+                QTimer::singleShot(delayMs, this, [this, path, mutate, done, attempt]() {
+                    updateFile(path, mutate, done, attempt + 1);
+                });
+            } else {
+                done(Verdict::Unreachable, edit.failure);
+            }
+        });
+    });
+}
+
+void LicenseManager::lookupKey(const QString &username,
+                               std::function<void(bool ok, QString key)> callback)
+{
+    fetchFile(userShardPath(username), [username, callback](bool ok, QJsonDocument doc, QString) {
+        callback(ok, doc.object().value(username.toLower()).toString());
+    });
+}
+
+void LicenseManager::releaseUsername(const QString &username, const QString &key)
+{
+    const QString name = username.toLower();
+    updateFile(userShardPath(username), [name, key](QJsonDocument &doc) -> Edit {
+        QJsonObject index = doc.object();
+        if (index.value(name).toString().compare(key, Qt::CaseInsensitive) != 0)
+            return { Edit::Keep };
+        index.remove(name);
+        doc.setObject(index);
+        return { Edit::Write };
+    }, [](Verdict, const QString &) {});
+}
+
 // ── Public API ──
 
 void LicenseManager::activate(const QString &licenseKey, const QString &username,
                                const QString &password)
 {
-    QString myHwid = hwid();
+    if (!identityReady([this, licenseKey, username, password]() { activate(licenseKey, username, password); }))
+        return;
 
-    fetchLicenses([this, licenseKey, username, password, myHwid]
-                  (bool ok, QJsonArray licenses, QString sha) {
+    const QString myHwid = hwid();
+    const QString passHash = QString::fromLatin1(
+        QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex());
+    const QString shard = keyShardPath(licenseKey);
+
+    // The key's shard decides the path: a rebind leaves the username index alone
+    fetchFile(shard, [this, licenseKey, username, passHash, myHwid, shard]
+                     (bool ok, QJsonDocument doc, QString) {
         if (!ok) {
             emit activateResult(false, QStringLiteral("Could not connect to license server."));
             return;
         }
 
-        // Find the license key
-        int foundIdx = -1;
-        for (int i = 0; i < licenses.size(); ++i) {
-            QJsonObject lic = licenses[i].toObject();
-            if (lic.value(QStringLiteral("key")).toString().compare(licenseKey, Qt::CaseInsensitive) == 0) {
-                foundIdx = i;
-                break;
-            }
-        }
-
-        if (foundIdx < 0) {
+        const QJsonArray licenses = doc.array();
+        const int found = findLicense(licenses, licenseKey);
+        if (found < 0) {
             emit activateResult(false, QStringLiteral("Invalid license key."));
             return;
         }
 
-        QJsonObject lic = licenses[foundIdx].toObject();
-
-        // Check if already activated with different HWID
-        QString existingHwid = lic.value(QStringLiteral("hwid")).toString();
+        // Already activated with a different HWID: self-rebind if allowed
+        const QString existingHwid = licenses[found].toObject().value(QStringLiteral("hwid")).toString();
         if (!existingHwid.isEmpty() && existingHwid != myHwid) {
-            // Check if self-rebind is allowed
-            int resets = lic.value(QStringLiteral("hwid_resets")).toInt(0);
-            int maxResets = lic.value(QStringLiteral("max_resets")).toInt(3);
-            if (resets >= maxResets) {
-                emit activateResult(false, QStringLiteral("This license has used all %1 HWID changes. Contact admin.").arg(maxResets));
-                return;
-            }
-            // Check 30-day cooldown
-            QString lastChange = lic.value(QStringLiteral("last_hwid_change")).toString();
-            if (!lastChange.isEmpty()) {
-                QDateTime lastDt = QDateTime::fromString(lastChange, Qt::ISODate);
-                if (lastDt.isValid() && lastDt.daysTo(QDateTime::currentDateTimeUtc()) < 30) {
-                    int daysLeft = 30 - lastDt.daysTo(QDateTime::currentDateTimeUtc());
-                    emit activateResult(false, QStringLiteral("HWID change cooldown: %1 day(s) remaining.").arg(daysLeft));
-                    return;
-                }
-            }
-            // Self-rebind allowed
-            lic[QStringLiteral("hwid")] = myHwid;
-            lic[QStringLiteral("hwid_resets")] = resets + 1;
-            lic[QStringLiteral("last_hwid_change")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
-            lic[QStringLiteral("activated_at")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
-            licenses[foundIdx] = lic;
-
-            saveLicenses(licenses, sha, [this, resets, maxResets](bool saved) {
-                if (saved)
-                    emit activateResult(true, QStringLiteral("HWID re-bound (%1/%2 changes used).").arg(resets + 1).arg(maxResets));
-                else
-                    emit activateResult(false, QStringLiteral("Failed to save. Try again."));
+            updateFile(shard, [licenseKey, myHwid](QJsonDocument &doc) -> Edit {
+                QJsonArray licenses = doc.array();
+                const int i = findLicense(licenses, licenseKey);
+                if (i < 0)
+                    return { Edit::Abort, QStringLiteral("Invalid license key.") };
+                QJsonObject lic = licenses[i].toObject();
+                if (lic.value(QStringLiteral("hwid")).toString() == myHwid)
+                    return { Edit::Keep, QStringLiteral("License activated successfully!") };
+                const RebindCheck c = checkRebind(lic);
+                if (c.resets >= c.maxResets)
+                    return { Edit::Abort, QStringLiteral("This license has used all %1 HWID changes. Contact admin.").arg(c.maxResets) };
+                if (c.cooldownDays > 0)
+                    return { Edit::Abort, QStringLiteral("HWID change cooldown: %1 day(s) remaining.").arg(c.cooldownDays) };
+                rebind(lic, myHwid);
+                licenses[i] = lic;
+                doc.setArray(licenses);
+                return { Edit::Write,
+                         QStringLiteral("HWID re-bound (%1/%2 changes used).").arg(c.resets + 1).arg(c.maxResets),
+                         QStringLiteral("Failed to save. Try again.") };
+            }, [this](Verdict verdict, const QString &message) {
+                emit activateResult(verdict == Verdict::Accepted, message);
             });
             return;
         }
 
-        // Check if username already taken
-        for (int i = 0; i < licenses.size(); ++i) {
-            if (i == foundIdx) continue;
-            QJsonObject other = licenses[i].toObject();
-            if (other.value(QStringLiteral("username")).toString().compare(username, Qt::CaseInsensitive) == 0) {
-                emit activateResult(false, QStringLiteral("Username already taken."));
+        // Claim the username in its index shard, then bind the license
+        const QString name = username.toLower();
+        const QString key  = licenses[found].toObject().value(QStringLiteral("key")).toString();
+        updateFile(userShardPath(username), [name, key](QJsonDocument &doc) -> Edit {
+            QJsonObject index = doc.object();
+            const QString owner = index.value(name).toString();
+            if (owner.compare(key, Qt::CaseInsensitive) == 0)
+                return { Edit::Keep };
+            if (!owner.isEmpty())
+                return { Edit::Abort, QStringLiteral("Username already taken.") };
+            index[name] = key;
+            doc.setObject(index);
+            return { Edit::Write, QString(), QStringLiteral("Failed to save activation. Try again.") };
+        }, [this, key, username, passHash, myHwid, shard](Verdict verdict, const QString &message) {
+            if (verdict != Verdict::Accepted) {
+                emit activateResult(false, message);
                 return;
             }
-        }
 
-        // Hash password
-        QByteArray passHash = QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex();
-
-        // Update license record
-        lic[QStringLiteral("hwid")]         = myHwid;
-        lic[QStringLiteral("username")]     = username;
-        lic[QStringLiteral("password")]     = QString::fromLatin1(passHash);
-        lic[QStringLiteral("activated_at")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
-        // Initialize rebind fields if missing
-        if (!lic.contains(QStringLiteral("hwid_resets")))
-            lic[QStringLiteral("hwid_resets")] = 0;
-        if (!lic.contains(QStringLiteral("max_resets")))
-            lic[QStringLiteral("max_resets")] = 3;
-        if (!lic.contains(QStringLiteral("last_hwid_change")))
-            lic[QStringLiteral("last_hwid_change")] = QString();
-
-        licenses[foundIdx] = lic;
-
-        saveLicenses(licenses, sha, [this](bool saved) {
-            if (saved)
-                emit activateResult(true, QStringLiteral("License activated successfully!"));
-            else
-                emit activateResult(false, QStringLiteral("Failed to save activation. Try again."));
+            auto previousUser = std::make_shared<QString>();
+            updateFile(shard, [key, username, passHash, myHwid, previousUser](QJsonDocument &doc) -> Edit {
+                QJsonArray licenses = doc.array();
+                const int i = findLicense(licenses, key);
+                if (i < 0)
+                    return { Edit::Abort, QStringLiteral("Invalid license key.") };
+                QJsonObject lic = licenses[i].toObject();
+                // Another machine may have activated it since the first read
+                const QString boundHwid = lic.value(QStringLiteral("hwid")).toString();
+                if (!boundHwid.isEmpty() && boundHwid != myHwid)
+                    return { Edit::Abort, QStringLiteral("This license was just activated on another machine.") };
+
+                *previousUser = lic.value(QStringLiteral("username")).toString();
+                lic[QStringLiteral("hwid")]         = myHwid;
+                lic[QStringLiteral("username")]     = username;
+                lic[QStringLiteral("password")]     = passHash;
+                lic[QStringLiteral("activated_at")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+                // Initialize rebind fields if missing
+                if (!lic.contains(QStringLiteral("hwid_resets")))
+                    lic[QStringLiteral("hwid_resets")] = 0;
+                if (!lic.contains(QStringLiteral("max_resets")))
+                    lic[QStringLiteral("max_resets")] = 3;
+                if (!lic.contains(QStringLiteral("last_hwid_change")))
+                    lic[QStringLiteral("last_hwid_change")] = QString();
+                licenses[i] = lic;
+                doc.setArray(licenses);
+                return { Edit::Write, QStringLiteral("License activated successfully!"),
+                         QStringLiteral("Failed to save activation. Try again.") };
+            }, [this, key, username, passHash, previousUser](Verdict verdict, const QString &message) {
+                if (verdict != Verdict::Accepted) {
+                    releaseUsername(username, key);
+                    emit activateResult(false, message);
+                    return;
+                }
+                if (!previousUser->isEmpty() && previousUser->compare(username, Qt::CaseInsensitive) != 0)
+                    releaseUsername(*previousUser, key);
+                writeToken(username, passHash);
+                emit activateResult(true, message);
+            });
         });
     });
 }
 
 void LicenseManager::login(const QString &username, const QString &password)
 {
-    QString myHwid = hwid();
-    QByteArray passHash = QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex();
+    if (!identityReady([this, username, password]() { login(username, password); }))
+        return;
 
-    fetchLicenses([this, username, passHash, myHwid]
-                  (bool ok, QJsonArray licenses, QString sha) {
-        if (!ok) {
-            emit loginResult(false, QStringLiteral("Could not connect to license server."));
+    const QString passHash = QString::fromLatin1(
+        QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex());
+
+    const Token token = usableToken(username);
+    const bool cached = token.valid && token.passHash == passHash;
+    if (cached && token.fresh) {
+        emit loginResult(true, QStringLiteral("Welcome back!"));
+        revalidate(username, passHash);
+        return;
+    }
+
+    // Past its lifetime the token only covers for an unreachable server
+    verifyOnline(username, passHash, [this, cached, token](Verdict verdict, const QString &message) {
+        if (verdict == Verdict::Unreachable && cached) {
+            const qint64 age = QDateTime::currentSecsSinceEpoch() - token.validatedAt;
+            const int daysLeft = kTokenLifetimeDays + kTokenGraceDays - int(age / 86400);
+            emit loginResult(true, QStringLiteral("Welcome back! License server unreachable — connect within %1 day(s).").arg(daysLeft));
             return;
         }
+        if (verdict == Verdict::Rejected && cached)
+            clearToken();
+        emit loginResult(verdict == Verdict::Accepted, message);
+    });
+}
 
-        for (int i = 0; i < licenses.size(); ++i) {
-            QJsonObject lic = licenses[i].toObject();
-            if (lic.value(QStringLiteral("username")).toString().compare(username, Qt::CaseInsensitive) == 0) {
-                if (lic.value(QStringLiteral("password")).toString() != QString::fromLatin1(passHash)) {
-                    emit loginResult(false, QStringLiteral("Wrong password."));
-                    return;
-                }
-                QString storedHwid = lic.value(QStringLiteral("hwid")).toString();
-                if (storedHwid.isEmpty()) {
-                    // HWID was reset — auto-bind to this machine
-                    lic[QStringLiteral("hwid")] = myHwid;
-                    lic[QStringLiteral("activated_at")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
-                    licenses[i] = lic;
-                    saveLicenses(licenses, sha, [this](bool saved) {
-                        if (saved)
-                            emit loginResult(true, QStringLiteral("Welcome back! HWID re-bound to this machine."));
-                        else
-                            emit loginResult(false, QStringLiteral("Failed to update HWID binding."));
-                    });
-                    return;
-                }
-                if (storedHwid != myHwid) {
-                    // Check if self-rebind is allowed
-                    int resets = lic.value(QStringLiteral("hwid_resets")).toInt(0);
-                    int maxResets = lic.value(QStringLiteral("max_resets")).toInt(3);
-                    if (resets >= maxResets) {
-                        emit loginResult(false, QStringLiteral("This account is bound to a different machine. All %1 HWID changes used — contact admin.").arg(maxResets));
-                        return;
-                    }
-                    // Check 30-day cooldown
-                    QString lastChange = lic.value(QStringLiteral("last_hwid_change")).toString();
-                    if (!lastChange.isEmpty()) {
-                        QDateTime lastDt = QDateTime::fromString(lastChange, Qt::ISODate);
-                        if (lastDt.isValid() && lastDt.daysTo(QDateTime::currentDateTimeUtc()) < 30) {
-                            int daysLeft = 30 - lastDt.daysTo(QDateTime::currentDateTimeUtc());
-                            emit loginResult(false, QStringLiteral("HWID mismatch. You can rebind in %1 day(s).").arg(daysLeft));
-                            return;
-                        }
-                    }
-                    // Auto-rebind to new machine
-                    lic[QStringLiteral("hwid")] = myHwid;
-                    lic[QStringLiteral("hwid_resets")] = resets + 1;
-                    lic[QStringLiteral("last_hwid_change")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
-                    lic[QStringLiteral("activated_at")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
-                    licenses[i] = lic;
-                    saveLicenses(licenses, sha, [this, resets, maxResets](bool saved) {
-                        if (saved)
-                            emit loginResult(true, QStringLiteral("Welcome back! HWID re-bound (%1/%2 changes used).").arg(resets + 1).arg(maxResets));
-                        else
-                            emit loginResult(false, QStringLiteral("Failed to update HWID binding."));
-                    });
-                    return;
-                }
-                emit loginResult(true, QStringLiteral("Welcome back!"));
-                return;
-            }
+void LicenseManager::revalidate(const QString &username, const QString &passHash)
+{
+    verifyOnline(username, passHash, [this](Verdict verdict, const QString &message) {
+        if (verdict == Verdict::Rejected) {
+            qWarning().noquote() << "[License] Cached login revoked:" << message;
+            clearToken();
+            emit licenseRevoked(message);
+        } else if (verdict == Verdict::Unreachable) {
+            qDebug().noquote() << "[License] Revalidation deferred:" << message;
+        }
+    });
+}
+
+void LicenseManager::verifyOnline(const QString &username, const QString &passHash,
+                                  VerdictCallback done)
+{
+    const QString myHwid = hwid();
+
+    lookupKey(username, [this, username, passHash, myHwid, done](bool ok, QString key) {
+        if (!ok) {
+            done(Verdict::Unreachable, QStringLiteral("Could not connect to license server."));
+            return;
+        }
+        if (key.isEmpty()) {
+            done(Verdict::Rejected, QStringLiteral("User not found. Activate a license first."));
+            return;
         }
 
-        emit loginResult(false, QStringLiteral("User not found. Activate a license first."));
+        updateFile(keyShardPath(key), [key, username, passHash, myHwid](QJsonDocument &doc) -> Edit {
+            QJsonArray licenses = doc.array();
+            const int i = findLicense(licenses, key);
+            QJsonObject lic = i >= 0 ? licenses[i].toObject() : QJsonObject();
+            if (lic.value(QStringLiteral("username")).toString().compare(username, Qt::CaseInsensitive) != 0)
+                return { Edit::Abort, QStringLiteral("User not found. Activate a license first.") };
+            if (lic.value(QStringLiteral("password")).toString() != passHash)
+                return { Edit::Abort, QStringLiteral("Wrong password.") };
+
+            const QString failure = QStringLiteral("Failed to update HWID binding.");
+            const QString storedHwid = lic.value(QStringLiteral("hwid")).toString();
+            if (storedHwid.isEmpty()) {
+                // HWID was reset — auto-bind to this machine
+                lic[QStringLiteral("hwid")] = myHwid;
+                lic[QStringLiteral("activated_at")] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+                licenses[i] = lic;
+                doc.setArray(licenses);
+                return { Edit::Write, QStringLiteral("Welcome back! HWID re-bound to this machine."), failure };
+            }
+            if (storedHwid != myHwid) {
+                const RebindCheck c = checkRebind(lic);
+                if (c.resets >= c.maxResets)
+                    return { Edit::Abort, QStringLiteral("This account is bound to a different machine. All %1 HWID changes used — contact admin.").arg(c.maxResets) };
+                if (c.cooldownDays > 0)
+                    return { Edit::Abort, QStringLiteral("HWID mismatch. You can rebind in %1 day(s).").arg(c.cooldownDays) };
+                // Auto-rebind to new machine
+                rebind(lic, myHwid);
+                licenses[i] = lic;
+                doc.setArray(licenses);
+                return { Edit::Write,
+                         QStringLiteral("Welcome back! HWID re-bound (%1/%2 changes used).").arg(c.resets + 1).arg(c.maxResets),
+                         failure };
+            }
+            return { Edit::Keep, QStringLiteral("Welcome back!") };
+        }, [this, username, passHash, done](Verdict verdict, const QString &message) {
+            // Every acceptance refreshes the token; a failed save is not a rejection
+            if (verdict == Verdict::Accepted)
+                writeToken(username, passHash);
+            done(verdict, message);
+        });
     });
 }
 
@@ -366,51 +624,63 @@ void LicenseManager::checkHwidStatus(const QString &username)
         emit hwidStatusResult(QStringLiteral("none"), QString());
         return;
     }
+    if (!identityReady([this, username]() { checkHwidStatus(username); }))
+        return;
 
-    QString myHwid = hwid();
+    // A fresh token means this machine is the bound one; no round trip.
+    // One in its grace period only answers when the server does not.
+    const Token token = usableToken(username);
+    if (token.fresh) {
+        emit hwidStatusResult(QStringLiteral("ok"), QStringLiteral("HWID matches"));
+        return;
+    }
 
-    fetchLicenses([this, username, myHwid]
-                  (bool ok, QJsonArray licenses, QString /*sha*/) {
-        if (!ok) {
+    const QString myHwid = hwid();
+
+    lookupKey(username, [this, username, myHwid, token](bool ok, QString key) {
+        if (!ok && token.valid) {
+            emit hwidStatusResult(QStringLiteral("ok"), QStringLiteral("HWID matches"));
+            return;
+        }
+        if (!ok || key.isEmpty()) {
+            // Unreachable or user not found — no status to show
             emit hwidStatusResult(QStringLiteral("none"), QString());
             return;
         }
 
-        for (int i = 0; i < licenses.size(); ++i) {
-            QJsonObject lic = licenses[i].toObject();
-            if (lic.value(QStringLiteral("username")).toString().compare(username, Qt::CaseInsensitive) == 0) {
-                QString storedHwid = lic.value(QStringLiteral("hwid")).toString();
-                if (storedHwid.isEmpty()) {
-                    // HWID was reset — will re-bind on next login
-                    emit hwidStatusResult(QStringLiteral("ok"), QStringLiteral("HWID will be bound on login"));
-                    return;
-                }
-                if (storedHwid == myHwid) {
-                    emit hwidStatusResult(QStringLiteral("ok"), QStringLiteral("HWID matches"));
-                    return;
-                }
-                // HWID mismatch — check rebind eligibility
-                int resets = lic.value(QStringLiteral("hwid_resets")).toInt(0);
-                int maxResets = lic.value(QStringLiteral("max_resets")).toInt(3);
-                if (resets >= maxResets) {
-                    emit hwidStatusResult(QStringLiteral("mismatch"), QStringLiteral("HWID mismatch — all %1 changes used, contact admin").arg(maxResets));
-                    return;
-                }
-                QString lastChange = lic.value(QStringLiteral("last_hwid_change")).toString();
-                if (!lastChange.isEmpty()) {
-                    QDateTime lastDt = QDateTime::fromString(lastChange, Qt::ISODate);
-                    if (lastDt.isValid() && lastDt.daysTo(QDateTime::currentDateTimeUtc()) < 30) {
-                        int daysLeft = 30 - lastDt.daysTo(QDateTime::currentDateTimeUtc());
-                        emit hwidStatusResult(QStringLiteral("mismatch"), QStringLiteral("HWID mismatch — rebind available in %1 day(s)").arg(daysLeft));
-                        return;
-                    }
-                }
-                emit hwidStatusResult(QStringLiteral("rebind"), QStringLiteral("HWID mismatch — will auto-rebind on login (%1/%2 used)").arg(resets).arg(maxResets));
+        fetchFile(keyShardPath(key), [this, key, username, myHwid, token](bool ok, QJsonDocument doc, QString) {
+            if (!ok && token.valid) {
+                emit hwidStatusResult(QStringLiteral("ok"), QStringLiteral("HWID matches"));
+                return;
+            }
+            const int i = ok ? findLicense(doc.array(), key) : -1;
+            const QJsonObject lic = i >= 0 ? doc.array().at(i).toObject() : QJsonObject();
+            if (lic.value(QStringLiteral("username")).toString().compare(username, Qt::CaseInsensitive) != 0) {
+                emit hwidStatusResult(QStringLiteral("none"), QString());
                 return;
             }
-        }
 
-        // User not found — no status to show
-        emit hwidStatusResult(QStringLiteral("none"), QString());
+            QString storedHwid = lic.value(QStringLiteral("hwid")).toString();
+            if (storedHwid.isEmpty()) {
+                // HWID was reset — will re-bind on next login
+                emit hwidStatusResult(QStringLiteral("ok"), QStringLiteral("HWID will be bound on login"));
+                return;
+            }
+            if (storedHwid == myHwid) {
+                emit hwidStatusResult(QStringLiteral("ok"), QStringLiteral("HWID matches"));
+                return;
+            }
+            // HWID mismatch — check rebind eligibility
+            const RebindCheck c = checkRebind(lic);
+            if (c.resets >= c.maxResets) {
+                emit hwidStatusResult(QStringLiteral("mismatch"), QStringLiteral("HWID mismatch — all %1 changes used, contact admin").arg(c.maxResets));
+                return;
+            }
+            if (c.cooldownDays > 0) {
+                emit hwidStatusResult(QStringLiteral("mismatch"), QStringLiteral("HWID mismatch — rebind available in %1 day(s)").arg(c.cooldownDays));
+                return;
+            }
+            emit hwidStatusResult(QStringLiteral("rebind"), QStringLiteral("HWID mismatch — will auto-rebind on login (%1/%2 used)").arg(c.resets).arg(c.maxResets));
+        });
     });
 }
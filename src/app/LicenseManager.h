@@ -7,8 +7,20 @@
 #include <QJsonDocument>
 #include <QNetworkAccessManager>
 
+#include <functional>
+
 /// Manages license keys, HWID binding, and authentication via a private GitHub repo.
-/// License data is stored encrypted in a private GitHub repository.
+/// License data is stored encrypted in a private GitHub repository, sharded
+/// by key hash with a username index beside it, so each operation reads
+/// and writes a shard or two rather than the whole database. Writes carry
+/// the sha they read and are retried on conflict.
+///
+/// A successful online check leaves a signed token in the app data folder
+/// (username, password hash, HWID, time of validation). A later login that
+/// matches it is accepted locally, without the round trip, and revalidated
+/// in the background; licenseRevoked() reports a token the server no longer
+/// honours. Tokens are accepted for kTokenLifetimeDays after validation,
+/// then for kTokenGraceDays more while the server stays unreachable.
 class LicenseManager : public QObject
 {
     Q_OBJECT
@@ -16,7 +28,9 @@ class LicenseManager : public QObject
 public:
     explicit LicenseManager(QObject *parent = nullptr);
 
-    /// Get the hardware ID for this machine (SHA-256 hash of hardware info).
+    /// Get the hardware ID for this machine (MachineIdentity::hwid()).
+    /// Waits for MachineIdentity's background pass if it is still running;
+    /// activate, login and checkHwidStatus defer themselves until it is done.
     QString hwid() const;
 
     /// Activate a license key: binds HWID, sets username/password.
@@ -24,7 +38,8 @@ public:
     /// Returns result asynchronously via activateResult signal.
     void activate(const QString &licenseKey, const QString &username, const QString &password);
 
-    /// Login: checks credentials + HWID against the remote license database.
+    /// Login: checks credentials + HWID against the cached token, else the
+    /// remote license database.
     /// If HWID was reset, auto-binds the current machine on successful login.
     /// Returns result asynchronously via loginResult signal.
     void login(const QString &username, const QString &password);
@@ -37,24 +52,94 @@ public:
     /// Defaults are compiled in but can be overridden.
     void setRepo(const QString &owner, const QString &repo, const QString &token);
 
+    /// Base URL of the contents API, https://api.github.com unless
+    /// TWEAK_LICENSE_API is set (tools/fake_license_api.py for testing).
+    void setApiBase(const QString &url);
+
+    static constexpr int kTokenLifetimeDays = 7;
+    static constexpr int kTokenGraceDays    = 7;
+    static constexpr int kShardCount        = 64;
+    static constexpr int kMaxWriteAttempts  = 5;
+
+    /// Repo paths of the shard holding a license key, and of the index
+    /// shard mapping a username to its key.
+    static QString keyShardPath(const QString &key);
+    static QString userShardPath(const QString &username);
+
 signals:
     void loginResult(bool success, const QString &message);
     void activateResult(bool success, const QString &message);
     void hwidStatusResult(const QString &status, const QString &message);
+    /// A login accepted from the cached token failed revalidation.
+    void licenseRevoked(const QString &message);
 
 private:
-    void fetchLicenses(std::function<void(bool ok, QJsonArray licenses, QString sha)> callback);
-    void saveLicenses(const QJsonArray &licenses, const QString &sha,
-                      std::function<void(bool ok)> callback);
+    enum class Verdict { Accepted, Rejected, Unreachable };
+    using VerdictCallback = std::function<void(Verdict verdict, const QString &message)>;
+
+    /// A missing file is fetched as ok with a null document and no sha.
+    using FetchCallback = std::function<void(bool ok, QJsonDocument doc, QString sha)>;
+    enum class SaveStatus { Saved, Conflict, Failed };
+    using SaveCallback = std::function<void(SaveStatus status)>;
+
+    /// What a read-modify-write does with the file it read. Message goes
+    /// to the caller on Keep, Write or Abort; failure if the write fails.
+    struct Edit
+    {
+        enum Action { Keep, Write, Abort } action;
+        QString message;
+        QString failure;
+    };
+    using Mutation = std::function<Edit(QJsonDocument &doc)>;
+
+    struct Token
+    {
+        QString username;
+        QString passHash;
+        QString hwid;
+        qint64  validatedAt = 0;    // seconds since epoch
+        bool    valid = false;      // present and signature checks out
+        bool    fresh = false;      // within kTokenLifetimeDays; past it only while unreachable
+    };
+
+    /// True if the HWID is known. Otherwise false, with retry queued for
+    /// MachineIdentity::ready(), so the GUI thread never waits for it.
+    bool identityReady(const std::function<void()> &retry);
+
+    /// Check credentials against the remote database, rebinding the HWID
+    /// if allowed; refreshes the token when accepted.
+    void verifyOnline(const QString &username, const QString &passHash, VerdictCallback done);
+    void revalidate(const QString &username, const QString &passHash);
+
+    /// The cached token if it belongs to username on this machine and has
+    /// not run past its grace period; invalid otherwise. A valid token that
+    /// is not fresh stands in only when the server cannot be reached.
+    Token usableToken(const QString &username) const;
+    Token readToken() const;
+    void writeToken(const QString &username, const QString &passHash);
+    void clearToken();
+    QString tokenPath() const;
+    QByteArray tokenSignature(const QByteArray &payload) const;
+    QString contentsUrl(const QString &path) const;
+
+    void fetchFile(const QString &path, FetchCallback callback);
+    void saveFile(const QString &path, const QJsonDocument &doc, const QString &sha,
+                  SaveCallback callback);
+    /// Fetch, mutate, save with the fetched sha; on a conflict, back off
+    /// and start over, up to kMaxWriteAttempts. Abort maps to Rejected,
+    /// network failure or exhausted retries to Unreachable.
+    void updateFile(const QString &path, Mutation mutate, VerdictCallback done, int attempt = 1);
+    void lookupKey(const QString &username, std::function<void(bool ok, QString key)> callback);
+    /// Drop username from the index if it still points at key.
+    void releaseUsername(const QString &username, const QString &key);
 
     QByteArray encrypt(const QByteArray &data) const;
     QByteArray decrypt(const QByteArray &data) const;
-    QString generateHwid() const;
 
     QNetworkAccessManager m_net;
+    QString m_apiBase;
     QString m_owner;
     QString m_repo;
     QString m_token;
     QByteArray m_cryptKey;
-    mutable QString m_cachedHwid;
 };
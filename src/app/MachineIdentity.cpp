@@ -0,0 +1,253 @@
+#include "app/MachineIdentity.h"
+#include "app/Trace.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFutureWatcher>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QSysInfo>
+#include <QtConcurrent/QtConcurrent>
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#endif
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+namespace {
+
+#ifndef Q_OS_WIN
+QByteArray readSmallFile(const QString &path, qint64 maxBytes = 256)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return {};
+    return f.read(maxBytes).trimmed();
+}
+
+int countEntries(const QString &dir, const QStringList &skipPrefixes = {})
+{
+    int n = 0;
+    const QStringList names = QDir(dir).entryList(QDir::Dirs | QDir::System | QDir::NoDotAndDotDot);
+    for (const QString &name : names) {
+        bool skip = false;
+        for (const QString &p : skipPrefixes)
+            skip = skip || name.startsWith(p);
+        if (!skip) ++n;
+    }
+    return n;
+}
+
+QByteArray firstCpuModel()
+{
+    // Only the first chunk: the kernel generates /proc/cpuinfo lazily per CPU.
+    const QByteArray head = readSmallFile(QStringLiteral("/proc/cpuinfo"), 4096);
+    const int at = head.indexOf("model name");
+    if (at < 0) return {};
+    const int colon = head.indexOf(':', at);
+    const int eol   = head.indexOf('\n', at);
+    return head.mid(colon + 1, eol - colon - 1).trimmed();
+}
+#endif
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// MachineIdentity
+// ---------------------------------------------------------------------------
+MachineIdentity &MachineIdentity::instance()
+{
+    static MachineIdentity identity;
+    return identity;
+}
+
+MachineIdentity::MachineIdentity()
+{
+    load();
+}
+
+QString MachineIdentity::defaultPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + QStringLiteral("/identity.json");
+}
+
+void MachineIdentity::start()
+{
+    if (m_computed || m_future.isValid()) return;
+
+    auto *watcher = new QFutureWatcher<Ids>(this);
+    connect(watcher, &QFutureWatcher<Ids>::finished, this, [this, watcher]() {
+        watcher->deleteLater();
+        ids();
+        emit ready();
+    });
+    m_future = QtConcurrent::run(&MachineIdentity::compute);
+    watcher->setFuture(m_future);
+}
+
+void MachineIdentity::whenReady(QObject *context, const std::function<void()> &fn)
+{
+    if (isReady()) {
+        fn();
+        return;
+    }
+    start();
+    connect(this, &MachineIdentity::ready, context, fn, Qt::SingleShotConnection);
+}
+
+const MachineIdentity::Ids &MachineIdentity::ids()
+{
+    if (m_computed)
+        return m_ids;
+
+    start();
+    if (!m_future.isFinished()) {
+        QElapsedTimer waited;
+        waited.start();
+        m_future.waitForFinished();
+        qDebug() << "[Identity] Waited" << waited.elapsed() << "ms for the background pass";
+    }
+    m_ids = m_future.result();
+    m_computed = true;
+
+    if (!m_savedHwid.isEmpty() && m_savedHwid != m_ids.hwid)
+        qWarning() << "[Identity] HWID changed since the last run";
+    save();
+    return m_ids;
+}
+
+QString MachineIdentity::hwid()
+{
+    return ids().hwid;
+}
+
+QString MachineIdentity::fingerprint()
+{
+    return ids().fingerprint;
+}
+
+MachineIdentity::Ids MachineIdentity::compute()
+{
+    TRACE_SCOPE("identity", "compute");
+    return { computeHwid(), computeFingerprint() };
+}
+
+QString MachineIdentity::computeHwid()
+{
+    // The license binding: keep this formula as is, or every bound
+    // license stops matching its machine.
+    QStringList parts;
+    parts << QSysInfo::machineUniqueId();
+    parts << QSysInfo::prettyProductName();
+    parts << QSysInfo::currentCpuArchitecture();
+
+#ifdef Q_OS_WIN
+    // On Windows, also use the machine GUID from registry
+    // (already handled by QSysInfo::machineUniqueId on most Qt builds)
+#else
+    // On Linux, read /etc/machine-id as fallback
+    QFile mid(QStringLiteral("/etc/machine-id"));
+    if (mid.open(QIODevice::ReadOnly))
+        parts << QString::fromUtf8(mid.readAll().trimmed());
+#endif
+
+    QByteArray combined = parts.join(QStringLiteral("|")).toUtf8();
+    QByteArray hash = QCryptographicHash::hash(combined, QCryptographicHash::Sha256);
+    return QString::fromLatin1(hash.toHex()).left(32).toUpper();
+}
+
+QString MachineIdentity::computeFingerprint()
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    auto add = [&hash](const QByteArray &part) {
+        hash.addData(part);
+        hash.addData(QByteArrayLiteral("|"));
+    };
+
+    // Only what identifies the hardware: nothing that changes on reboot,
+    // or every start would throw the hardware cache away.
+#ifdef Q_OS_WIN
+    add(QSysInfo::machineUniqueId());
+
+    HKEY hKey;
+    if (RegOpenKeyExW(HKEY_LOCAL_MACHINE,
+                      L"HARDWARE\\DESCRIPTION\\System\\CentralProcessor\\0",
+                      0, KEY_READ, &hKey) == ERROR_SUCCESS) {
+        wchar_t name[256] = {};
+        DWORD size = sizeof(name);
+        if (RegQueryValueExW(hKey, L"ProcessorNameString", nullptr, nullptr,
+                             reinterpret_cast<LPBYTE>(name), &size) == ERROR_SUCCESS)
+            add(QString::fromWCharArray(name).trimmed().toUtf8());
+        RegCloseKey(hKey);
+    }
+
+    add(QByteArray::number(GetActiveProcessorCount(ALL_PROCESSOR_GROUPS)));
+    MEMORYSTATUSEX mem;
+    mem.dwLength = sizeof(mem);
+    if (GlobalMemoryStatusEx(&mem))
+        add(QByteArray::number(mem.ullTotalPhys >> 28)); // 256 MB granularity
+
+    int displays = 0;
+    DISPLAY_DEVICEW dd;
+    dd.cb = sizeof(dd);
+    while (EnumDisplayDevicesW(nullptr, displays, &dd, 0))
+        ++displays;
+    add(QByteArray::number(displays));
+#else
+    // product_uuid is root-only on most distros; fall back to readable DMI strings
+    const QString dmi = QStringLiteral("/sys/class/dmi/id/");
+    QByteArray machine = readSmallFile(dmi + QStringLiteral("product_uuid"));
+    if (machine.isEmpty())
+        machine = readSmallFile(dmi + QStringLiteral("product_name")) + '/'
+                + readSmallFile(dmi + QStringLiteral("board_name")) + '/'
+                + readSmallFile(dmi + QStringLiteral("bios_version"));
+    add(machine);
+
+    add(firstCpuModel());
+    add(readSmallFile(QStringLiteral("/sys/devices/system/cpu/present")));
+    add(QByteArray::number(countEntries(QStringLiteral("/sys/bus/pci/devices"))));
+    add(QByteArray::number(countEntries(QStringLiteral("/sys/block"),
+                                        { QStringLiteral("loop"), QStringLiteral("ram"),
+                                          QStringLiteral("zram") })));
+#endif
+
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+// ---------------------------------------------------------------------------
+// Persistence
+// ---------------------------------------------------------------------------
+void MachineIdentity::load()
+{
+    QFile f(defaultPath());
+    if (!f.open(QIODevice::ReadOnly))
+        return;
+    const QJsonObject root = QJsonDocument::fromJson(f.readAll()).object();
+    m_savedHwid = root.value(QStringLiteral("hwid")).toString();
+}
+
+void MachineIdentity::save() const
+{
+    QJsonObject root;
+    root[QStringLiteral("hwid")]        = m_ids.hwid;
+    root[QStringLiteral("fingerprint")] = m_ids.fingerprint;
+    root[QStringLiteral("updatedAt")]   = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+
+    QDir().mkpath(QFileInfo(defaultPath()).absolutePath());
+    QSaveFile f(defaultPath());
+    if (!f.open(QIODevice::WriteOnly))
+        return;
+    f.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    if (!f.commit())
+        qWarning() << "[Identity] Could not write" << defaultPath();
+}
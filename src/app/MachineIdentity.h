@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QFuture>
+#include <QObject>
+#include <QString>
+
+#include <functional>
+
+/// What identifies this machine, from one place and off the GUI thread.
+///
+///  - hwid(): the license binding. The formula is the one LicenseManager
+///    always used (machine id, OS name, CPU architecture, /etc/machine-id),
+///    so existing bindings still match.
+///  - fingerprint(): the hardware as the cheap sources see it (DMI, CPU
+///    model and count, device counts). It stays the same across reboots;
+///    HardwareCache re-detects when it differs from the one its snapshot
+///    was taken under.
+///
+/// start() computes both on the thread pool and emits ready(). The
+/// accessors wait for that pass if it is still running, so callers on the
+/// GUI thread go through whenReady() instead. The values are persisted in
+/// identity.json under AppDataLocation, so a changed HWID is logged at
+/// start-up. GUI thread only, apart from the background pass itself.
+class MachineIdentity : public QObject
+{
+    Q_OBJECT
+
+public:
+    static MachineIdentity &instance();
+
+    /// Start the background pass; later calls do nothing.
+    void start();
+
+    /// True once the background pass has finished; the accessors then return at once.
+    bool isReady() const { return m_computed || (m_future.isValid() && m_future.isFinished()); }
+
+    /// Run fn now if ready, otherwise on ready() in context's thread.
+    void whenReady(QObject *context, const std::function<void()> &fn);
+
+    QString hwid();
+    QString fingerprint();
+
+    static QString defaultPath();
+
+signals:
+    /// The background pass finished.
+    void ready();
+
+private:
+    struct Ids
+    {
+        QString hwid;
+        QString fingerprint;
+    };
+
+    MachineIdentity();
+    static Ids compute();
+    static QString computeHwid();
+    static QString computeFingerprint();
+
+    const Ids &ids();
+    void load();
+    void save() const;
+
+    QFuture<Ids> m_future;
+    Ids          m_ids;
+    bool         m_computed = false;
+    QString      m_savedHwid;       // as of the previous run
+};
@@ -0,0 +1,534 @@
+#include "app/MonitorSampler.h"
+#include "app/Trace.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QSet>
+#include <QStorageInfo>
+#include <QTextStream>
+
+#ifdef Q_OS_WIN
+#include <winsock2.h>
+#include <ws2ipdef.h>
+#include <iphlpapi.h>
+#include <Windows.h>
+#include <Psapi.h>
+#include <Pdh.h>
+#pragma comment(lib, "pdh.lib")
+#pragma comment(lib, "psapi.lib")
+#pragma comment(lib, "iphlpapi.lib")
+#endif
+
+namespace {
+
+constexpr double kBytesPerMb = 1024.0 * 1024.0;
+
+// Counter delta that tolerates wrap-around / device resets (reports 0).
+inline double perSecond(quint64 now, quint64 prev, double secs)
+{
+    return (now >= prev && secs > 0) ? static_cast<double>(now - prev) / secs : 0.0;
+}
+
+} // anonymous namespace
+
+MonitorSampler::MonitorSampler(QObject *parent)
+    : QObject(parent)
+    , m_timer(this)
+{
+    connect(&m_timer, &QTimer::timeout, this, [this]() { emit sampled(sample()); });
+}
+
+MonitorSampler::~MonitorSampler()
+{
+#ifdef Q_OS_WIN
+    if (m_pdhQuery)
+        PdhCloseQuery(static_cast<PDH_HQUERY>(m_pdhQuery));
+#endif
+}
+
+#ifdef Q_OS_WIN
+// PDH setup takes a while on some systems, so it runs with the first sample
+// on the monitor thread rather than at construction.
+void MonitorSampler::openCounters()
+{
+    m_countersOpen = true;
+    PDH_HQUERY query = nullptr;
+    if (PdhOpenQueryW(nullptr, 0, &query) == ERROR_SUCCESS) {
+        m_pdhQuery = query;
+        auto addCounter = [query](const wchar_t *path) -> void * {
+            PDH_HCOUNTER counter = nullptr;
+            if (PdhAddEnglishCounterW(query, path, 0, &counter) != ERROR_SUCCESS)
+                return nullptr;
+            return counter;
+        };
+        m_pdhPageFaults     = addCounter(L"\\Memory\\Page Faults/sec");
+        m_pdhPageReads      = addCounter(L"\\Memory\\Page Reads/sec");
+        m_pdhPagesInput     = addCounter(L"\\Memory\\Pages Input/sec");
+        m_pdhPagesOutput    = addCounter(L"\\Memory\\Pages Output/sec");
+        m_pdhDiskReadBytes  = addCounter(L"\\PhysicalDisk(*)\\Disk Read Bytes/sec");
+        m_pdhDiskWriteBytes = addCounter(L"\\PhysicalDisk(*)\\Disk Write Bytes/sec");
+        m_pdhDiskReads      = addCounter(L"\\PhysicalDisk(*)\\Disk Reads/sec");
+        m_pdhDiskWrites     = addCounter(L"\\PhysicalDisk(*)\\Disk Writes/sec");
+        PdhCollectQueryData(query); // rate counters need a first sample
+    }
+}
+#endif
+
+void MonitorSampler::start(int intervalMs)
+{
+    m_timer.start(intervalMs);
+}
+
+void MonitorSampler::stop()
+{
+    m_timer.stop();
+}
+
+MonitorSnapshot MonitorSampler::sample()
+{
+    TRACE_SCOPE("monitor", "sample");
+#ifdef Q_OS_WIN
+    if (!m_countersOpen)
+        openCounters();
+#endif
+    MonitorSnapshot snap;
+    snap.sample.timestampMs = QDateTime::currentMSecsSinceEpoch();
+
+    // One clock for every delta so all rates cover the same interval
+    const double secs = m_firstSample ? 0.0 : static_cast<double>(m_clock.restart()) / 1000.0;
+    if (m_firstSample)
+        m_clock.start();
+
+#ifdef Q_OS_WIN
+    if (m_pdhQuery)
+        PdhCollectQueryData(static_cast<PDH_HQUERY>(m_pdhQuery));
+#endif
+
+    pollCpu(snap);
+    pollRam(snap);
+    pollPaging(snap, secs);
+    pollPressure(snap);
+    pollDiskIo(snap, secs);
+    pollNetIo(snap, secs);
+    pollStorage(snap);
+    pollUptime(snap);
+
+    m_firstSample = false;
+    return snap;
+}
+
+// ---------------------------------------------------------------------------
+// CPU usage
+// ---------------------------------------------------------------------------
+void MonitorSampler::pollCpu(MonitorSnapshot &snap)
+{
+#ifdef Q_OS_WIN
+    FILETIME idle, kernel, user;
+    if (GetSystemTimes(&idle, &kernel, &user)) {
+        auto toU64 = [](const FILETIME &ft) -> quint64 {
+            return (static_cast<quint64>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
+        };
+        quint64 i = toU64(idle), k = toU64(kernel), u = toU64(user);
+        if (!m_firstCpuPoll) {
+            quint64 di = i - m_prevIdleTime;
+            quint64 dk = k - m_prevKernelTime;
+            quint64 du = u - m_prevUserTime;
+            quint64 total = dk + du;
+            if (total > 0)
+                snap.sample.cpuUsage = (1.0 - static_cast<double>(di) / static_cast<double>(total)) * 100.0;
+        }
+        m_prevIdleTime = i;
+        m_prevKernelTime = k;
+        m_prevUserTime = u;
+        m_firstCpuPoll = false;
+    }
+#else
+    QFile f(QStringLiteral("/proc/stat"));
+    if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QString line = QTextStream(&f).readLine(); // "cpu  ..."
+        f.close();
+        QStringList parts = line.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+        if (parts.size() >= 5) {
+            quint64 user   = parts[1].toULongLong();
+            quint64 nice   = parts[2].toULongLong();
+            quint64 system = parts[3].toULongLong();
+            quint64 idle   = parts[4].toULongLong();
+            quint64 iowait = parts.size() > 5 ? parts[5].toULongLong() : 0;
+
+            quint64 total = user + nice + system + idle + iowait;
+            for (int i = 6; i < parts.size(); ++i)
+                total += parts[i].toULongLong();
+
+            quint64 idleTotal = idle + iowait;
+
+            if (!m_firstCpuPoll && total > m_prevTotal) {
+                quint64 dt = total - m_prevTotal;
+                quint64 di = idleTotal - m_prevIdle;
+                snap.sample.cpuUsage = (1.0 - static_cast<double>(di) / static_cast<double>(dt)) * 100.0;
+            }
+            m_prevTotal = total;
+            m_prevIdle = idleTotal;
+            m_firstCpuPoll = false;
+        }
+    }
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// RAM + commit charge
+// ---------------------------------------------------------------------------
+void MonitorSampler::pollRam(MonitorSnapshot &snap)
+{
+#ifdef Q_OS_WIN
+    MEMORYSTATUSEX mem;
+    mem.dwLength = sizeof(MEMORYSTATUSEX);
+    if (GlobalMemoryStatusEx(&mem)) {
+        snap.ramTotalGb = static_cast<double>(mem.ullTotalPhys) / (1024.0 * 1024.0 * 1024.0);
+        double available = static_cast<double>(mem.ullAvailPhys) / (1024.0 * 1024.0 * 1024.0);
+        snap.sample.ramUsedGb = snap.ramTotalGb - available;
+    }
+
+    PERFORMANCE_INFORMATION perf;
+    perf.cb = sizeof(PERFORMANCE_INFORMATION);
+    if (GetPerformanceInfo(&perf, sizeof(perf))) {
+        const double pageGb = static_cast<double>(perf.PageSize) / (1024.0 * 1024.0 * 1024.0);
+        snap.sample.commitGb      = static_cast<double>(perf.CommitTotal) * pageGb;
+        snap.sample.commitLimitGb = static_cast<double>(perf.CommitLimit) * pageGb;
+    }
+#else
+    QFile f(QStringLiteral("/proc/meminfo"));
+    if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        quint64 total = 0, available = 0, committed = 0, commitLimit = 0;
+        QTextStream in(&f);
+        while (!in.atEnd()) {
+            QString line = in.readLine();
+            if (line.startsWith(QStringLiteral("MemTotal:")))
+                total = line.split(QLatin1Char(' '), Qt::SkipEmptyParts).at(1).toULongLong();
+            else if (line.startsWith(QStringLiteral("MemAvailable:")))
+                available = line.split(QLatin1Char(' '), Qt::SkipEmptyParts).at(1).toULongLong();
+            else if (line.startsWith(QStringLiteral("CommitLimit:")))
+                commitLimit = line.split(QLatin1Char(' '), Qt::SkipEmptyParts).at(1).toULongLong();
+            else if (line.startsWith(QStringLiteral("Committed_AS:")))
+                committed = line.split(QLatin1Char(' '), Qt::SkipEmptyParts).at(1).toULongLong();
+        }
+        f.close();
+        snap.ramTotalGb = static_cast<double>(total) / (1024.0 * 1024.0); // kB -> GB
+        snap.sample.ramUsedGb = snap.ramTotalGb - static_cast<double>(available) / (1024.0 * 1024.0);
+        snap.sample.commitGb      = static_cast<double>(committed) / (1024.0 * 1024.0);
+        snap.sample.commitLimitGb = static_cast<double>(commitLimit) / (1024.0 * 1024.0);
+    }
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Paging — page faults and swap traffic (per second since the last poll)
+// ---------------------------------------------------------------------------
+void MonitorSampler::pollPaging(MonitorSnapshot &snap, double secs)
+{
+#ifdef Q_OS_WIN
+    Q_UNUSED(secs);
+    auto read = [](void *counter) -> double {
+        if (!counter) return 0;
+        PDH_FMT_COUNTERVALUE val;
+        if (PdhGetFormattedCounterValue(static_cast<PDH_HCOUNTER>(counter), PDH_FMT_DOUBLE,
+                                        nullptr, &val) != ERROR_SUCCESS)
+            return 0;
+        return val.doubleValue;
+    };
+    snap.sample.pageFaultsPerSec  = read(m_pdhPageFaults);
+    snap.sample.majorFaultsPerSec = read(m_pdhPageReads);
+    snap.sample.swapInPerSec      = read(m_pdhPagesInput);
+    snap.sample.swapOutPerSec     = read(m_pdhPagesOutput);
+#else
+    QFile f(QStringLiteral("/proc/vmstat"));
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+
+    quint64 pgFault = 0, pgMajFault = 0, pswpIn = 0, pswpOut = 0;
+    QTextStream in(&f);
+    while (!in.atEnd()) {
+        const QString line = in.readLine();
+        const int sp = line.indexOf(QLatin1Char(' '));
+        if (sp <= 0) continue;
+        const QStringView key = QStringView(line).left(sp);
+        if (key == u"pgfault")         pgFault    = line.mid(sp + 1).toULongLong();
+        else if (key == u"pgmajfault") pgMajFault = line.mid(sp + 1).toULongLong();
+        else if (key == u"pswpin")     pswpIn     = line.mid(sp + 1).toULongLong();
+        else if (key == u"pswpout")    pswpOut    = line.mid(sp + 1).toULongLong();
+    }
+    f.close();
+
+    if (!m_firstSample) {
+        snap.sample.pageFaultsPerSec  = perSecond(pgFault, m_prevPgFault, secs);
+        snap.sample.majorFaultsPerSec = perSecond(pgMajFault, m_prevPgMajFault, secs);
+        snap.sample.swapInPerSec      = perSecond(pswpIn, m_prevPswpIn, secs);
+        snap.sample.swapOutPerSec     = perSecond(pswpOut, m_prevPswpOut, secs);
+    }
+    m_prevPgFault    = pgFault;
+    m_prevPgMajFault = pgMajFault;
+    m_prevPswpIn     = pswpIn;
+    m_prevPswpOut    = pswpOut;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Pressure stall information (Linux 4.20+; not available on Windows)
+// ---------------------------------------------------------------------------
+void MonitorSampler::pollPressure(MonitorSnapshot &snap)
+{
+#ifndef Q_OS_WIN
+    // "some avg10=1.23 avg60=0.50 avg300=0.10 total=123456"
+    auto readSomeAvg10 = [](const QString &path) -> double {
+        QFile f(path);
+        if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+            return 0;
+        const QString line = QTextStream(&f).readLine();
+        const int pos = line.indexOf(QStringLiteral("avg10="));
+        if (!line.startsWith(QStringLiteral("some")) || pos < 0)
+            return 0;
+        const int end = line.indexOf(QLatin1Char(' '), pos);
+        return line.mid(pos + 6, end < 0 ? -1 : end - pos - 6).toDouble();
+    };
+    snap.sample.psiCpu    = readSomeAvg10(QStringLiteral("/proc/pressure/cpu"));
+    snap.sample.psiMemory = readSomeAvg10(QStringLiteral("/proc/pressure/memory"));
+    snap.sample.psiIo     = readSomeAvg10(QStringLiteral("/proc/pressure/io"));
+#else
+    Q_UNUSED(snap);
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Disk I/O — per physical device read/write throughput and IOPS
+// ---------------------------------------------------------------------------
+void MonitorSampler::pollDiskIo(MonitorSnapshot &snap, double secs)
+{
+#ifdef Q_OS_WIN
+    Q_UNUSED(secs);
+    // PDH already reports rates; instances look like "0 C:", plus "_Total"
+    auto readArray = [](void *counter) -> QHash<QString, double> {
+        QHash<QString, double> out;
+        if (!counter) return out;
+        DWORD bufSize = 0, count = 0;
+        if (PdhGetFormattedCounterArrayW(static_cast<PDH_HCOUNTER>(counter), PDH_FMT_DOUBLE,
+                                         &bufSize, &count, nullptr) != PDH_MORE_DATA)
+            return out;
+        QByteArray buf(static_cast<int>(bufSize), Qt::Uninitialized);
+        auto *items = reinterpret_cast<PDH_FMT_COUNTERVALUE_ITEM_W *>(buf.data());
+        if (PdhGetFormattedCounterArrayW(static_cast<PDH_HCOUNTER>(counter), PDH_FMT_DOUBLE,
+                                         &bufSize, &count, items) != ERROR_SUCCESS)
+            return out;
+        for (DWORD i = 0; i < count; ++i) {
+            const QString name = QString::fromWCharArray(items[i].szName);
+            if (name != QStringLiteral("_Total"))
+                out.insert(name, items[i].FmtValue.doubleValue);
+        }
+        return out;
+    };
+
+    const QHash<QString, double> readBytes  = readArray(m_pdhDiskReadBytes);
+    const QHash<QString, double> writeBytes = readArray(m_pdhDiskWriteBytes);
+    const QHash<QString, double> reads      = readArray(m_pdhDiskReads);
+    const QHash<QString, double> writes     = readArray(m_pdhDiskWrites);
+
+    for (auto it = readBytes.cbegin(); it != readBytes.cend(); ++it) {
+        DiskIoStat d;
+        d.device    = it.key();
+        d.readMBps  = it.value() / kBytesPerMb;
+        d.writeMBps = writeBytes.value(it.key()) / kBytesPerMb;
+        d.readIops  = reads.value(it.key());
+        d.writeIops = writes.value(it.key());
+        snap.disks.append(d);
+    }
+#else
+    // Whole disks only: partitions and virtual devices are skipped
+    QSet<QString> physical;
+    const QStringList blockDevs = QDir(QStringLiteral("/sys/block"))
+                                      .entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString &dev : blockDevs) {
+        if (dev.startsWith(QStringLiteral("loop")) || dev.startsWith(QStringLiteral("ram"))
+            || dev.startsWith(QStringLiteral("zram")))
+            continue;
+        physical.insert(dev);
+    }
+
+    QFile f(QStringLiteral("/proc/diskstats"));
+    if (!f.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+
+    // major minor name reads merged sectorsRead msRead writes merged sectorsWritten ...
+    QHash<QString, DiskCounters> current;
+    QTextStream in(&f);
+    while (!in.atEnd()) {
+        const QStringList parts = in.readLine().split(QLatin1Char(' '), Qt::SkipEmptyParts);
+        if (parts.size() < 10 || !physical.contains(parts.at(2)))
+            continue;
+        DiskCounters c;
+        c.reads      = parts.at(3).toULongLong();
+        c.readBytes  = parts.at(5).toULongLong() * 512ULL; // sectors are always 512 B here
+        c.writes     = parts.at(7).toULongLong();
+        c.writeBytes = parts.at(9).toULongLong() * 512ULL;
+        current.insert(parts.at(2), c);
+    }
+    f.close();
+
+    for (auto it = current.cbegin(); it != current.cend(); ++it) {
+        DiskIoStat d;
+        d.device = it.key();
+        const auto prev = m_prevDisk.constFind(it.key());
+        if (!m_firstSample && prev != m_prevDisk.cend()) {
+            d.readMBps  = perSecond(it->readBytes, prev->readBytes, secs) / kBytesPerMb;
+            d.writeMBps = perSecond(it->writeBytes, prev->writeBytes, secs) / kBytesPerMb;
+            d.readIops  = perSecond(it->reads, prev->reads, secs);
+            d.writeIops = perSecond(it->writes, prev->writes, secs);
+        }
+        snap.disks.append(d);
+    }
+    m_prevDisk = current;
+#endif
+
+    for (const DiskIoStat &d : snap.disks) {
+        snap.sample.diskReadMBps  += d.readMBps;
+        snap.sample.diskWriteMBps += d.writeMBps;
+        snap.diskReadIops         += d.readIops;
+        snap.diskWriteIops        += d.writeIops;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Network I/O — per interface rx/tx and TCP retransmits
+// ---------------------------------------------------------------------------
+void MonitorSampler::pollNetIo(MonitorSnapshot &snap, double secs)
+{
+    QHash<QString, NetCounters> current;
+    quint64 retransSegs = 0, outSegs = 0;
+
+#ifdef Q_OS_WIN
+    PMIB_IF_TABLE2 table = nullptr;
+    if (GetIfTable2(&table) == NO_ERROR && table) {
+        for (ULONG i = 0; i < table->NumEntries; ++i) {
+            const MIB_IF_ROW2 &row = table->Table[i];
+            if (row.Type == IF_TYPE_SOFTWARE_LOOPBACK
+                || !row.InterfaceAndOperStatusFlags.HardwareInterface
+                || row.OperStatus != IfOperStatusUp)
+                continue;
+            NetCounters c;
+            c.rxBytes   = row.InOctets;
+            c.txBytes   = row.OutOctets;
+            c.rxPackets = row.InUcastPkts + row.InNUcastPkts;
+            c.txPackets = row.OutUcastPkts + row.OutNUcastPkts;
+            current.insert(QString::fromWCharArray(row.Alias), c);
+        }
+        FreeMibTable(table);
+    }
+
+    for (ULONG family : {static_cast<ULONG>(AF_INET), static_cast<ULONG>(AF_INET6)}) {
+        MIB_TCPSTATS stats;
+        if (GetTcpStatisticsEx(&stats, family) == NO_ERROR) {
+            retransSegs += stats.dwRetransSegs;
+            outSegs     += stats.dwOutSegs;
+        }
+    }
+#else
+    // "  eth0: rxBytes rxPackets errs drop fifo frame compressed multicast txBytes txPackets ..."
+    QFile dev(QStringLiteral("/proc/net/dev"));
+    if (dev.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream in(&dev);
+        while (!in.atEnd()) {
+            const QString line = in.readLine();
+            const int colon = line.indexOf(QLatin1Char(':'));
+            if (colon < 0) continue; // header lines
+            const QString iface = line.left(colon).trimmed();
+            if (iface == QStringLiteral("lo")) continue;
+            const QStringList f = line.mid(colon + 1).split(QLatin1Char(' '), Qt::SkipEmptyParts);
+            if (f.size() < 10) continue;
+            NetCounters c;
+            c.rxBytes   = f.at(0).toULongLong();
+            c.rxPackets = f.at(1).toULongLong();
+            c.txBytes   = f.at(8).toULongLong();
+            c.txPackets = f.at(9).toULongLong();
+            current.insert(iface, c);
+        }
+        dev.close();
+    }
+
+    // Two "Tcp:" lines: column names, then values
+    QFile snmp(QStringLiteral("/proc/net/snmp"));
+    if (snmp.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        QTextStream in(&snmp);
+        QStringList header;
+        while (!in.atEnd()) {
+            const QString line = in.readLine();
+            if (!line.startsWith(QStringLiteral("Tcp:"))) continue;
+            const QStringList cols = line.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+            if (header.isEmpty()) {
+                header = cols;
+                continue;
+            }
+            const int retransIdx = header.indexOf(QStringLiteral("RetransSegs"));
+            const int outIdx     = header.indexOf(QStringLiteral("OutSegs"));
+            if (retransIdx > 0 && retransIdx < cols.size())
+                retransSegs = cols.at(retransIdx).toULongLong();
+            if (outIdx > 0 && outIdx < cols.size())
+                outSegs = cols.at(outIdx).toULongLong();
+            break;
+        }
+        snmp.close();
+    }
+#endif
+
+    for (auto it = current.cbegin(); it != current.cend(); ++it) {
+        NetIoStat n;
+        n.iface = it.key();
+        const auto prev = m_prevNet.constFind(it.key());
+        if (!m_firstSample && prev != m_prevNet.cend()) {
+            n.rxMBps    = perSecond(it->rxBytes, prev->rxBytes, secs) / kBytesPerMb;
+            n.txMBps    = perSecond(it->txBytes, prev->txBytes, secs) / kBytesPerMb;
+            n.rxPackets = perSecond(it->rxPackets, prev->rxPackets, secs);
+            n.txPackets = perSecond(it->txPackets, prev->txPackets, secs);
+        }
+        snap.sample.netRxMBps += n.rxMBps;
+        snap.sample.netTxMBps += n.txMBps;
+        snap.interfaces.append(n);
+    }
+    m_prevNet = current;
+
+    if (!m_firstSample) {
+        snap.sample.tcpRetransPerSec = perSecond(retransSegs, m_prevRetransSegs, secs);
+        if (outSegs > m_prevOutSegs && retransSegs >= m_prevRetransSegs)
+            snap.tcpRetransPercent = 100.0 * static_cast<double>(retransSegs - m_prevRetransSegs)
+                                   / static_cast<double>(outSegs - m_prevOutSegs);
+    }
+    m_prevRetransSegs = retransSegs;
+    m_prevOutSegs     = outSegs;
+}
+
+// ---------------------------------------------------------------------------
+// Storage (root/C: drive)
+// ---------------------------------------------------------------------------
+void MonitorSampler::pollStorage(MonitorSnapshot &snap)
+{
+    QStorageInfo root = QStorageInfo::root();
+    if (root.isValid()) {
+        snap.storageTotalGb = static_cast<double>(root.bytesTotal()) / (1024.0 * 1024.0 * 1024.0);
+        double free = static_cast<double>(root.bytesAvailable()) / (1024.0 * 1024.0 * 1024.0);
+        snap.storageUsedGb = snap.storageTotalGb - free;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Uptime
+// ---------------------------------------------------------------------------
+void MonitorSampler::pollUptime(MonitorSnapshot &snap)
+{
+#ifdef Q_OS_WIN
+    snap.uptimeMinutes = static_cast<int>(GetTickCount64() / 60000ULL);
+#else
+    QFile f(QStringLiteral("/proc/uptime"));
+    if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        double secs = QTextStream(&f).readLine().split(QLatin1Char(' ')).first().toDouble();
+        snap.uptimeMinutes = static_cast<int>(secs / 60.0);
+        f.close();
+    }
+#endif
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QList>
+#include <QMetaType>
+#include <QObject>
+#include <QString>
+#include <QTimer>
+
+/// One point of the monitor time series. Rates are per second over the
+/// preceding poll interval; PSI values are the kernel's 10 s "some" average (%).
+struct MonitorSample
+{
+    qint64 timestampMs       = 0;   // ms since epoch
+    double cpuUsage          = 0;
+    double ramUsedGb         = 0;
+    double pageFaultsPerSec  = 0;
+    double majorFaultsPerSec = 0;
+    double swapInPerSec      = 0;   // pages/s
+    double swapOutPerSec     = 0;   // pages/s
+    double psiCpu            = 0;
+    double psiMemory         = 0;
+    double psiIo             = 0;
+    double commitGb          = 0;
+    double commitLimitGb     = 0;
+    // I/O totals across all physical disks / non-loopback interfaces
+    double diskReadMBps      = 0;
+    double diskWriteMBps     = 0;
+    double netRxMBps         = 0;
+    double netTxMBps         = 0;
+    double tcpRetransPerSec  = 0;
+};
+
+/// Per-device disk throughput over the last interval.
+struct DiskIoStat
+{
+    QString device;          // "nvme0n1", "sda" / "0 C:"
+    double readMBps   = 0;
+    double writeMBps  = 0;
+    double readIops   = 0;
+    double writeIops  = 0;
+};
+
+/// Per-interface network throughput over the last interval.
+struct NetIoStat
+{
+    QString iface;           // "eth0" / adapter alias
+    double rxMBps     = 0;
+    double txMBps     = 0;
+    double rxPackets  = 0;   // packets/s
+    double txPackets  = 0;
+};
+
+/// Everything one poll produces. Built on the monitor thread and handed
+/// to SystemMonitor by value through a queued signal.
+struct MonitorSnapshot
+{
+    MonitorSample     sample;
+    double            ramTotalGb       = 0;
+    double            storageUsedGb    = 0;
+    double            storageTotalGb   = 0;
+    int               uptimeMinutes    = 0;
+    double            diskReadIops     = 0;
+    double            diskWriteIops    = 0;
+    double            tcpRetransPercent = 0; // retransmitted / sent segments
+    QList<DiskIoStat> disks;
+    QList<NetIoStat>  interfaces;
+};
+
+Q_DECLARE_METATYPE(MonitorSnapshot)
+
+/// Reads raw counters (/proc on Linux, Win32/PDH/IP Helper on Windows) and
+/// turns them into rates by diffing against the previous sample. Lives on
+/// SystemMonitor's worker thread; sample() may also be called directly
+/// before the object is moved there.
+class MonitorSampler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit MonitorSampler(QObject *parent = nullptr);
+    ~MonitorSampler() override;
+
+    /// Take one incremental sample (rates relative to the previous call).
+    MonitorSnapshot sample();
+
+public slots:
+    void start(int intervalMs);
+    void stop();
+
+signals:
+    void sampled(const MonitorSnapshot &snapshot);
+
+private:
+    void pollCpu(MonitorSnapshot &snap);
+    void pollRam(MonitorSnapshot &snap);
+    void pollPaging(MonitorSnapshot &snap, double secs);
+    void pollPressure(MonitorSnapshot &snap);
+    void pollDiskIo(MonitorSnapshot &snap, double secs);
+    void pollNetIo(MonitorSnapshot &snap, double secs);
+    void pollStorage(MonitorSnapshot &snap);
+    void pollUptime(MonitorSnapshot &snap);
+#ifdef Q_OS_WIN
+    void openCounters();
+#endif
+
+    QTimer        m_timer;
+    QElapsedTimer m_clock;
+    bool          m_firstSample = true;
+
+    struct DiskCounters { quint64 readBytes = 0, writeBytes = 0, reads = 0, writes = 0; };
+    struct NetCounters  { quint64 rxBytes = 0, txBytes = 0, rxPackets = 0, txPackets = 0; };
+    QHash<QString, DiskCounters> m_prevDisk;
+    QHash<QString, NetCounters>  m_prevNet;
+    quint64 m_prevRetransSegs = 0;
+    quint64 m_prevOutSegs     = 0;
+
+#ifdef Q_OS_WIN
+    quint64 m_prevIdleTime  = 0;
+    quint64 m_prevKernelTime = 0;
+    quint64 m_prevUserTime  = 0;
+    bool    m_firstCpuPoll  = true;
+
+    // PDH query + counters (PDH_HQUERY / PDH_HCOUNTER are opaque handles)
+    bool  m_countersOpen    = false;
+    void *m_pdhQuery        = nullptr;
+    void *m_pdhPageFaults   = nullptr;
+    void *m_pdhPageReads    = nullptr;
+    void *m_pdhPagesInput   = nullptr;
+    void *m_pdhPagesOutput  = nullptr;
+    void *m_pdhDiskReadBytes  = nullptr;
+    void *m_pdhDiskWriteBytes = nullptr;
+    void *m_pdhDiskReads      = nullptr;
+    void *m_pdhDiskWrites     = nullptr;
+#else
+    quint64 m_prevTotal = 0;
+    quint64 m_prevIdle  = 0;
+    bool    m_firstCpuPoll = true;
+
+    quint64 m_prevPgFault    = 0;
+    quint64 m_prevPgMajFault = 0;
+    quint64 m_prevPswpIn     = 0;
+    quint64 m_prevPswpOut    = 0;
+#endif
+};
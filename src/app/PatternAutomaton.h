@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// Case-insensitive multi-pattern matcher (Aho–Corasick) over a static
+/// keyword table, built entirely at compile time. The table is any array of
+/// structs with `const char *keyword` and `int score` members.
+///
+/// find() makes one pass over the input, allocates nothing and returns the
+/// longest keyword occurring anywhere in it (ties: higher score, then the
+/// earlier table entry), so "RTX 4070 Ti Super" beats "RTX 4070" by
+/// construction rather than by score.
+///
+/// Keywords may only contain ASCII letters, digits and spaces; anything else
+/// in the input simply breaks a match.
+namespace PatternMatch {
+
+constexpr int kAlphabet = 38;   // A–Z, 0–9, space, "other"
+constexpr int kOther    = 37;
+
+constexpr int charIndex(unsigned c)
+{
+    if (c >= 'a' && c <= 'z') return int(c - 'a');
+    if (c >= 'A' && c <= 'Z') return int(c - 'A');
+    if (c >= '0' && c <= '9') return 26 + int(c - '0');
+    if (c == ' ')             return 36;
+    return kOther;
+}
+
+constexpr std::size_t keywordLength(const char *s)
+{
+    std::size_t n = 0;
+    while (s[n]) ++n;
+    return n;
+}
+
+/// Upper bound on trie states for a table (root + one per keyword character).
+template <typename Entry, std::size_t N>
+constexpr std::size_t stateBound(const Entry (&table)[N])
+{
+    std::size_t n = 1;
+    for (std::size_t i = 0; i < N; ++i)
+        n += keywordLength(table[i].keyword);
+    return n;
+}
+
+/// True if every keyword is non-empty and uses only the supported alphabet.
+template <typename Entry, std::size_t N>
+constexpr bool validKeywords(const Entry (&table)[N])
+{
+    for (std::size_t i = 0; i < N; ++i) {
+        const char *k = table[i].keyword;
+        if (!k[0]) return false;
+        for (std::size_t j = 0; k[j]; ++j)
+            if (charIndex(static_cast<unsigned char>(k[j])) == kOther)
+                return false;
+    }
+    return true;
+}
+
+struct Match
+{
+    int index  = -1;   // table entry, -1 if nothing matched
+    int length = 0;
+    int score  = 0;
+    constexpr bool found() const { return index >= 0; }
+};
+
+template <std::size_t States>
+class Automaton
+{
+public:
+    template <typename Entry, std::size_t N>
+    static constexpr Automaton build(const Entry (&table)[N])
+    {
+        static_assert(N < 32767 && States < 32767, "table too large for 16-bit states");
+
+        Automaton a;
+        for (std::size_t s = 0; s < States; ++s) {
+            for (int c = 0; c < kAlphabet; ++c)
+                a.m_next[s][c] = -1;
+            a.m_out[s] = -1;
+        }
+
+        // 1. Trie of all keywords; the first entry wins for duplicates.
+        int count = 1;
+        for (std::size_t i = 0; i < N; ++i) {
+            int s = 0;
+            const char *k = table[i].keyword;
+            for (std::size_t j = 0; k[j]; ++j) {
+                const int c = charIndex(static_cast<unsigned char>(k[j]));
+                if (a.m_next[s][c] < 0)
+                    a.m_next[s][c] = static_cast<std::int16_t>(count++);
+                s = a.m_next[s][c];
+            }
+            if (a.m_out[s] < 0) {
+                a.m_out[s]    = static_cast<std::int16_t>(i);
+                a.m_outLen[s] = static_cast<std::int16_t>(keywordLength(k));
+                a.m_score[s]  = table[i].score;
+            }
+        }
+
+        // 2. Breadth-first: failure links folded into a full transition table,
+        //    and each state's output replaced by the longest keyword that ends
+        //    there (own keyword, else the failure state's).
+        std::int16_t fail[States] = {};
+        std::int16_t queue[States] = {};
+        int head = 0, tail = 0;
+        for (int c = 0; c < kAlphabet; ++c) {
+            const std::int16_t t = a.m_next[0][c];
+            if (t < 0) {
+                a.m_next[0][c] = 0;
+            } else {
+                fail[t] = 0;
+                queue[tail++] = t;
+            }
+        }
+        while (head < tail) {
+            const std::int16_t s = queue[head++];
+            if (a.m_out[s] < 0) {
+                a.m_out[s]    = a.m_out[fail[s]];
+                a.m_outLen[s] = a.m_outLen[fail[s]];
+                a.m_score[s]  = a.m_score[fail[s]];
+            }
+            for (int c = 0; c < kAlphabet; ++c) {
+                const std::int16_t t = a.m_next[s][c];
+                if (t < 0) {
+                    a.m_next[s][c] = a.m_next[fail[s]][c];
+                } else {
+                    fail[t] = a.m_next[fail[s]][c];
+                    queue[tail++] = t;
+                }
+            }
+        }
+        return a;
+    }
+
+    /// Longest keyword contained in text[0, length). Char is any integral
+    /// code unit type (char, char16_t, ushort).
+    template <typename Char>
+    constexpr Match find(const Char *text, std::size_t length) const
+    {
+        Match best;
+        int s = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            s = m_next[s][charIndex(static_cast<unsigned>(text[i]))];
+            const int out = m_out[s];
+            if (out < 0)
+                continue;
+            const int len = m_outLen[s];
+            const int score = m_score[s];
+            if (len > best.length
+                || (len == best.length && (score > best.score
+                                           || (score == best.score && out < best.index)))) {
+                best.index  = out;
+                best.length = len;
+                best.score  = score;
+            }
+        }
+        return best;
+    }
+
+private:
+    std::int16_t m_next[States][kAlphabet] = {};
+    std::int16_t m_out[States]    = {};
+    std::int16_t m_outLen[States] = {};
+    int          m_score[States]  = {};
+};
+
+} // namespace PatternMatch
@@ -1,4 +1,5 @@
 #include "app/PowerUtil.h"
+#include "app/Trace.h"
 
 #include <QDir>
 #include <QFile>
@@ -12,6 +13,7 @@
 // ---------------------------------------------------------------------------
 QString PowerUtil::activeSchemeGuid()
 {
+    TRACE_SCOPE("power", "activeSchemeGuid");
 #ifdef Q_OS_WIN
     QProcess proc;
     proc.start(QStringLiteral("powercfg"), {QStringLiteral("/getactivescheme")});
@@ -28,6 +30,7 @@ QString PowerUtil::activeSchemeGuid()
 
 bool PowerUtil::setActiveScheme(const QString &guid)
 {
+    TRACE_SCOPE("power", "setActiveScheme");
 #ifdef Q_OS_WIN
     if (guid.isEmpty()) return false;
     QProcess proc;
@@ -42,6 +45,7 @@ bool PowerUtil::setActiveScheme(const QString &guid)
 
 bool PowerUtil::ensureUltimatePerformancePlan()
 {
+    TRACE_SCOPE("power", "ensureUltimatePerformancePlan");
 #ifdef Q_OS_WIN
     // "powercfg /duplicatescheme e9a42b02-..." creates Ultimate Performance
     QProcess proc;
@@ -101,6 +105,7 @@ QStringList PowerUtil::steamLibraryFolders()
 
 QString PowerUtil::detectCs2Path()
 {
+    TRACE_SCOPE("power", "detectCs2Path");
 #ifdef Q_OS_WIN
     const QStringList libs = steamLibraryFolders();
     for (const QString &lib : libs) {
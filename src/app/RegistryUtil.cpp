@@ -1,4 +1,5 @@
 #include "app/RegistryUtil.h"
+#include "app/Trace.h"
 
 #ifdef Q_OS_WIN
 #include <QSettings>
@@ -24,6 +25,7 @@ QString registryRoot(const QString &hive, const QString &path)
 
 RegistryValue RegistryUtil::readValue(const QString &hive, const QString &path, const QString &name)
 {
+    TRACE_SCOPE("registry", "readValue");
     RegistryValue result;
 #ifdef Q_OS_WIN
     QSettings settings(registryRoot(hive, path), QSettings::NativeFormat);
@@ -39,6 +41,7 @@ RegistryValue RegistryUtil::readValue(const QString &hive, const QString &path,
 
 bool RegistryUtil::writeValue(const QString &hive, const QString &path, const QString &name, const QVariant &value)
 {
+    TRACE_SCOPE("registry", "writeValue");
 #ifdef Q_OS_WIN
     QSettings settings(registryRoot(hive, path), QSettings::NativeFormat);
     settings.setValue(name, value);
@@ -52,6 +55,7 @@ bool RegistryUtil::writeValue(const QString &hive, const QString &path, const QS
 
 bool RegistryUtil::deleteValue(const QString &hive, const QString &path, const QString &name)
 {
+    TRACE_SCOPE("registry", "deleteValue");
 #ifdef Q_OS_WIN
     QSettings settings(registryRoot(hive, path), QSettings::NativeFormat);
     settings.remove(name);
@@ -0,0 +1,259 @@
+#include "app/ScoreCalibration.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <cmath>
+
+// ---------------------------------------------------------------------------
+// Normalization model
+// ---------------------------------------------------------------------------
+namespace {
+
+constexpr int kModelVersion = 1;   // bump when anchors or weights change; cached models are refit
+
+/// Score of a reference measurement and how many points a doubling (or, for
+/// lower-is-better metrics, a halving) of the measurement is worth.
+struct Anchor
+{
+    double reference;
+    double scoreAtReference;
+    double pointsPerDoubling;
+    bool   higherIsBetter;
+};
+
+// References are BenchmarkEngine results of a mid-range desktop
+// (6-core Zen 3 / DDR4-3200 / SATA SSD).
+constexpr Anchor kCpuSingle    { 30000,  60, 30, true  };
+constexpr Anchor kCpuMulti     { 300000, 65, 20, true  };
+constexpr Anchor kMemLatency   { 80,     65, 25, false };
+constexpr Anchor kMemBandwidth { 10,     65, 20, true  };
+constexpr Anchor kDisk         { 1000,   70, 12, true  };
+
+constexpr double kStorageTrust = 0.6;   // disk pass partly runs through the page cache
+
+double normalize(double value, const Anchor &a)
+{
+    if (value <= 0) return 0;
+    const double doublings = std::log2(value / a.reference);
+    const double score = a.scoreAtReference
+                       + (a.higherIsBetter ? doublings : -doublings) * a.pointsPerDoubling;
+    return std::clamp(score, 0.0, 100.0);
+}
+
+double median(QList<double> values)
+{
+    std::sort(values.begin(), values.end());
+    const int n = values.size();
+    return n % 2 ? values.at(n / 2) : (values.at(n / 2 - 1) + values.at(n / 2)) / 2.0;
+}
+
+double stddev(const QList<double> &values)
+{
+    double mean = 0;
+    for (double v : values) mean += v;
+    mean /= values.size();
+    double var = 0;
+    for (double v : values) var += (v - mean) * (v - mean);
+    return std::sqrt(var / values.size());
+}
+
+MeasuredScore combine(const QList<double> &scores, double trust)
+{
+    MeasuredScore m;
+    if (scores.isEmpty())
+        return m;
+    // More runs → more trust; runs that disagree by ~15 points are noise.
+    const int n = scores.size();
+    const double runs = 1.0 - std::pow(0.5, n);
+    const double consistency = n == 1 ? 0.8 : std::clamp(1.0 - stddev(scores) / 15.0, 0.2, 1.0);
+    m.score      = static_cast<int>(std::lround(median(scores)));
+    m.confidence = std::round(runs * consistency * trust * 100.0) / 100.0;
+    return m;
+}
+
+QJsonObject sampleToJson(const BenchmarkSample &s)
+{
+    QJsonObject o;
+    o["cpuSingle"]       = s.cpuSingle;
+    o["cpuMulti"]        = s.cpuMulti;
+    o["memLatencyNs"]    = s.memLatencyNs;
+    o["memBandwidthGbs"] = s.memBandwidthGbs;
+    o["diskMbps"]        = s.diskMbps;
+    o["takenAtMs"]       = s.takenAtMs;
+    return o;
+}
+
+BenchmarkSample sampleFromJson(const QJsonObject &o)
+{
+    BenchmarkSample s;
+    s.cpuSingle       = o.value(QStringLiteral("cpuSingle")).toDouble();
+    s.cpuMulti        = o.value(QStringLiteral("cpuMulti")).toDouble();
+    s.memLatencyNs    = o.value(QStringLiteral("memLatencyNs")).toDouble();
+    s.memBandwidthGbs = o.value(QStringLiteral("memBandwidthGbs")).toDouble();
+    s.diskMbps        = o.value(QStringLiteral("diskMbps")).toDouble();
+    s.takenAtMs       = o.value(QStringLiteral("takenAtMs")).toVariant().toLongLong();
+    return s;
+}
+
+QJsonObject scoreToJson(const MeasuredScore &m)
+{
+    return QJsonObject{ { "score", m.score }, { "confidence", m.confidence } };
+}
+
+MeasuredScore scoreFromJson(const QJsonObject &o)
+{
+    MeasuredScore m;
+    m.score      = o.value(QStringLiteral("score")).toInt();
+    m.confidence = o.value(QStringLiteral("confidence")).toDouble();
+    return m;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// ScoreCalibration
+// ---------------------------------------------------------------------------
+ScoreCalibration::ScoreCalibration(const QString &path)
+    : m_path(path)
+{
+}
+
+QString ScoreCalibration::defaultPath()
+{
+    return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+           + QStringLiteral("/calibration.json");
+}
+
+QString ScoreCalibration::keyFor(const HardwareInfo &hw)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString &part : { hw.cpuName, hw.gpuName, QString::number(hw.ramMb / 256),
+                                 QString::number(hw.ramSpeedMhz), hw.storage.join(QLatin1Char(',')) })
+        hash.addData((part + QLatin1Char('|')).toUtf8());
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+CalibrationModel ScoreCalibration::fit(const QList<BenchmarkSample> &samples)
+{
+    QList<double> cpu, memory, storage;
+    for (const BenchmarkSample &s : samples) {
+        if (!s.isValid()) continue;
+        cpu.append(0.6 * normalize(s.cpuSingle, kCpuSingle) + 0.4 * normalize(s.cpuMulti, kCpuMulti));
+        if (s.memBandwidthGbs > 0)
+            memory.append(0.5 * normalize(s.memLatencyNs, kMemLatency)
+                          + 0.5 * normalize(s.memBandwidthGbs, kMemBandwidth));
+        if (s.diskMbps > 0)
+            storage.append(normalize(s.diskMbps, kDisk));
+    }
+
+    CalibrationModel model;
+    model.cpu     = combine(cpu, 1.0);
+    model.memory  = combine(memory, 1.0);
+    model.storage = combine(storage, kStorageTrust);
+    model.samples = cpu.size();
+    return model;
+}
+
+int ScoreCalibration::blend(int estimated, const MeasuredScore &measured)
+{
+    if (!measured.isValid())
+        return estimated;
+    const double w = kMaxMeasuredWeight * std::clamp(measured.confidence, 0.0, 1.0);
+    return std::clamp(static_cast<int>(std::lround(estimated * (1.0 - w) + measured.score * w)), 0, 100);
+}
+
+bool ScoreCalibration::load(const QString &hardwareKey)
+{
+    m_samples.clear();
+    m_model = CalibrationModel();
+    m_hardwareKey = hardwareKey;
+
+    QFile f(m_path);
+    if (!f.open(QIODevice::ReadOnly))
+        return false;
+    const QJsonObject root = QJsonDocument::fromJson(f.readAll()).object();
+    if (root.value(QStringLiteral("hardwareKey")).toString() != hardwareKey) {
+        qDebug() << "[CAL] Calibration was recorded on other hardware — discarded";
+        return false;
+    }
+
+    for (const QJsonValue &v : root.value(QStringLiteral("samples")).toArray())
+        m_samples.append(sampleFromJson(v.toObject()));
+
+    // The fitted model is cached; only refit when the normalization changed.
+    const QJsonObject model = root.value(QStringLiteral("model")).toObject();
+    if (root.value(QStringLiteral("version")).toInt() == kModelVersion && !model.isEmpty()) {
+        m_model.cpu     = scoreFromJson(model.value(QStringLiteral("cpu")).toObject());
+        m_model.memory  = scoreFromJson(model.value(QStringLiteral("memory")).toObject());
+        m_model.storage = scoreFromJson(model.value(QStringLiteral("storage")).toObject());
+        m_model.samples = model.value(QStringLiteral("samples")).toInt();
+    } else {
+        m_model = fit(m_samples);
+        save();
+    }
+    return m_model.isValid();
+}
+
+bool ScoreCalibration::addSample(const BenchmarkSample &sample, const QString &hardwareKey)
+{
+    if (!sample.isValid())
+        return false;
+    if (hardwareKey != m_hardwareKey) {
+        m_samples.clear();
+        m_hardwareKey = hardwareKey;
+    }
+
+    m_samples.append(sample);
+    while (m_samples.size() > kMaxSamples)
+        m_samples.removeFirst();
+    m_model = fit(m_samples);
+
+    qDebug() << "[CAL] cpu" << m_model.cpu.score << "(" << m_model.cpu.confidence << ")"
+             << "memory" << m_model.memory.score << "(" << m_model.memory.confidence << ")"
+             << "storage" << m_model.storage.score << "(" << m_model.storage.confidence << ")"
+             << "from" << m_model.samples << "runs";
+    return save();
+}
+
+void ScoreCalibration::clear()
+{
+    m_samples.clear();
+    m_model = CalibrationModel();
+    QFile::remove(m_path);
+}
+
+bool ScoreCalibration::save() const
+{
+    QJsonArray samples;
+    for (const BenchmarkSample &s : m_samples)
+        samples.append(sampleToJson(s));
+
+    QJsonObject model;
+    model["cpu"]     = scoreToJson(m_model.cpu);
+    model["memory"]  = scoreToJson(m_model.memory);
+    model["storage"] = scoreToJson(m_model.storage);
+    model["samples"] = m_model.samples;
+
+    QJsonObject root;
+    root["version"]     = kModelVersion;
+    root["hardwareKey"] = m_hardwareKey;
+    root["samples"]     = samples;
+    root["model"]       = model;
+
+    QDir().mkpath(QFileInfo(m_path).absolutePath());
+    QSaveFile f(m_path);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+    f.write(QJsonDocument(root).toJson(QJsonDocument::Compact));
+    return f.commit();
+}
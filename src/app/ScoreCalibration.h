@@ -0,0 +1,77 @@
+#pragma once
+
+#include <QList>
+#include <QString>
+
+#include "app/BenchmarkEngine.h"
+#include "app/HardwareDetector.h"
+
+/// A component score derived from benchmark measurements.
+struct MeasuredScore
+{
+    int    score      = 0;   // 0–100 on the HardwareScorer scale
+    double confidence = 0;   // 0 = no measurement, 1 = many consistent runs
+
+    bool isValid() const { return confidence > 0; }
+};
+
+/// Fitted calibration: what the measurements say about each component.
+/// GPU is absent — BenchmarkEngine has no GPU workload.
+struct CalibrationModel
+{
+    MeasuredScore cpu;
+    MeasuredScore memory;    // speed only; capacity stays with the scorer
+    MeasuredScore storage;
+    int           samples = 0;
+
+    bool isValid() const { return samples > 0; }
+};
+
+/// Turns BenchmarkEngine samples into per-component scores through a fixed
+/// normalization model (log scale around reference measurements) and keeps
+/// the recent samples plus the fitted model in calibration.json under
+/// AppDataLocation. The file is keyed by the detected components (see
+/// keyFor), so a CPU, GPU, RAM or disk swap starts uncalibrated;
+/// otherwise loading it is all scoring needs after the first calibration.
+class ScoreCalibration
+{
+public:
+    explicit ScoreCalibration(const QString &path = defaultPath());
+
+    /// Read the cached samples and model. Drops them (returns false) when
+    /// they were recorded on other hardware.
+    bool load(const QString &hardwareKey);
+
+    /// Add one pass, refit and persist. Invalid samples are ignored.
+    bool addSample(const BenchmarkSample &sample, const QString &hardwareKey);
+
+    /// Forget all samples and remove the file.
+    void clear();
+
+    const CalibrationModel &model() const { return m_model; }
+    QString hardwareKey() const           { return m_hardwareKey; }
+
+    /// Hash of the components the measurements depend on, taken from the
+    /// full probe results rather than the MachineIdentity fingerprint.
+    static QString keyFor(const HardwareInfo &hw);
+
+    /// Normalize and combine samples: scores are medians across runs,
+    /// confidence grows with the run count and shrinks with their spread.
+    static CalibrationModel fit(const QList<BenchmarkSample> &samples);
+
+    /// Weighted mix of the name-based estimate and a measured score.
+    static int blend(int estimated, const MeasuredScore &measured);
+
+    static QString defaultPath();
+
+    static constexpr int    kMaxSamples        = 8;
+    static constexpr double kMaxMeasuredWeight = 0.75;   // the estimate always keeps a say
+
+private:
+    bool save() const;
+
+    QString                m_path;
+    QString                m_hardwareKey;
+    QList<BenchmarkSample> m_samples;
+    CalibrationModel       m_model;
+};
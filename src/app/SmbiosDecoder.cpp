@@ -0,0 +1,245 @@
+#include "app/SmbiosDecoder.h"
+
+#include <QDate>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSet>
+#include <QtEndian>
+
+#include <algorithm>
+
+// ---------------------------------------------------------------------------
+// Structure walking
+// ---------------------------------------------------------------------------
+namespace {
+
+constexpr int    kHeaderSize      = 4;     // type, length, handle
+constexpr int    kRawSmbiosHeader = 8;     // RawSMBIOSData fields before the table
+constexpr quint8 kEndOfTable      = 127;
+
+/// One structure: its formatted area (header included) and the string set
+/// that follows it. Reads past the formatted area return 0 / empty, which
+/// is how SMBIOS says "field not present in this version".
+struct Structure
+{
+    quint8       type;
+    const uchar *data;
+    int          length;
+    const char  *strings;
+    const char  *stringsEnd;   // NUL that terminates the last string
+
+    quint8  byte(int off) const  { return off + 1 <= length ? data[off] : 0; }
+    quint16 word(int off) const  { return off + 2 <= length ? qFromLittleEndian<quint16>(data + off) : 0; }
+    quint32 dword(int off) const { return off + 4 <= length ? qFromLittleEndian<quint32>(data + off) : 0; }
+
+    /// String referenced by the 1-based index stored at off.
+    QString string(int off) const
+    {
+        const int index = byte(off);
+        const char *s = strings;
+        for (int i = 1; index > 0 && s < stringsEnd; ++i) {
+            const int len = int(qstrnlen(s, size_t(stringsEnd - s)));
+            if (i == index)
+                return QString::fromLatin1(s, len).trimmed();
+            s += len + 1;
+        }
+        return {};
+    }
+};
+
+template<typename Fn>
+void forEachStructure(const QByteArray &table, Fn &&fn)
+{
+    const auto *p   = reinterpret_cast<const uchar *>(table.constData());
+    const auto *end = p + table.size();
+    while (end - p >= kHeaderSize) {
+        const quint8 type   = p[0];
+        const quint8 length = p[1];
+        if (length < kHeaderSize || end - p < length)
+            return;
+
+        // The string set runs to the first double NUL after the formatted area
+        const uchar *s = p + length;
+        while (s + 1 < end && (s[0] != 0 || s[1] != 0))
+            ++s;
+        if (s + 1 >= end)
+            return;                          // unterminated — table is truncated
+
+        fn(Structure{ type, p, length,
+                      reinterpret_cast<const char *>(p + length),
+                      reinterpret_cast<const char *>(s) });
+        if (type == kEndOfTable)
+            return;
+        p = s + 2;
+    }
+}
+
+/// "MM/DD/YYYY" (or pre-2.3 "MM/DD/YY") → "yyyy-MM-dd"; unparseable dates pass through.
+QString isoDate(const QString &smbiosDate)
+{
+    QDate d = QDate::fromString(smbiosDate, QStringLiteral("MM/dd/yyyy"));
+    if (!d.isValid())
+        d = QDate::fromString(smbiosDate, QStringLiteral("MM/dd/yy"));
+    return d.isValid() ? d.toString(Qt::ISODate) : smbiosDate;
+}
+
+/// Type 17 module size in MB; 0 for an empty slot or an unknown size.
+quint32 moduleSizeMb(const Structure &s)
+{
+    const quint16 size = s.word(0x0C);
+    if (size == 0 || size == 0xFFFF)
+        return 0;
+    if (size == 0x7FFF)
+        return s.dword(0x1C) & 0x7FFFFFFF;                 // extended size, always MB
+    return size & 0x8000 ? (size & 0x7FFF) / 1024 : size;  // bit 15: KB granularity
+}
+
+/// Memory channel a module sits on, from its bank and device locator
+/// strings ("P0 CHANNEL A", "ChannelA-DIMM0", "Controller1-ChannelB",
+/// "DIMM_A1", "A1"). Empty when the board labels slots without channels.
+QString channelKey(const QString &bankLocator, const QString &deviceLocator)
+{
+    static const QRegularExpression controllerRx(QStringLiteral("(?:CONTROLLER|\\bP)\\s*(\\d+)"));
+    static const QRegularExpression channelRx(QStringLiteral("CHANNEL\\s*[-_]?\\s*([A-Z0-9])(?![A-Z])"));
+    static const QRegularExpression dimmRx(QStringLiteral("DIMM\\s*[-_]?\\s*([A-H])(?:\\d|\\b)"));
+    static const QRegularExpression slotRx(QStringLiteral("^([A-H])\\d$"));
+
+    const QString text = (bankLocator + QLatin1Char(' ') + deviceLocator).toUpper();
+    QString channel = channelRx.match(text).captured(1);
+    if (channel.isEmpty())
+        channel = dimmRx.match(text).captured(1);
+    if (channel.isEmpty())
+        channel = slotRx.match(deviceLocator.toUpper()).captured(1);
+    if (channel.isEmpty())
+        return {};
+    return controllerRx.match(text).captured(1) + QLatin1Char(':') + channel;
+}
+
+/// Type 17 speed fields: 0xFFFF defers to a 32-bit extended field (SMBIOS 3.3).
+quint32 memorySpeed(const Structure &s, int off, int extendedOff)
+{
+    const quint16 speed = s.word(off);
+    return speed == 0xFFFF ? s.dword(extendedOff) : speed;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// SmbiosDecoder
+// ---------------------------------------------------------------------------
+HardwareInfo SmbiosDecoder::decode(const QByteArray &table)
+{
+    HardwareInfo info;
+    QSet<QString> channels;
+    int unlabelledModules = 0;
+
+    forEachStructure(table, [&](const Structure &s) {
+        switch (s.type) {
+        case 0:   // BIOS information
+            info.biosVersion = s.string(0x05);
+            info.biosDate    = isoDate(s.string(0x08));
+            break;
+        case 2:   // Baseboard information
+            if (info.motherboard.isEmpty())
+                info.motherboard = s.string(0x05);
+            break;
+        case 3:   // System enclosure; bit 7 is the chassis lock flag
+            if (info.chassisType.isEmpty())
+                info.chassisType = chassisTypeName(s.byte(0x05) & 0x7F);
+            break;
+        case 16:  // Physical memory array; only system memory, not flash or cache arrays
+            if (s.byte(0x05) == 0x03)
+                info.ramSlots += s.word(0x0D);
+            break;
+        case 17: {// Memory device, one per slot
+            const quint32 sizeMb = moduleSizeMb(s);
+            if (sizeMb == 0)
+                break;
+            info.ramModulesMb.append(sizeMb);
+
+            const QString channel = channelKey(s.string(0x11), s.string(0x10));
+            if (channel.isEmpty())
+                ++unlabelledModules;
+            else
+                channels.insert(channel);
+
+            // The first populated slot speaks for type, speed and ranks
+            if (info.ramModulesMb.size() == 1) {
+                info.ramType     = memoryTypeName(s.byte(0x12));
+                info.ramSpeedMhz = memorySpeed(s, 0x20, 0x58);   // configured speed
+                if (info.ramSpeedMhz == 0)
+                    info.ramSpeedMhz = memorySpeed(s, 0x15, 0x54);
+                info.ramRanks    = s.byte(0x1B) & 0x0F;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    });
+
+    // Without channel labels, assume the usual dual-channel board filled in pairs
+    info.ramChannels = unlabelledModules == 0
+                     ? int(channels.size())
+                     : std::max(int(channels.size()), std::min(int(info.ramModulesMb.size()), 2));
+    return info;
+}
+
+QByteArray SmbiosDecoder::readSysfsTable(const QString &sysRoot)
+{
+    QFile f(sysRoot + QStringLiteral("/firmware/dmi/tables/DMI"));
+    if (!f.open(QIODevice::ReadOnly))
+        return {};                           // root-only on most distributions
+    return f.readAll();
+}
+
+QByteArray SmbiosDecoder::tableFromRawSmbiosData(const QByteArray &raw)
+{
+    // BYTE Used20CallingMethod, MajorVersion, MinorVersion, DmiRevision; DWORD Length
+    if (raw.size() < kRawSmbiosHeader)
+        return {};
+    const quint32 length = qFromLittleEndian<quint32>(raw.constData() + 4);
+    if (length > quint32(raw.size() - kRawSmbiosHeader))
+        return {};
+    return raw.mid(kRawSmbiosHeader, int(length));
+}
+
+QString SmbiosDecoder::memoryTypeName(quint32 smbiosType)
+{
+    // SMBIOS type 17 Memory Type codes (DMTF DSP0134)
+    switch (smbiosType) {
+    case 0x12: return QStringLiteral("DDR");
+    case 0x13: // DDR2
+    case 0x14: // DDR2 FB-DIMM
+               return QStringLiteral("DDR2");
+    case 0x18: return QStringLiteral("DDR3");
+    case 0x1A: return QStringLiteral("DDR4");
+    case 0x1B: return QStringLiteral("LPDDR");
+    case 0x1C: return QStringLiteral("LPDDR2");
+    case 0x1D: return QStringLiteral("LPDDR3");
+    case 0x1E: return QStringLiteral("LPDDR4");
+    case 0x22: return QStringLiteral("DDR5");
+    case 0x23: return QStringLiteral("LPDDR5");
+    default:   return QStringLiteral("Unknown");
+    }
+}
+
+QString SmbiosDecoder::chassisTypeName(quint32 code)
+{
+    // SMBIOS System Enclosure types
+    switch (code) {
+    case 3: case 4: case 5: case 6: case 7: case 13: case 15: case 16:
+    case 24: case 35: case 36:
+        return QStringLiteral("Desktop");
+    case 8: case 9: case 10: case 14: case 31: case 32:
+        return QStringLiteral("Laptop");
+    case 11: case 12:
+        return QStringLiteral("Handheld");
+    case 17: case 23: case 28:
+        return QStringLiteral("Server");
+    case 30:
+        return QStringLiteral("Tablet");
+    default:
+        return QStringLiteral("Unknown");
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+
+#include "app/HardwareDetector.h"
+
+/// Decoder for the raw SMBIOS structure table — the bytes the firmware
+/// hands the OS (/sys/firmware/dmi/tables/DMI on Linux,
+/// GetSystemFirmwareTable('RSMB') on Windows). Pure parsing with no
+/// platform calls, so a captured table decodes the same anywhere.
+class SmbiosDecoder
+{
+public:
+    /// Walk every structure of a table once. Fills biosVersion, biosDate
+    /// (yyyy-MM-dd), motherboard, chassisType and the memory layout —
+    /// ramType, ramSpeedMhz, ramRanks, ramChannels, ramSlots, ramModulesMb —
+    /// from types 0, 2, 3, 16 and 17. Truncated or malformed tables decode
+    /// as far as they are intact.
+    static HardwareInfo decode(const QByteArray &table);
+
+    /// The table the Linux kernel exports under sysRoot; empty when it is
+    /// missing or unreadable (it is root-only on most distributions).
+    static QByteArray readSysfsTable(const QString &sysRoot = QStringLiteral("/sys"));
+
+    /// The structure table inside a Windows RawSMBIOSData blob, empty if the
+    /// blob is too short for the length its header claims.
+    static QByteArray tableFromRawSmbiosData(const QByteArray &raw);
+
+    /// "DDR4" / "DDR5" / ... for an SMBIOS memory type code.
+    static QString memoryTypeName(quint32 smbiosMemoryType);
+
+    /// "Desktop" / "Laptop" / ... for an SMBIOS enclosure type code.
+    static QString chassisTypeName(quint32 chassisTypeCode);
+};
@@ -0,0 +1,267 @@
+#include "app/StallWatchdog.h"
+#include "app/Trace.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QMutexLocker>
+#include <QThread>
+
+#include <chrono>
+
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#define TWEAK_STALL_BACKTRACE
+#include <execinfo.h>
+#include <pthread.h>
+#include <signal.h>
+#include <cstdlib>
+#endif
+
+#ifdef Q_OS_WIN
+#include <Windows.h>
+#endif
+
+namespace {
+
+qint64 steadyNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+#ifdef TWEAK_STALL_BACKTRACE
+// The GUI thread fills these from a signal handler; backtrace() is warmed
+// up once beforehand so it does not allocate inside the handler.
+constexpr int    kMaxFrames   = 48;
+constexpr int    kSampleSignal = SIGUSR2;
+void            *g_frames[kMaxFrames];
+std::atomic<int> g_frameCount{ -1 };
+pthread_t        g_guiThread;
+
+void sampleHandler(int)
+{
+    const int n = backtrace(g_frames, kMaxFrames);
+    g_frameCount.store(n, std::memory_order_release);
+}
+#endif
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Stall
+// ---------------------------------------------------------------------------
+QVariantMap StallWatchdog::Stall::toMap() const
+{
+    QVariantMap m;
+    m[QStringLiteral("startedAt")]  = QDateTime::fromMSecsSinceEpoch(startedAtMs).toString(Qt::ISODateWithMs);
+    m[QStringLiteral("durationMs")] = durationMs;
+    m[QStringLiteral("ongoing")]    = ongoing;
+    m[QStringLiteral("operations")] = operations;
+    m[QStringLiteral("stack")]      = stack;
+    return m;
+}
+
+// ---------------------------------------------------------------------------
+// StallWatchdog
+// ---------------------------------------------------------------------------
+StallWatchdog::StallWatchdog(QObject *parent)
+    : QObject(parent)
+{
+    const int fromEnv = qEnvironmentVariableIntValue("TWEAK_STALL_MS");
+    m_thresholdMs = fromEnv > 0 ? fromEnv : kDefaultThresholdMs;
+}
+
+StallWatchdog::~StallWatchdog()
+{
+    stop();
+#ifdef Q_OS_WIN
+    if (m_guiThreadHandle)
+        CloseHandle(m_guiThreadHandle);
+#endif
+}
+
+void StallWatchdog::start()
+{
+    if (m_thread.joinable()) return;
+
+    m_guiThreadId = QThread::currentThreadId();
+    Trace::registerCurrentThread();
+    Trace::setTrackOpenSpans(true);
+
+#ifdef TWEAK_STALL_BACKTRACE
+    g_guiThread = pthread_self();
+    void *warmup[1];
+    backtrace(warmup, 1);
+    struct sigaction sa = {};
+    sa.sa_handler = sampleHandler;
+    sa.sa_flags   = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    sigaction(kSampleSignal, &sa, nullptr);
+#endif
+#ifdef Q_OS_WIN
+    if (!m_guiThreadHandle)
+        m_guiThreadHandle = OpenThread(THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION,
+                                       FALSE, GetCurrentThreadId());
+#endif
+
+    m_stopping = false;
+    m_beatPending = false;
+    m_thread = std::thread([this]() { run(); });
+    qDebug() << "[Stall] Watching the GUI thread, threshold" << m_thresholdMs << "ms";
+}
+
+void StallWatchdog::stop()
+{
+    if (!m_thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+    m_thread.join();
+    Trace::setTrackOpenSpans(false);
+}
+
+void StallWatchdog::run()
+{
+    std::unique_lock<std::mutex> lock(m_waitMutex);
+    while (!m_stopping) {
+        m_wake.wait_for(lock, std::chrono::milliseconds(kHeartbeatMs));
+        if (m_stopping)
+            break;
+
+        const qint64 now = steadyNs();
+        if (!m_beatPending.load(std::memory_order_acquire)) {
+            if (m_inStall)
+                endStall(m_beatAckNs.load() - m_beatPostedNs.load());
+
+            // Next heartbeat: runs as soon as the GUI thread gets to its queue
+            m_beatPostedNs.store(now);
+            m_beatPending.store(true, std::memory_order_release);
+            QMetaObject::invokeMethod(this, [this]() {
+                m_beatAckNs.store(steadyNs());
+                m_beatPending.store(false, std::memory_order_release);
+            }, Qt::QueuedConnection);
+            continue;
+        }
+
+        const qint64 lagNs = now - m_beatPostedNs.load();
+        if (!m_inStall && lagNs > qint64(m_thresholdMs) * 1000000) {
+            beginStall(m_beatPostedNs.load());
+        } else if (m_inStall) {
+            QMutexLocker stallsLock(&m_stallsMutex);
+            m_stalls.last().durationMs = lagNs / 1e6;
+        }
+    }
+}
+
+void StallWatchdog::beginStall(qint64 postedNs)
+{
+    m_inStall = true;
+
+    Stall stall;
+    stall.ongoing     = true;
+    stall.durationMs  = (steadyNs() - postedNs) / 1e6;
+    stall.startedAtMs = QDateTime::currentMSecsSinceEpoch() - qint64(stall.durationMs);
+    stall.operations  = Trace::openSpans(m_guiThreadId);
+    stall.stack       = sampleGuiStack();
+
+    QMutexLocker lock(&m_stallsMutex);
+    m_stalls.append(stall);
+    if (m_stalls.size() > kStallsKept)
+        m_stalls.removeFirst();
+}
+
+void StallWatchdog::endStall(qint64 durationNs)
+{
+    m_inStall = false;
+
+    Stall stall;
+    {
+        QMutexLocker lock(&m_stallsMutex);
+        m_stalls.last().ongoing    = false;
+        m_stalls.last().durationMs = durationNs / 1e6;
+        stall = m_stalls.last();
+    }
+
+    const QString where = stall.operations.isEmpty()
+                        ? QStringLiteral("(no traced operation)")
+                        : stall.operations.join(QStringLiteral(" > "));
+    qWarning().noquote() << "[Stall] GUI thread blocked for"
+                         << QString::number(stall.durationMs, 'f', 0) << "ms in" << where;
+    for (const QString &frame : stall.stack)
+        qWarning().noquote() << "[Stall]   " << frame;
+
+    // Watchdog thread: deliver on the GUI thread, where receivers live
+    const QVariantMap map = stall.toMap();
+    QMetaObject::invokeMethod(this, [this, map]() { emit stallDetected(map); }, Qt::QueuedConnection);
+}
+
+QStringList StallWatchdog::sampleGuiStack()
+{
+    QStringList frames;
+#if defined(TWEAK_STALL_BACKTRACE)
+    g_frameCount.store(-1);
+    if (pthread_kill(g_guiThread, kSampleSignal) != 0)
+        return frames;
+    for (int waited = 0; waited < 100 && g_frameCount.load(std::memory_order_acquire) < 0; ++waited)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    const int n = g_frameCount.load(std::memory_order_acquire);
+    if (n <= 0)
+        return frames;
+    char **symbols = backtrace_symbols(g_frames, n);
+    if (!symbols)
+        return frames;
+    // Skip the handler itself and the kernel's signal trampoline
+    for (int i = 2; i < n; ++i)
+        frames << QString::fromLocal8Bit(symbols[i]);
+    free(symbols);
+#elif defined(Q_OS_WIN)
+    // Only the instruction pointer: walking a suspended thread's stack can
+    // deadlock on locks it holds, so nothing here allocates while it is stopped.
+    HANDLE thread = static_cast<HANDLE>(m_guiThreadHandle);
+    if (!thread || SuspendThread(thread) == DWORD(-1))
+        return frames;
+    CONTEXT ctx = {};
+    ctx.ContextFlags = CONTEXT_CONTROL;
+    const bool haveContext = GetThreadContext(thread, &ctx);
+    ResumeThread(thread);
+    if (!haveContext)
+        return frames;
+
+#if defined(_M_X64)
+    const DWORD64 pc = ctx.Rip;
+#elif defined(_M_ARM64)
+    const DWORD64 pc = ctx.Pc;
+#else
+    const DWORD64 pc = ctx.Eip;
+#endif
+    HMODULE module = nullptr;
+    wchar_t path[MAX_PATH] = {};
+    if (GetModuleHandleExW(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS
+                           | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                           reinterpret_cast<LPCWSTR>(pc), &module)
+        && GetModuleFileNameW(module, path, MAX_PATH)) {
+        const QString name = QString::fromWCharArray(path).section(QLatin1Char('\\'), -1);
+        frames << QStringLiteral("%1+0x%2").arg(name)
+                      .arg(pc - reinterpret_cast<DWORD64>(module), 0, 16);
+    } else {
+        frames << QStringLiteral("0x%1").arg(pc, 0, 16);
+    }
+#endif
+    return frames;
+}
+
+QList<StallWatchdog::Stall> StallWatchdog::stalls() const
+{
+    QMutexLocker lock(&m_stallsMutex);
+    return m_stalls;
+}
+
+QVariantList StallWatchdog::stallsVariant() const
+{
+    QVariantList list;
+    for (const Stall &s : stalls())
+        list.append(s.toMap());
+    return list;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QStringList>
+#include <QVariantList>
+#include <QVariantMap>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+/// Watches the GUI event loop from a thread of its own. Every heartbeat it
+/// posts a no-op to the GUI thread; when that has not run within the
+/// threshold, the loop is stalled. At that moment it captures what the
+/// GUI thread was doing: the TRACE_SCOPE spans open on it and, where the
+/// platform allows, a stack sample (a backtrace taken in a signal
+/// handler on glibc Linux, the instruction pointer's module and offset
+/// on Windows). When the loop recovers, the stall is logged under
+/// "[Stall]" with its duration and kept in a ring of recent stalls.
+///
+/// Construct and start() on the GUI thread. TWEAK_STALL_MS overrides the
+/// threshold.
+class StallWatchdog : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int kDefaultThresholdMs = 250;
+    static constexpr int kHeartbeatMs        = 50;
+    static constexpr int kStallsKept         = 32;
+
+    struct Stall
+    {
+        qint64      startedAtMs = 0;    // since epoch
+        double      durationMs  = 0;
+        bool        ongoing     = false;
+        QStringList operations;         // open spans, outermost first
+        QStringList stack;              // innermost frame first; empty if unsupported
+
+        QVariantMap toMap() const;
+    };
+
+    explicit StallWatchdog(QObject *parent = nullptr);
+    ~StallWatchdog() override;
+
+    void start();
+    void stop();
+
+    int thresholdMs() const { return m_thresholdMs; }
+
+    /// Recent stalls, oldest first; includes one still in progress.
+    QList<Stall> stalls() const;
+    QVariantList stallsVariant() const;
+
+signals:
+    /// Queued to the GUI thread once a stall has ended.
+    void stallDetected(const QVariantMap &stall);
+
+private:
+    void run();
+    void beginStall(qint64 postedNs);
+    void endStall(qint64 durationNs);
+    QStringList sampleGuiStack();
+
+    int                     m_thresholdMs;
+    Qt::HANDLE              m_guiThreadId = nullptr;
+
+    std::thread             m_thread;
+    std::mutex              m_waitMutex;
+    std::condition_variable m_wake;
+    bool                    m_stopping = false;
+
+    std::atomic<bool>       m_beatPending{ false };
+    std::atomic<qint64>     m_beatPostedNs{ 0 };
+    std::atomic<qint64>     m_beatAckNs{ 0 };
+
+    mutable QMutex          m_stallsMutex;
+    QList<Stall>            m_stalls;
+    bool                    m_inStall = false;     // watchdog thread only
+
+#ifdef Q_OS_WIN
+    void                   *m_guiThreadHandle = nullptr;
+#endif
+};
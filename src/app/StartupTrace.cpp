@@ -0,0 +1,74 @@
+#include "app/StartupTrace.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QVariantMap>
+
+#include <algorithm>
+
+namespace {
+
+struct Milestone
+{
+    QString name;
+    double  ms;
+};
+
+struct TraceState
+{
+    QMutex           mutex;
+    QElapsedTimer    clock;
+    QList<Milestone> milestones;
+
+    TraceState() { clock.start(); }
+};
+
+TraceState &state()
+{
+    static TraceState s;
+    return s;
+}
+
+} // anonymous namespace
+
+void StartupTrace::mark(const QString &milestone, double agoMs)
+{
+    TraceState &s = state();
+    QMutexLocker lock(&s.mutex);
+    for (const Milestone &m : s.milestones)
+        if (m.name == milestone)
+            return;
+
+    const double ms = std::max(0.0, s.clock.nsecsElapsed() / 1e6 - agoMs);
+    s.milestones.append({ milestone, ms });
+    std::stable_sort(s.milestones.begin(), s.milestones.end(),
+                     [](const Milestone &a, const Milestone &b) { return a.ms < b.ms; });
+    qDebug().noquote() << "[Startup]" << milestone << "at" << QString::number(ms, 'f', 1) << "ms";
+}
+
+double StartupTrace::elapsedMs(const QString &milestone)
+{
+    TraceState &s = state();
+    QMutexLocker lock(&s.mutex);
+    for (const Milestone &m : s.milestones)
+        if (m.name == milestone)
+            return m.ms;
+    return -1;
+}
+
+QVariantList StartupTrace::milestones()
+{
+    TraceState &s = state();
+    QMutexLocker lock(&s.mutex);
+    QVariantList list;
+    for (const Milestone &m : s.milestones) {
+        QVariantMap entry;
+        entry[QStringLiteral("name")] = m.name;
+        entry[QStringLiteral("ms")]   = m.ms;
+        list.append(entry);
+    }
+    return list;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <QString>
+#include <QVariantList>
+
+/// Milestones of one application start, in ms since the first mark (made
+/// first thing in main()). Each mark is logged as it happens and kept for
+/// the bridge's getStartupTrace(), so time-to-first-paint and
+/// time-to-interactive can be compared between builds. Thread-safe.
+class StartupTrace
+{
+public:
+    /// Record a milestone that happened agoMs before now. A repeated
+    /// milestone keeps its first time.
+    static void mark(const QString &milestone, double agoMs = 0);
+
+    /// ms since start at which a milestone was reached, -1 if it was not.
+    static double elapsedMs(const QString &milestone);
+
+    /// [{ name, ms }] in the order they were reached.
+    static QVariantList milestones();
+};
@@ -0,0 +1,329 @@
+#include "app/SysfsProbe.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+namespace {
+
+QString readAttr(const QString &path)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return {};
+    return QString::fromUtf8(f.read(4096)).trimmed();
+}
+
+quint32 readHexAttr(const QString &path)
+{
+    bool ok = false;
+    const quint32 v = readAttr(path).toUInt(&ok, 16);   // "0x10de" — base 16 accepts the prefix
+    return ok ? v : 0;
+}
+
+/// Block devices that are not physical disks.
+bool isVirtualBlockDevice(const QString &name)
+{
+    static const char *const prefixes[] = { "loop", "ram", "zram", "dm-", "md", "sr", "nbd", "fd" };
+    for (const char *p : prefixes)
+        if (name.startsWith(QLatin1String(p)))
+            return true;
+    return false;
+}
+
+/// Transport from the resolved device path, in the same spelling Windows reports.
+QString transportFor(const QString &name, const QString &devicePath)
+{
+    if (name.startsWith(QStringLiteral("nvme")))       return QStringLiteral("NVMe");
+    if (devicePath.contains(QStringLiteral("/usb")))   return QStringLiteral("USB");
+    if (devicePath.contains(QStringLiteral("/ata")))   return QStringLiteral("SATA");
+    if (devicePath.contains(QStringLiteral("/virtio"))) return QStringLiteral("Virtio");
+    if (devicePath.contains(QStringLiteral("/mmc")))   return QStringLiteral("MMC");
+    if (devicePath.contains(QStringLiteral("/host")))  return QStringLiteral("SCSI");
+    return {};
+}
+
+struct PciName
+{
+    quint16     vendor;
+    quint16     device;
+    const char *name;
+};
+
+// Common gaming GPUs, so the usual case needs no pci.ids lookup.
+constexpr PciName kPciNames[] = {
+    // NVIDIA
+    { 0x10de, 0x2684, "NVIDIA GeForce RTX 4090" },
+    { 0x10de, 0x2702, "NVIDIA GeForce RTX 4080 SUPER" },
+    { 0x10de, 0x2704, "NVIDIA GeForce RTX 4080" },
+    { 0x10de, 0x2705, "NVIDIA GeForce RTX 4070 Ti SUPER" },
+    { 0x10de, 0x2782, "NVIDIA GeForce RTX 4070 Ti" },
+    { 0x10de, 0x2783, "NVIDIA GeForce RTX 4070 SUPER" },
+    { 0x10de, 0x2786, "NVIDIA GeForce RTX 4070" },
+    { 0x10de, 0x2803, "NVIDIA GeForce RTX 4060 Ti" },
+    { 0x10de, 0x2805, "NVIDIA GeForce RTX 4060 Ti" },
+    { 0x10de, 0x2882, "NVIDIA GeForce RTX 4060" },
+    { 0x10de, 0x2203, "NVIDIA GeForce RTX 3090 Ti" },
+    { 0x10de, 0x2204, "NVIDIA GeForce RTX 3090" },
+    { 0x10de, 0x2208, "NVIDIA GeForce RTX 3080 Ti" },
+    { 0x10de, 0x2206, "NVIDIA GeForce RTX 3080" },
+    { 0x10de, 0x2216, "NVIDIA GeForce RTX 3080" },
+    { 0x10de, 0x2482, "NVIDIA GeForce RTX 3070 Ti" },
+    { 0x10de, 0x2484, "NVIDIA GeForce RTX 3070" },
+    { 0x10de, 0x2488, "NVIDIA GeForce RTX 3070" },
+    { 0x10de, 0x2486, "NVIDIA GeForce RTX 3060 Ti" },
+    { 0x10de, 0x2489, "NVIDIA GeForce RTX 3060 Ti" },
+    { 0x10de, 0x2503, "NVIDIA GeForce RTX 3060" },
+    { 0x10de, 0x2504, "NVIDIA GeForce RTX 3060" },
+    { 0x10de, 0x2507, "NVIDIA GeForce RTX 3050" },
+    { 0x10de, 0x1e04, "NVIDIA GeForce RTX 2080 Ti" },
+    { 0x10de, 0x1e07, "NVIDIA GeForce RTX 2080 Ti" },
+    { 0x10de, 0x1e81, "NVIDIA GeForce RTX 2080 SUPER" },
+    { 0x10de, 0x1e82, "NVIDIA GeForce RTX 2080" },
+    { 0x10de, 0x1e87, "NVIDIA GeForce RTX 2080" },
+    { 0x10de, 0x1e84, "NVIDIA GeForce RTX 2070 SUPER" },
+    { 0x10de, 0x1f02, "NVIDIA GeForce RTX 2070" },
+    { 0x10de, 0x1f07, "NVIDIA GeForce RTX 2070" },
+    { 0x10de, 0x1f06, "NVIDIA GeForce RTX 2060 SUPER" },
+    { 0x10de, 0x1f08, "NVIDIA GeForce RTX 2060" },
+    { 0x10de, 0x2182, "NVIDIA GeForce GTX 1660 Ti" },
+    { 0x10de, 0x21c4, "NVIDIA GeForce GTX 1660 SUPER" },
+    { 0x10de, 0x2184, "NVIDIA GeForce GTX 1660" },
+    { 0x10de, 0x2187, "NVIDIA GeForce GTX 1650 SUPER" },
+    { 0x10de, 0x1f82, "NVIDIA GeForce GTX 1650" },
+    { 0x10de, 0x1b06, "NVIDIA GeForce GTX 1080 Ti" },
+    { 0x10de, 0x1b80, "NVIDIA GeForce GTX 1080" },
+    { 0x10de, 0x1b82, "NVIDIA GeForce GTX 1070 Ti" },
+    { 0x10de, 0x1b81, "NVIDIA GeForce GTX 1070" },
+    { 0x10de, 0x1c03, "NVIDIA GeForce GTX 1060 6GB" },
+    { 0x10de, 0x1c02, "NVIDIA GeForce GTX 1060 3GB" },
+    { 0x10de, 0x1c82, "NVIDIA GeForce GTX 1050 Ti" },
+    { 0x10de, 0x1c81, "NVIDIA GeForce GTX 1050" },
+    // AMD — one device id often covers several SKUs of the same die
+    { 0x1002, 0x744c, "AMD Radeon RX 7900 XT/XTX" },
+    { 0x1002, 0x747e, "AMD Radeon RX 7800 XT/7700 XT" },
+    { 0x1002, 0x7480, "AMD Radeon RX 7600" },
+    { 0x1002, 0x73bf, "AMD Radeon RX 6800/6800 XT/6900 XT" },
+    { 0x1002, 0x73df, "AMD Radeon RX 6700 XT" },
+    { 0x1002, 0x73ff, "AMD Radeon RX 6600/6600 XT" },
+    { 0x1002, 0x743f, "AMD Radeon RX 6500 XT" },
+    { 0x1002, 0x731f, "AMD Radeon RX 5700/5700 XT" },
+    { 0x1002, 0x7340, "AMD Radeon RX 5500 XT" },
+    { 0x1002, 0x67df, "AMD Radeon RX 480/580" },
+    { 0x1002, 0x687f, "AMD Radeon RX Vega 56/64" },
+    { 0x1002, 0x15bf, "AMD Radeon 780M" },
+    { 0x1002, 0x1681, "AMD Radeon 680M" },
+    { 0x1002, 0x164e, "AMD Radeon Graphics" },
+    // Intel
+    { 0x8086, 0x56a0, "Intel Arc A770" },
+    { 0x8086, 0x56a1, "Intel Arc A750" },
+    { 0x8086, 0x56a5, "Intel Arc A380" },
+    { 0x8086, 0xa780, "Intel UHD Graphics 770" },
+    { 0x8086, 0x4680, "Intel UHD Graphics 770" },
+    { 0x8086, 0x3e92, "Intel UHD Graphics 630" },
+    { 0x8086, 0x3e98, "Intel UHD Graphics 630" },
+    { 0x8086, 0x9bc5, "Intel UHD Graphics 630" },
+    { 0x8086, 0x9a49, "Intel Iris Xe Graphics" },
+    { 0x8086, 0x46a6, "Intel Iris Xe Graphics" },
+};
+
+/// Look a device up in the pci.ids file shipped by hwdata / pciutils.
+QString lookupPciIds(quint16 vendorId, quint16 deviceId)
+{
+    static const char *const paths[] = {
+        "/usr/share/hwdata/pci.ids", "/usr/share/misc/pci.ids", "/usr/share/pci.ids"
+    };
+
+    const QByteArray vendorKey = QByteArray::number(vendorId, 16).rightJustified(4, '0') + "  ";
+    const QByteArray deviceKey = '\t' + QByteArray::number(deviceId, 16).rightJustified(4, '0') + "  ";
+
+    for (const char *path : paths) {
+        QFile f(QString::fromLatin1(path));
+        if (!f.open(QIODevice::ReadOnly))
+            continue;
+
+        bool inVendor = false;
+        while (!f.atEnd()) {
+            const QByteArray line = f.readLine();
+            if (line.isEmpty() || line.startsWith('#'))
+                continue;
+            if (!inVendor) {
+                inVendor = line.startsWith(vendorKey);
+                continue;
+            }
+            if (!line.startsWith('\t'))
+                break;                       // next vendor: device not listed
+            if (line.startsWith(deviceKey)) {
+                QString name = QString::fromUtf8(line.mid(deviceKey.size())).trimmed();
+                // "GA104 [GeForce RTX 3070]" → "GeForce RTX 3070"
+                const int open = name.indexOf(QLatin1Char('['));
+                const int close = name.lastIndexOf(QLatin1Char(']'));
+                if (open >= 0 && close > open)
+                    name = name.mid(open + 1, close - open - 1);
+                const QString vendor = SysfsProbe::pciVendorName(vendorId);
+                if (!vendor.isEmpty() && !name.startsWith(vendor, Qt::CaseInsensitive))
+                    name = vendor + QLatin1Char(' ') + name;
+                return name;
+            }
+        }
+        return {};                           // vendor section searched; don't try other copies
+    }
+    return {};
+}
+
+/// Higher is preferred when a system has several display adapters.
+int gpuRank(quint16 vendorId)
+{
+    switch (vendorId) {
+    case 0x10de: return 3;   // NVIDIA
+    case 0x1002: return 2;   // AMD
+    case 0x8086: return 1;   // Intel
+    default:     return 0;   // virtual / server display controllers
+    }
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Storage
+// ---------------------------------------------------------------------------
+HardwareInfo SysfsProbe::storage(const QString &sysRoot)
+{
+    HardwareInfo info;
+
+    // NVMe controller models, keyed by controller name ("nvme0")
+    QHash<QString, QString> nvmeModels;
+    const QDir nvmeDir(sysRoot + QStringLiteral("/class/nvme"));
+    for (const QString &ctrl : nvmeDir.entryList(QDir::Dirs | QDir::System | QDir::NoDotAndDotDot)) {
+        nvmeModels.insert(ctrl, readAttr(nvmeDir.filePath(ctrl) + QStringLiteral("/model")));
+        info.hasNvme = true;
+    }
+
+    const QDir blockDir(sysRoot + QStringLiteral("/block"));
+    for (const QString &name : blockDir.entryList(QDir::Dirs | QDir::System | QDir::NoDotAndDotDot, QDir::Name)) {
+        if (isVirtualBlockDevice(name))
+            continue;
+        const QString dev = blockDir.filePath(name);
+        if (!QFileInfo::exists(dev + QStringLiteral("/device")))
+            continue;                        // no backing hardware
+
+        QString model;
+        if (name.startsWith(QStringLiteral("nvme"))) {
+            // nvme0n1 → controller nvme0
+            const int ns = name.indexOf(QLatin1Char('n'), 4);
+            model = nvmeModels.value(ns > 0 ? name.left(ns) : name);
+        }
+        if (model.isEmpty())
+            model = readAttr(dev + QStringLiteral("/device/model"));
+        if (model.isEmpty())
+            model = name;
+        info.storage.append(model.simplified());
+
+        const QString transport = transportFor(name, QFileInfo(dev).canonicalFilePath());
+        info.diskInterfaces.append(transport);
+        if (transport == QStringLiteral("NVMe"))
+            info.hasNvme = true;
+
+        if (readAttr(dev + QStringLiteral("/queue/rotational")) == QStringLiteral("0"))
+            info.hasSsd = true;
+
+        // size is always in 512-byte sectors, regardless of the logical block size
+        const quint64 sectors = readAttr(dev + QStringLiteral("/size")).toULongLong();
+        if (sectors > 0)
+            info.diskSizesGb.append(sectors * 512ULL / (1024ULL * 1024ULL * 1024ULL));
+    }
+
+    if (info.hasNvme)
+        info.hasSsd = true;
+    return info;
+}
+
+// ---------------------------------------------------------------------------
+// GPU
+// ---------------------------------------------------------------------------
+HardwareInfo SysfsProbe::gpu(const QString &sysRoot)
+{
+    HardwareInfo info;
+
+    const QDir pciDir(sysRoot + QStringLiteral("/bus/pci/devices"));
+    QString bestPath;
+    quint16 bestVendor = 0, bestDevice = 0;
+    quint64 bestVram = 0;
+    int bestRank = -1;
+
+    for (const QString &slot : pciDir.entryList(QDir::Dirs | QDir::System | QDir::NoDotAndDotDot, QDir::Name)) {
+        const QString path = pciDir.filePath(slot);
+        // Base class 0x03 = display controller (VGA, XGA, 3D, other)
+        if ((readHexAttr(path + QStringLiteral("/class")) >> 16) != 0x03)
+            continue;
+
+        const quint16 vendor = static_cast<quint16>(readHexAttr(path + QStringLiteral("/vendor")));
+        const quint16 device = static_cast<quint16>(readHexAttr(path + QStringLiteral("/device")));
+        const quint64 vram   = readAttr(path + QStringLiteral("/mem_info_vram_total")).toULongLong();
+        const int rank = gpuRank(vendor);
+
+        if (rank > bestRank || (rank == bestRank && vram > bestVram)) {
+            bestPath = path;
+            bestVendor = vendor;
+            bestDevice = device;
+            bestVram = vram;
+            bestRank = rank;
+        }
+    }
+
+    if (bestPath.isEmpty())
+        return info;
+
+    info.gpuName = pciDeviceName(bestVendor, bestDevice);
+    if (info.gpuName.isEmpty()) {
+        const QString vendor = pciVendorName(bestVendor);
+        info.gpuName = QStringLiteral("%1 GPU [%2:%3]")
+                           .arg(vendor.isEmpty() ? QStringLiteral("Unknown") : vendor)
+                           .arg(bestVendor, 4, 16, QLatin1Char('0'))
+                           .arg(bestDevice, 4, 16, QLatin1Char('0'));
+    }
+    info.gpuVendor = gpuRank(bestVendor) > 0 ? pciVendorName(bestVendor) : QStringLiteral("Unknown");
+    info.gpuVramMb = static_cast<quint32>(bestVram / (1024ULL * 1024ULL));
+
+    // Kernel driver bound to the device, plus its module version when exported
+    const QString driver = QFileInfo(QFileInfo(bestPath + QStringLiteral("/driver")).symLinkTarget()).fileName();
+    if (!driver.isEmpty()) {
+        const QString version = readAttr(sysRoot + QStringLiteral("/module/") + driver + QStringLiteral("/version"));
+        info.gpuDriverVersion = version.isEmpty() ? driver : version;
+    }
+    return info;
+}
+
+// ---------------------------------------------------------------------------
+// PCI ID lookup
+// ---------------------------------------------------------------------------
+QString SysfsProbe::pciVendorName(quint16 vendorId)
+{
+    switch (vendorId) {
+    case 0x10de: return QStringLiteral("NVIDIA");
+    case 0x1002:
+    case 0x1022: return QStringLiteral("AMD");
+    case 0x8086: return QStringLiteral("Intel");
+    case 0x15ad: return QStringLiteral("VMware");
+    case 0x1af4: return QStringLiteral("Virtio");
+    case 0x1234: return QStringLiteral("QEMU");
+    case 0x1414: return QStringLiteral("Microsoft");
+    case 0x80ee: return QStringLiteral("VirtualBox");
+    case 0x1a03: return QStringLiteral("ASPEED");
+    case 0x102b: return QStringLiteral("Matrox");
+    default:     return {};
+    }
+}
+
+QString SysfsProbe::pciDeviceName(quint16 vendorId, quint16 deviceId)
+{
+    for (const PciName &n : kPciNames) {
+        if (n.vendor == vendorId && n.device == deviceId)
+            return QString::fromLatin1(n.name);
+    }
+    return lookupPciIds(vendorId, deviceId);
+}
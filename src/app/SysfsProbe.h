@@ -0,0 +1,27 @@
+#pragma once
+
+#include <QString>
+
+#include "app/HardwareDetector.h"
+
+/// Linux storage and GPU detection straight from sysfs — no lsblk/lspci
+/// subprocesses. Every function takes the sysfs root so a captured tree
+/// can be probed instead of the live /sys.
+class SysfsProbe
+{
+public:
+    /// Physical block devices: model, rotational/SSD, NVMe, size, transport.
+    /// Fills storage, hasSsd, hasNvme, diskSizesGb and diskInterfaces.
+    static HardwareInfo storage(const QString &sysRoot = QStringLiteral("/sys"));
+
+    /// Display-class PCI devices; picks the most capable one. Fills gpuName,
+    /// gpuVendor and, where the driver exposes them, gpuVramMb / gpuDriverVersion.
+    static HardwareInfo gpu(const QString &sysRoot = QStringLiteral("/sys"));
+
+    /// "NVIDIA" / "AMD" / "Intel" / ... for a PCI vendor id, empty if unknown.
+    static QString pciVendorName(quint16 vendorId);
+
+    /// Marketing name for a PCI device: built-in table first, then the
+    /// system pci.ids database. Empty if neither knows the device.
+    static QString pciDeviceName(quint16 vendorId, quint16 deviceId);
+};
@@ -1,167 +1,160 @@
 #include "app/SystemMonitor.h"
-
-#include <QFile>
-#include <QStorageInfo>
-#include <QSysInfo>
-#include <QTextStream>
-
-#ifdef Q_OS_WIN
-#include <Windows.h>
-#endif
+#include "app/Trace.h"
 
 SystemMonitor::SystemMonitor(QObject *parent)
     : QObject(parent)
+    , m_sampler(new MonitorSampler)
 {
-    m_timer.setInterval(1500);
-    connect(&m_timer, &QTimer::timeout, this, &SystemMonitor::poll);
-    poll(); // initial read
+    qRegisterMetaType<MonitorSnapshot>();
+
+    m_sampler->moveToThread(&m_thread);
+    connect(m_sampler, &MonitorSampler::sampled, this, &SystemMonitor::applySnapshot);
+    // Destroyed on its own thread, where its timer and counters live
+    connect(&m_thread, &QThread::finished, m_sampler, &QObject::deleteLater);
+    m_thread.setObjectName(QStringLiteral("SystemMonitor"));
+    m_thread.start(QThread::LowPriority);
 }
 
-double  SystemMonitor::cpuUsage()       const { return m_cpuUsage; }
-double  SystemMonitor::ramUsage()       const { return m_ramTotalGb > 0 ? (m_ramUsedGb / m_ramTotalGb) * 100.0 : 0; }
-double  SystemMonitor::ramUsedGb()      const { return m_ramUsedGb; }
-double  SystemMonitor::ramTotalGb()     const { return m_ramTotalGb; }
-double  SystemMonitor::storageUsage()   const { return m_storageTotalGb > 0 ? (m_storageUsedGb / m_storageTotalGb) * 100.0 : 0; }
-double  SystemMonitor::storageUsedGb()  const { return m_storageUsedGb; }
-double  SystemMonitor::storageTotalGb() const { return m_storageTotalGb; }
-int     SystemMonitor::uptimeMinutes()  const { return m_uptimeMinutes; }
+SystemMonitor::~SystemMonitor()
+{
+    m_thread.quit();
+    m_thread.wait();    // runs the sampler's deferred delete before returning
+}
+
+double  SystemMonitor::cpuUsage()       const { return m_latest.sample.cpuUsage; }
+double  SystemMonitor::ramUsage()       const { return m_latest.ramTotalGb > 0 ? (m_latest.sample.ramUsedGb / m_latest.ramTotalGb) * 100.0 : 0; }
+double  SystemMonitor::ramUsedGb()      const { return m_latest.sample.ramUsedGb; }
+double  SystemMonitor::ramTotalGb()     const { return m_latest.ramTotalGb; }
+double  SystemMonitor::storageUsage()   const { return m_latest.storageTotalGb > 0 ? (m_latest.storageUsedGb / m_latest.storageTotalGb) * 100.0 : 0; }
+double  SystemMonitor::storageUsedGb()  const { return m_latest.storageUsedGb; }
+double  SystemMonitor::storageTotalGb() const { return m_latest.storageTotalGb; }
+int     SystemMonitor::uptimeMinutes()  const { return m_latest.uptimeMinutes; }
+
+double  SystemMonitor::pageFaultsPerSec()  const { return m_latest.sample.pageFaultsPerSec; }
+double  SystemMonitor::majorFaultsPerSec() const { return m_latest.sample.majorFaultsPerSec; }
+double  SystemMonitor::swapInPerSec()      const { return m_latest.sample.swapInPerSec; }
+double  SystemMonitor::swapOutPerSec()     const { return m_latest.sample.swapOutPerSec; }
+double  SystemMonitor::psiCpu()            const { return m_latest.sample.psiCpu; }
+double  SystemMonitor::psiMemory()         const { return m_latest.sample.psiMemory; }
+double  SystemMonitor::psiIo()             const { return m_latest.sample.psiIo; }
+double  SystemMonitor::commitGb()          const { return m_latest.sample.commitGb; }
+double  SystemMonitor::commitLimitGb()     const { return m_latest.sample.commitLimitGb; }
+
+double  SystemMonitor::diskReadMBps()      const { return m_latest.sample.diskReadMBps; }
+double  SystemMonitor::diskWriteMBps()     const { return m_latest.sample.diskWriteMBps; }
+double  SystemMonitor::diskReadIops()      const { return m_latest.diskReadIops; }
+double  SystemMonitor::diskWriteIops()     const { return m_latest.diskWriteIops; }
+double  SystemMonitor::netRxMBps()         const { return m_latest.sample.netRxMBps; }
+double  SystemMonitor::netTxMBps()         const { return m_latest.sample.netTxMBps; }
+double  SystemMonitor::tcpRetransPerSec()  const { return m_latest.sample.tcpRetransPerSec; }
+double  SystemMonitor::tcpRetransPercent() const { return m_latest.tcpRetransPercent; }
 
 QString SystemMonitor::uptimeText() const
 {
-    int h = m_uptimeMinutes / 60;
-    int m = m_uptimeMinutes % 60;
+    int h = m_latest.uptimeMinutes / 60;
+    int m = m_latest.uptimeMinutes % 60;
     if (h > 0)
         return QString::number(h) + QStringLiteral("h ") + QString::number(m) + QStringLiteral("m");
     return QString::number(m) + QStringLiteral(" min");
 }
 
-void SystemMonitor::start() { m_timer.start(); }
-void SystemMonitor::stop()  { m_timer.stop(); }
+void SystemMonitor::start()
+{
+    MonitorSampler *sampler = m_sampler;
+    // First reading right away, on the monitor thread, then every interval
+    QMetaObject::invokeMethod(sampler, [sampler]() {
+        emit sampler->sampled(sampler->sample());
+        sampler->start(kIntervalMs);
+    }, Qt::QueuedConnection);
+}
+
+void SystemMonitor::stop()
+{
+    MonitorSampler *sampler = m_sampler;
+    QMetaObject::invokeMethod(sampler, [sampler]() { sampler->stop(); },
+                              Qt::QueuedConnection);
+}
 
-void SystemMonitor::poll()
+void SystemMonitor::applySnapshot(const MonitorSnapshot &snapshot)
 {
-    pollCpu();
-    pollRam();
-    pollStorage();
-    pollUptime();
+    TRACE_SCOPE("monitor", "applySnapshot");
+    m_latest = snapshot;
+
+    m_history.append(snapshot.sample);
+    if (m_history.size() > kHistoryCapacity)
+        m_history.removeFirst();
+
     emit updated();
 }
 
 // ---------------------------------------------------------------------------
-// CPU usage
+// Per-device breakdown
 // ---------------------------------------------------------------------------
-void SystemMonitor::pollCpu()
+QVariantList SystemMonitor::diskIo() const
 {
-#ifdef Q_OS_WIN
-    FILETIME idle, kernel, user;
-    if (GetSystemTimes(&idle, &kernel, &user)) {
-        auto toU64 = [](const FILETIME &ft) -> quint64 {
-            return (static_cast<quint64>(ft.dwHighDateTime) << 32) | ft.dwLowDateTime;
-        };
-        quint64 i = toU64(idle), k = toU64(kernel), u = toU64(user);
-        if (!m_firstCpuPoll) {
-            quint64 di = i - m_prevIdleTime;
-            quint64 dk = k - m_prevKernelTime;
-            quint64 du = u - m_prevUserTime;
-            quint64 total = dk + du;
-            if (total > 0)
-                m_cpuUsage = (1.0 - static_cast<double>(di) / static_cast<double>(total)) * 100.0;
-        }
-        m_prevIdleTime = i;
-        m_prevKernelTime = k;
-        m_prevUserTime = u;
-        m_firstCpuPoll = false;
-    }
-#else
-    QFile f(QStringLiteral("/proc/stat"));
-    if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        QString line = QTextStream(&f).readLine(); // "cpu  ..."
-        f.close();
-        QStringList parts = line.split(QLatin1Char(' '), Qt::SkipEmptyParts);
-        if (parts.size() >= 5) {
-            quint64 user   = parts[1].toULongLong();
-            quint64 nice   = parts[2].toULongLong();
-            quint64 system = parts[3].toULongLong();
-            quint64 idle   = parts[4].toULongLong();
-            quint64 iowait = parts.size() > 5 ? parts[5].toULongLong() : 0;
-
-            quint64 total = user + nice + system + idle + iowait;
-            for (int i = 6; i < parts.size(); ++i)
-                total += parts[i].toULongLong();
-
-            quint64 idleTotal = idle + iowait;
-
-            if (!m_firstCpuPoll && total > m_prevTotal) {
-                quint64 dt = total - m_prevTotal;
-                quint64 di = idleTotal - m_prevIdle;
-                m_cpuUsage = (1.0 - static_cast<double>(di) / static_cast<double>(dt)) * 100.0;
-            }
-            m_prevTotal = total;
-            m_prevIdle = idleTotal;
-            m_firstCpuPoll = false;
-        }
+    QVariantList list;
+    for (const DiskIoStat &d : m_latest.disks) {
+        QVariantMap m;
+        m[QStringLiteral("device")]    = d.device;
+        m[QStringLiteral("readMBps")]  = d.readMBps;
+        m[QStringLiteral("writeMBps")] = d.writeMBps;
+        m[QStringLiteral("readIops")]  = d.readIops;
+        m[QStringLiteral("writeIops")] = d.writeIops;
+        list.append(m);
     }
-#endif
+    return list;
 }
 
-// ---------------------------------------------------------------------------
-// RAM
-// ---------------------------------------------------------------------------
-void SystemMonitor::pollRam()
+QVariantList SystemMonitor::networkIo() const
 {
-#ifdef Q_OS_WIN
-    MEMORYSTATUSEX mem;
-    mem.dwLength = sizeof(MEMORYSTATUSEX);
-    if (GlobalMemoryStatusEx(&mem)) {
-        m_ramTotalGb = static_cast<double>(mem.ullTotalPhys) / (1024.0 * 1024.0 * 1024.0);
-        double available = static_cast<double>(mem.ullAvailPhys) / (1024.0 * 1024.0 * 1024.0);
-        m_ramUsedGb = m_ramTotalGb - available;
-    }
-#else
-    QFile f(QStringLiteral("/proc/meminfo"));
-    if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        quint64 total = 0, available = 0;
-        QTextStream in(&f);
-        while (!in.atEnd()) {
-            QString line = in.readLine();
-            if (line.startsWith(QStringLiteral("MemTotal:")))
-                total = line.split(QLatin1Char(' '), Qt::SkipEmptyParts).at(1).toULongLong();
-            else if (line.startsWith(QStringLiteral("MemAvailable:")))
-                available = line.split(QLatin1Char(' '), Qt::SkipEmptyParts).at(1).toULongLong();
-        }
-        f.close();
-        m_ramTotalGb = static_cast<double>(total) / (1024.0 * 1024.0); // kB -> GB
-        m_ramUsedGb = m_ramTotalGb - static_cast<double>(available) / (1024.0 * 1024.0);
+    QVariantList list;
+    for (const NetIoStat &n : m_latest.interfaces) {
+        QVariantMap m;
+        m[QStringLiteral("iface")]     = n.iface;
+        m[QStringLiteral("rxMBps")]    = n.rxMBps;
+        m[QStringLiteral("txMBps")]    = n.txMBps;
+        m[QStringLiteral("rxPackets")] = n.rxPackets;
+        m[QStringLiteral("txPackets")] = n.txPackets;
+        list.append(m);
     }
-#endif
+    return list;
 }
 
 // ---------------------------------------------------------------------------
-// Storage (root/C: drive)
+// Time series
 // ---------------------------------------------------------------------------
-void SystemMonitor::pollStorage()
+const QList<MonitorSample> &SystemMonitor::samples() const { return m_history; }
+
+QVariantMap SystemMonitor::sampleToVariant(const MonitorSample &s)
 {
-    QStorageInfo root = QStorageInfo::root();
-    if (root.isValid()) {
-        m_storageTotalGb = static_cast<double>(root.bytesTotal()) / (1024.0 * 1024.0 * 1024.0);
-        double free = static_cast<double>(root.bytesAvailable()) / (1024.0 * 1024.0 * 1024.0);
-        m_storageUsedGb = m_storageTotalGb - free;
-    }
+    QVariantMap m;
+    m[QStringLiteral("t")]                 = s.timestampMs;
+    m[QStringLiteral("cpuUsage")]          = s.cpuUsage;
+    m[QStringLiteral("ramUsedGb")]         = s.ramUsedGb;
+    m[QStringLiteral("pageFaultsPerSec")]  = s.pageFaultsPerSec;
+    m[QStringLiteral("majorFaultsPerSec")] = s.majorFaultsPerSec;
+    m[QStringLiteral("swapInPerSec")]      = s.swapInPerSec;
+    m[QStringLiteral("swapOutPerSec")]     = s.swapOutPerSec;
+    m[QStringLiteral("psiCpu")]            = s.psiCpu;
+    m[QStringLiteral("psiMemory")]         = s.psiMemory;
+    m[QStringLiteral("psiIo")]             = s.psiIo;
+    m[QStringLiteral("commitGb")]          = s.commitGb;
+    m[QStringLiteral("commitLimitGb")]     = s.commitLimitGb;
+    m[QStringLiteral("diskReadMBps")]      = s.diskReadMBps;
+    m[QStringLiteral("diskWriteMBps")]     = s.diskWriteMBps;
+    m[QStringLiteral("netRxMBps")]         = s.netRxMBps;
+    m[QStringLiteral("netTxMBps")]         = s.netTxMBps;
+    m[QStringLiteral("tcpRetransPerSec")]  = s.tcpRetransPerSec;
+    return m;
 }
 
-// ---------------------------------------------------------------------------
-// Uptime
-// ---------------------------------------------------------------------------
-void SystemMonitor::pollUptime()
+QVariantList SystemMonitor::history() const
 {
-#ifdef Q_OS_WIN
-    m_uptimeMinutes = static_cast<int>(GetTickCount64() / 60000ULL);
-#else
-    QFile f(QStringLiteral("/proc/uptime"));
-    if (f.open(QIODevice::ReadOnly | QIODevice::Text)) {
-        double secs = QTextStream(&f).readLine().split(QLatin1Char(' ')).first().toDouble();
-        m_uptimeMinutes = static_cast<int>(secs / 60.0);
-        f.close();
-    }
-#endif
+    QVariantList list;
+    list.reserve(m_history.size());
+    for (const MonitorSample &s : m_history)
+        list.append(sampleToVariant(s));
+    return list;
 }
+
+void SystemMonitor::clearHistory() { m_history.clear(); }
@@ -1,10 +1,17 @@
 #pragma once
 
+#include <QList>
 #include <QObject>
-#include <QTimer>
+#include <QThread>
+#include <QVariantList>
+#include <QVariantMap>
 
-/// Provides live system metrics (CPU usage, RAM, uptime, storage).
-/// Updates every second via QTimer.
+#include "app/MonitorSampler.h"
+
+/// Provides live system metrics (CPU usage, RAM, paging, disk/network I/O,
+/// uptime, storage). Sampling runs every 1.5 s on a dedicated monitor thread
+/// (MonitorSampler); results are applied here on the GUI thread, which also
+/// keeps a bounded history so before/after comparisons of tweaks are possible.
 class SystemMonitor : public QObject
 {
     Q_OBJECT
@@ -18,9 +25,29 @@ class SystemMonitor : public QObject
     Q_PROPERTY(double storageTotalGb READ storageTotalGb NOTIFY updated)
     Q_PROPERTY(int    uptimeMinutes  READ uptimeMinutes  NOTIFY updated)
     Q_PROPERTY(QString uptimeText    READ uptimeText     NOTIFY updated)
+    // Paging / memory pressure
+    Q_PROPERTY(double pageFaultsPerSec  READ pageFaultsPerSec  NOTIFY updated)
+    Q_PROPERTY(double majorFaultsPerSec READ majorFaultsPerSec NOTIFY updated)
+    Q_PROPERTY(double swapInPerSec      READ swapInPerSec      NOTIFY updated)
+    Q_PROPERTY(double swapOutPerSec     READ swapOutPerSec     NOTIFY updated)
+    Q_PROPERTY(double psiCpu            READ psiCpu            NOTIFY updated)
+    Q_PROPERTY(double psiMemory         READ psiMemory         NOTIFY updated)
+    Q_PROPERTY(double psiIo             READ psiIo             NOTIFY updated)
+    Q_PROPERTY(double commitGb          READ commitGb          NOTIFY updated)
+    Q_PROPERTY(double commitLimitGb     READ commitLimitGb     NOTIFY updated)
+    // Disk / network I/O
+    Q_PROPERTY(double diskReadMBps      READ diskReadMBps      NOTIFY updated)
+    Q_PROPERTY(double diskWriteMBps     READ diskWriteMBps     NOTIFY updated)
+    Q_PROPERTY(double diskReadIops      READ diskReadIops      NOTIFY updated)
+    Q_PROPERTY(double diskWriteIops     READ diskWriteIops     NOTIFY updated)
+    Q_PROPERTY(double netRxMBps         READ netRxMBps         NOTIFY updated)
+    Q_PROPERTY(double netTxMBps         READ netTxMBps         NOTIFY updated)
+    Q_PROPERTY(double tcpRetransPerSec  READ tcpRetransPerSec  NOTIFY updated)
+    Q_PROPERTY(double tcpRetransPercent READ tcpRetransPercent NOTIFY updated)
 
 public:
     explicit SystemMonitor(QObject *parent = nullptr);
+    ~SystemMonitor() override;
 
     double  cpuUsage() const;
     double  ramUsage() const;
@@ -32,38 +59,54 @@ public:
     int     uptimeMinutes() const;
     QString uptimeText() const;
 
+    double  pageFaultsPerSec() const;
+    double  majorFaultsPerSec() const;
+    double  swapInPerSec() const;
+    double  swapOutPerSec() const;
+    double  psiCpu() const;
+    double  psiMemory() const;
+    double  psiIo() const;
+    double  commitGb() const;
+    double  commitLimitGb() const;
+
+    double  diskReadMBps() const;
+    double  diskWriteMBps() const;
+    double  diskReadIops() const;
+    double  diskWriteIops() const;
+    double  netRxMBps() const;
+    double  netTxMBps() const;
+    double  tcpRetransPerSec() const;
+    double  tcpRetransPercent() const;
+
+    /// Per-device / per-interface breakdown of the latest sample.
+    Q_INVOKABLE QVariantList diskIo() const;
+    Q_INVOKABLE QVariantList networkIo() const;
+
+    /// Recorded samples, oldest first (at most kHistoryCapacity entries).
+    const QList<MonitorSample> &samples() const;
+
+    /// History as a list of maps, for QML / the web bridge.
+    Q_INVOKABLE QVariantList history() const;
+    Q_INVOKABLE void clearHistory();
+
     Q_INVOKABLE void start();
     Q_INVOKABLE void stop();
 
+    static QVariantMap sampleToVariant(const MonitorSample &s);
+
+    static constexpr int kHistoryCapacity = 480; // 12 min at 1.5 s
+    static constexpr int kIntervalMs      = 1500;
+
 signals:
     void updated();
 
 private slots:
-    void poll();
+    void applySnapshot(const MonitorSnapshot &snapshot);
 
 private:
-    void pollCpu();
-    void pollRam();
-    void pollStorage();
-    void pollUptime();
-
-    QTimer m_timer;
-
-    double m_cpuUsage       = 0;
-    double m_ramUsedGb      = 0;
-    double m_ramTotalGb     = 0;
-    double m_storageUsedGb  = 0;
-    double m_storageTotalGb = 0;
-    int    m_uptimeMinutes  = 0;
-
-#ifdef Q_OS_WIN
-    quint64 m_prevIdleTime  = 0;
-    quint64 m_prevKernelTime = 0;
-    quint64 m_prevUserTime  = 0;
-    bool    m_firstCpuPoll  = true;
-#else
-    quint64 m_prevTotal = 0;
-    quint64 m_prevIdle  = 0;
-    bool    m_firstCpuPoll = true;
-#endif
+    QThread          m_thread;
+    MonitorSampler  *m_sampler = nullptr;  // lives on m_thread, deleted when it finishes
+    MonitorSnapshot  m_latest;
+
+    QList<MonitorSample> m_history;
 };
@@ -0,0 +1,239 @@
+#include "app/Trace.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QFileInfo>
+#include <QList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QThread>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+// ---------------------------------------------------------------------------
+// Per-thread buffers
+// ---------------------------------------------------------------------------
+namespace {
+
+constexpr int kBufferEvents = 1 << 15;     // per thread, 1 MB
+constexpr int kOpenDepth    = 32;          // nesting tracked for openSpans()
+
+struct Event
+{
+    const char *category;
+    const char *name;
+    qint64      startNs;
+    qint64      durationNs;
+};
+
+/// One level of a thread's stack of open spans.
+struct OpenSpan
+{
+    std::atomic<const char *> category{ nullptr };
+    std::atomic<const char *> name{ nullptr };
+};
+
+/// Spans are written only by their thread; count is published with
+/// release so a reader that acquires it sees every event below it. The
+/// open-span stack is read by other threads without synchronisation
+/// beyond its atomics.
+struct ThreadBuffer
+{
+    int                     tid = 0;
+    Qt::HANDLE              threadId = nullptr;
+    QString                 threadName;
+    std::unique_ptr<Event[]> events;          // allocated on the first recorded span
+    std::atomic<int>        count{ 0 };
+    std::atomic<quint64>    dropped{ 0 };
+
+    OpenSpan                open[kOpenDepth];
+    std::atomic<int>        openDepth{ 0 };
+};
+
+struct Registry
+{
+    QMutex                                mutex;      // registration and export only
+    QList<std::shared_ptr<ThreadBuffer>>  buffers;    // kept after their thread exits
+    const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+};
+
+Registry &registry()
+{
+    static Registry r;
+    return r;
+}
+
+ThreadBuffer &localBuffer()
+{
+    thread_local const std::shared_ptr<ThreadBuffer> buffer = [] {
+        auto b = std::make_shared<ThreadBuffer>();
+        b->threadId = QThread::currentThreadId();
+        QThread *thread = QThread::currentThread();
+        const QCoreApplication *app = QCoreApplication::instance();
+        if (app && thread == app->thread())
+            b->threadName = QStringLiteral("GUI");
+        else if (thread && !thread->objectName().isEmpty())
+            b->threadName = thread->objectName();
+
+        Registry &r = registry();
+        QMutexLocker lock(&r.mutex);
+        b->tid = int(r.buffers.size()) + 1;
+        if (b->threadName.isEmpty())
+            b->threadName = QStringLiteral("Thread %1").arg(b->tid);
+        r.buffers.append(b);
+        return b;
+    }();
+    return *buffer;
+}
+
+/// Span names are plain identifiers, but keep the JSON valid regardless.
+void appendJsonString(QByteArray &out, const QByteArray &text)
+{
+    out += '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\')
+            out += '\\';
+        if (uchar(c) >= 0x20)
+            out += c;
+    }
+    out += '"';
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Trace
+// ---------------------------------------------------------------------------
+qint64 Trace::nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now() - registry().origin).count();
+}
+
+void Trace::record(const char *category, const char *name, qint64 startNs, qint64 endNs)
+{
+    ThreadBuffer &b = localBuffer();
+    if (!b.events)
+        b.events.reset(new Event[kBufferEvents]);
+    const int i = b.count.load(std::memory_order_relaxed);
+    if (i >= kBufferEvents) {
+        b.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    b.events[i] = Event{ category, name, startNs, endNs - startNs };
+    b.count.store(i + 1, std::memory_order_release);
+}
+
+void Trace::pushOpen(const char *category, const char *name)
+{
+    ThreadBuffer &b = localBuffer();
+    const int depth = b.openDepth.load(std::memory_order_relaxed);
+    if (depth < kOpenDepth) {
+        b.open[depth].category.store(category, std::memory_order_relaxed);
+        b.open[depth].name.store(name, std::memory_order_relaxed);
+    }
+    b.openDepth.store(depth + 1, std::memory_order_release);
+}
+
+void Trace::popOpen()
+{
+    ThreadBuffer &b = localBuffer();
+    b.openDepth.store(std::max(0, b.openDepth.load(std::memory_order_relaxed) - 1),
+                      std::memory_order_release);
+}
+
+void Trace::registerCurrentThread()
+{
+    localBuffer();
+}
+
+QStringList Trace::openSpans(Qt::HANDLE threadId)
+{
+    std::shared_ptr<ThreadBuffer> buffer;
+    {
+        Registry &r = registry();
+        QMutexLocker lock(&r.mutex);
+        for (const auto &b : r.buffers)
+            if (b->threadId == threadId)
+                buffer = b;
+    }
+    QStringList spans;
+    if (!buffer)
+        return spans;
+    const int depth = std::min(buffer->openDepth.load(std::memory_order_acquire), kOpenDepth);
+    for (int i = 0; i < depth; ++i) {
+        const char *category = buffer->open[i].category.load(std::memory_order_relaxed);
+        const char *name     = buffer->open[i].name.load(std::memory_order_relaxed);
+        if (category && name)
+            spans << QString::fromLatin1(category) + QLatin1Char('/') + QString::fromLatin1(name);
+    }
+    return spans;
+}
+
+quint64 Trace::droppedCount()
+{
+    Registry &r = registry();
+    QMutexLocker lock(&r.mutex);
+    quint64 dropped = 0;
+    for (const auto &b : r.buffers)
+        dropped += b->dropped.load(std::memory_order_relaxed);
+    return dropped;
+}
+
+QByteArray Trace::toChromeJson()
+{
+    Registry &r = registry();
+    QList<std::shared_ptr<ThreadBuffer>> buffers;
+    {
+        QMutexLocker lock(&r.mutex);
+        buffers = r.buffers;
+    }
+
+    const QByteArray pid = QByteArray::number(QCoreApplication::applicationPid());
+    QByteArray out;
+    out.reserve(1 << 16);
+    out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) out += ",\n";
+        first = false;
+    };
+
+    for (const auto &b : buffers) {
+        const QByteArray tid = QByteArray::number(b->tid);
+        separator();
+        out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" + pid + ",\"tid\":" + tid
+             + ",\"args\":{\"name\":";
+        appendJsonString(out, b->threadName.toUtf8());
+        out += "}}";
+
+        const int n = b->count.load(std::memory_order_acquire);
+        for (int i = 0; i < n; ++i) {
+            const Event &e = b->events[i];
+            separator();
+            out += "{\"name\":";
+            appendJsonString(out, QByteArray(e.name));
+            out += ",\"cat\":";
+            appendJsonString(out, QByteArray(e.category));
+            // Chrome trace timestamps are microseconds
+            out += ",\"ph\":\"X\",\"ts\":" + QByteArray::number(e.startNs / 1000.0, 'f', 3)
+                 + ",\"dur\":" + QByteArray::number(e.durationNs / 1000.0, 'f', 3)
+                 + ",\"pid\":" + pid + ",\"tid\":" + tid + '}';
+        }
+    }
+    out += "]}\n";
+    return out;
+}
+
+bool Trace::writeChromeJson(const QString &path)
+{
+    QDir().mkpath(QFileInfo(path).absolutePath());
+    QSaveFile f(path);
+    if (!f.open(QIODevice::WriteOnly))
+        return false;
+    f.write(toChromeJson());
+    return f.commit();
+}
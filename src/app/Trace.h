@@ -0,0 +1,104 @@
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+#include <QtGlobal>
+
+#include <atomic>
+
+/// Scoped-span tracing for hot paths, exported as Chrome trace event JSON
+/// (open in ui.perfetto.dev or chrome://tracing).
+///
+/// Each thread appends to its own fixed-size buffer with no locking; a
+/// full buffer drops further spans and counts them. Spans are compiled in
+/// only with TWEAK_TRACING (CMake option of the same name) and recorded
+/// only while enabled() — TWEAK_TRACE=1 in the environment at start-up or
+/// setEnabled() — so a disabled span costs one relaxed atomic load.
+///
+///     void TweakEngine::applyTweak(Tweak &tweak)
+///     {
+///         TRACE_SCOPE("tweaks", "applyTweak");
+///         ...
+///
+/// Category and name must outlive the process (string literals, or names
+/// from static tables such as HardwareProbe::name).
+///
+/// Independently of recording, setTrackOpenSpans() keeps a per-thread
+/// stack of the spans currently open, which StallWatchdog reads to name
+/// the operation a blocked thread is stuck in.
+class Trace
+{
+public:
+    static bool enabled() { return s_flags.load(std::memory_order_relaxed) & Record; }
+    static void setEnabled(bool on) { setFlag(Record, on); }
+
+    static void setTrackOpenSpans(bool on) { setFlag(TrackOpen, on); }
+    /// Spans open on another thread (QThread::currentThreadId() of that
+    /// thread), outermost first, as "category/name". A racy snapshot, good
+    /// enough for diagnostics.
+    static QStringList openSpans(Qt::HANDLE threadId);
+    /// Make the calling thread known to openSpans() before it opens a span.
+    static void registerCurrentThread();
+
+    /// Nanoseconds on the trace clock (steady, starts at first use).
+    static qint64 nowNs();
+
+    /// Append one completed span to the calling thread's buffer.
+    static void record(const char *category, const char *name, qint64 startNs, qint64 endNs);
+
+    /// Every span recorded so far, plus thread names, as Chrome trace JSON.
+    static QByteArray toChromeJson();
+    static bool writeChromeJson(const QString &path);
+
+    /// Spans lost to full buffers.
+    static quint64 droppedCount();
+
+    /// Times its own lifetime; use through TRACE_SCOPE.
+    class Scope
+    {
+    public:
+        Scope(const char *category, const char *name)
+            : m_category(category), m_name(name),
+              m_flags(s_flags.load(std::memory_order_relaxed))
+        {
+            if (m_flags & TrackOpen) pushOpen(category, name);
+            m_startNs = (m_flags & Record) ? nowNs() : -1;
+        }
+        ~Scope()
+        {
+            if (m_startNs >= 0)
+                record(m_category, m_name, m_startNs, nowNs());
+            if (m_flags & TrackOpen) popOpen();
+        }
+        Q_DISABLE_COPY(Scope)
+
+    private:
+        const char *m_category;
+        const char *m_name;
+        int         m_flags;
+        qint64      m_startNs;
+    };
+
+private:
+    enum Flag { Record = 0x1, TrackOpen = 0x2 };
+
+    static void setFlag(Flag flag, bool on)
+    {
+        if (on) s_flags.fetch_or(flag, std::memory_order_relaxed);
+        else    s_flags.fetch_and(~flag, std::memory_order_relaxed);
+    }
+    static void pushOpen(const char *category, const char *name);
+    static void popOpen();
+
+    static inline std::atomic<int> s_flags{0};
+};
+
+#ifdef TWEAK_TRACING
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(category, name) \
+    const Trace::Scope TRACE_CONCAT(traceScope_, __LINE__)(category, name)
+#else
+#define TRACE_SCOPE(category, name) ((void)0)
+#endif
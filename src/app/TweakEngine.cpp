@@ -12,6 +12,9 @@
 #include "app/RegistryUtil.h"
 #include "app/PowerUtil.h"
 #include "app/UacHelper.h"
+#include "app/Trace.h"
+
+#include <algorithm>
 
 // ---------------------------------------------------------------------------
 // Helpers
@@ -67,8 +70,11 @@ QVariantMap serviceAction(const QString &serviceName, const QString &startType)
 // ---------------------------------------------------------------------------
 // Construction
 // ---------------------------------------------------------------------------
-TweakEngine::TweakEngine()
+TweakEngine::TweakEngine() = default;
+
+void TweakEngine::load()
 {
+    TRACE_SCOPE("tweaks", "load");
     initializeTweaks();
     loadAppliedState();
 }
@@ -113,6 +119,7 @@ bool TweakEngine::isAdmin() const
 // ---------------------------------------------------------------------------
 void TweakEngine::updateRecommendations(const HardwareInfo &info)
 {
+    TRACE_SCOPE("tweaks", "updateRecommendations");
     for (Tweak &t : m_tweaks) t.recommended = false;
 
     for (Tweak &t : m_tweaks) {
@@ -139,7 +146,6 @@ void TweakEngine::updateRecommendations(const HardwareInfo &info)
             || t.id == QStringLiteral("disable_bing_search")
             || t.id == QStringLiteral("disable_error_reporting")
             || t.id == QStringLiteral("disable_aero_shake")
-            || t.id == QStringLiteral("disable_core_parking")
             || t.id == QStringLiteral("disable_ecn"))
         {
             t.recommended = true;
@@ -185,6 +191,13 @@ void TweakEngine::updateRecommendations(const HardwareInfo &info)
             t.recommended = info.hasSsd;
         }
 
+        // Core parking: multi-CCD parts rely on it to keep games on one
+        // CCD (X3D V-Cache), so only CPUs with one L3 per package benefit
+        // from disabling it
+        if (t.id == QStringLiteral("disable_core_parking")) {
+            t.recommended = info.cpuL3Domains <= std::max(1, info.cpuPackages);
+        }
+
         // Power throttling: recommend for Intel CPUs
         if (t.id == QStringLiteral("disable_power_throttling")) {
             t.recommended = info.cpuName.contains(QStringLiteral("Intel"), Qt::CaseInsensitive);
@@ -204,6 +217,7 @@ void TweakEngine::updateRecommendations(const HardwareInfo &info)
 // ---------------------------------------------------------------------------
 void TweakEngine::applyRecommended()
 {
+    TRACE_SCOPE("tweaks", "applyRecommended");
     for (Tweak &t : m_tweaks) {
         if (t.recommended && !t.applied)
             applyTweak(t);
@@ -213,6 +227,7 @@ void TweakEngine::applyRecommended()
 
 void TweakEngine::restoreDefaults()
 {
+    TRACE_SCOPE("tweaks", "restoreDefaults");
     for (Tweak &t : m_tweaks) {
         if (t.applied)
             restoreTweak(t);
@@ -222,6 +237,7 @@ void TweakEngine::restoreDefaults()
 
 void TweakEngine::toggleTweak(const QString &id)
 {
+    TRACE_SCOPE("tweaks", "toggleTweak");
     for (Tweak &t : m_tweaks) {
         if (t.id == id) {
             if (t.applied) restoreTweak(t);
@@ -237,6 +253,7 @@ void TweakEngine::toggleTweak(const QString &id)
 // ---------------------------------------------------------------------------
 bool TweakEngine::verifyTweak(const QString &id)
 {
+    TRACE_SCOPE("tweaks", "verifyTweak");
     for (Tweak &t : m_tweaks) {
         if (t.id != id) continue;
         if (!t.applied) { t.verified = false; return false; }
@@ -277,6 +294,7 @@ bool TweakEngine::verifyTweak(const QString &id)
 
 void TweakEngine::verifyAllTweaks()
 {
+    TRACE_SCOPE("tweaks", "verifyAllTweaks");
     for (Tweak &t : m_tweaks) {
         if (t.applied) verifyTweak(t.id);
         else t.verified = false;
@@ -2097,6 +2115,7 @@ void TweakEngine::initializeTweaks()
 // ---------------------------------------------------------------------------
 void TweakEngine::applyTweak(Tweak &tweak)
 {
+    TRACE_SCOPE("tweaks", "applyTweak");
     if (tweak.requiresAdmin && !isAdmin())
         return;
 
@@ -2197,6 +2216,7 @@ void TweakEngine::applyTweak(Tweak &tweak)
 // ---------------------------------------------------------------------------
 void TweakEngine::restoreTweak(Tweak &tweak)
 {
+    TRACE_SCOPE("tweaks", "restoreTweak");
     const QJsonObject backup = loadBackup(tweak.id);
     if (backup.isEmpty()) { tweak.applied = false; return; }
 
@@ -26,8 +26,14 @@ struct Tweak
 class TweakEngine
 {
 public:
+    /// Starts empty; load() builds the catalog.
     TweakEngine();
 
+    /// Build the tweak catalog and restore the applied flags saved last run.
+    /// Touches only this engine, so a scratch engine can load off the GUI
+    /// thread and hand its tweaks() over.
+    void load();
+
     QList<Tweak>       &tweaks();
     const QList<Tweak> &tweaks() const;
     QStringList         categories() const;
@@ -59,12 +59,27 @@ QString TweakListModel::tweakIdForRow(int row) const
     return isValidRow(row) ? m_tweaks.at(row).id : QString();
 }
 
+quint8 TweakListModel::stateBits(int row) const
+{
+    if (!isValidRow(row)) return 0;
+    const Tweak &t = m_tweaks.at(row);
+    return (t.applied ? AppliedBit : 0) | (t.verified ? VerifiedBit : 0)
+         | (t.recommended ? RecommendedBit : 0);
+}
+
 void TweakListModel::refresh()
 {
     if (!m_tweaks.isEmpty())
         emit dataChanged(index(0), index(m_tweaks.size() - 1));
 }
 
+void TweakListModel::reset(QList<Tweak> tweaks)
+{
+    beginResetModel();
+    m_tweaks = std::move(tweaks);
+    endResetModel();
+}
+
 void TweakListModel::refreshRow(int row)
 {
     if (isValidRow(row))
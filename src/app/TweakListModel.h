@@ -23,6 +23,13 @@ public:
         StatusRole
     };
 
+    /// Per-row state bits, see stateBits().
+    enum StateBit : quint8 {
+        AppliedBit     = 0x1,
+        VerifiedBit    = 0x2,
+        RecommendedBit = 0x4
+    };
+
     explicit TweakListModel(QList<Tweak> &tweaks, QObject *parent = nullptr);
 
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
@@ -31,7 +38,12 @@ public:
 
     bool isValidRow(int row) const;
     QString tweakIdForRow(int row) const;
+    /// The mutable part of a row packed as StateBit flags; the rest of a
+    /// tweak never changes after start-up.
+    quint8 stateBits(int row) const;
     void refresh();
+    /// Replace every row, e.g. once the catalog has loaded.
+    void reset(QList<Tweak> tweaks);
     void refreshRow(int row);
 
 private:
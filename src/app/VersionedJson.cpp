@@ -0,0 +1,52 @@
+#include "app/VersionedJson.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+
+// ---------------------------------------------------------------------------
+// Helpers
+// ---------------------------------------------------------------------------
+namespace {
+
+QJsonObject readObject(const QString &path, const char *logTag)
+{
+    QFile f(path);
+    if (!f.open(QIODevice::ReadOnly))
+        return {};
+    QJsonParseError err;
+    const QJsonDocument doc = QJsonDocument::fromJson(f.readAll(), &err);
+    if (err.error != QJsonParseError::NoError) {
+        qWarning() << logTag << "Cannot parse" << path << ":" << err.errorString();
+        return {};
+    }
+    return doc.object();
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// VersionedJson
+// ---------------------------------------------------------------------------
+VersionedJson VersionedJson::load(const QString &builtinPath, const QString &overridePath,
+                                  const char *logTag)
+{
+    VersionedJson builtin;
+    builtin.root    = readObject(builtinPath, logTag);
+    builtin.version = builtin.root.value(QStringLiteral("version")).toInt();
+    if (!builtin.root.isEmpty())
+        builtin.source = builtinPath;
+
+    VersionedJson custom;
+    custom.root = readObject(overridePath, logTag);
+    if (custom.root.isEmpty())
+        return builtin;
+    custom.version = custom.root.value(QStringLiteral("version")).toInt();
+    if (custom.version < builtin.version) {
+        qDebug() << logTag << "Ignoring" << overridePath << "- version" << custom.version
+                 << "is older than" << builtin.version;
+        return builtin;
+    }
+    custom.source = overridePath;
+    return custom;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QString>
+
+/// A JSON data file shipped as a resource that a copy in AppDataLocation
+/// may replace (hwdb.json, games.json). Both carry a top-level "version";
+/// the override only wins when it parses and is at least as new as the
+/// built-in copy, so an app update is not shadowed by an older download.
+struct VersionedJson
+{
+    QJsonObject root;
+    int         version = 0;
+    QString     source;         // path root was read from; empty if neither file could be
+
+    /// logTag prefixes the warnings, e.g. "[HWDB]".
+    static VersionedJson load(const QString &builtinPath, const QString &overridePath,
+                              const char *logTag);
+};
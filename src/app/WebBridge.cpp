@@ -1,27 +1,70 @@
 #include "app/WebBridge.h"
+#include "app/BulkPayload.h"
+#include "app/MachineIdentity.h"
+#include "app/StartupTrace.h"
+#include "app/Trace.h"
 #include <QJsonDocument>
+#include <QCryptographicHash>
+#include <QElapsedTimer>
 #include <QCoreApplication>
 #include <QThread>
+#include <QDir>
 #include <QFile>
 #include <QProcess>
+#include <QDateTime>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <cmath>
 
 WebBridge::WebBridge(AppController *controller, LicenseManager *license, QObject *parent)
     : QObject(parent), m_ctrl(controller), m_license(license)
 {
-    // Forward tweak changes
-    connect(m_ctrl, &AppController::tweaksChanged, this, &WebBridge::tweaksChanged);
+    // Tweak changes go out as state diffs against this starting state
+    auto *model = m_ctrl->tweaksModel();
+    for (int i = 0; i < model->rowCount(); ++i)
+        m_tweakBits.append(char(model->stateBits(i)));
+    connect(m_ctrl, &AppController::tweaksChanged, this, &WebBridge::pushTweakState);
+
+    // Forward hardware updates (partial probe results, then the final merge)
+    connect(m_ctrl, &AppController::hardwareChanged, this, &WebBridge::hardwareChanged);
 
-    // Poll system monitor and forward
-    connect(m_ctrl->systemMonitor(), &SystemMonitor::updated, this, &WebBridge::monitorUpdated);
+    // Stream latency probe results per target as they arrive
+    auto *games = m_ctrl->gameBenchmark();
+    connect(games, &GameBenchmark::latencyUpdated, this, [this](const QVariantMap &stats) {
+        const QJsonObject obj = QJsonObject::fromVariantMap(stats);
+        if (m_profiler.enabled())
+            m_profiler.recordSignal("latencyUpdated", BridgeProfiler::payloadSize(obj));
+        emit latencyUpdated(obj);
+    });
+    connect(games, &GameBenchmark::networkDone, this, [this, games]() {
+        emit pingDone(games->networkLatency());
+    });
+
+    // Forward re-scoring after a calibration pass, and core scan results
+    connect(m_ctrl, &AppController::scoresChanged, this, &WebBridge::scoresChanged);
+    connect(m_ctrl, &AppController::coreScanChanged, this, &WebBridge::coreScanFinished);
+
+    // Push monitor samples as deltas, only while the dashboard is on screen
+    connect(m_ctrl->systemMonitor(), &SystemMonitor::updated, this, &WebBridge::pushMonitorDelta);
 
     // Forward license signals
     connect(m_license, &LicenseManager::loginResult,    this, &WebBridge::loginResult);
     connect(m_license, &LicenseManager::activateResult, this, &WebBridge::activateResult);
     connect(m_license, &LicenseManager::hwidStatusResult, this, &WebBridge::hwidStatusResult);
+    connect(m_license, &LicenseManager::licenseRevoked, this, &WebBridge::licenseRevoked);
+
+    // The HWID comes from MachineIdentity's background pass
+    MachineIdentity::instance().whenReady(this, [this]() {
+        emit hwidReady(MachineIdentity::instance().hwid());
+    });
 }
 
 QJsonObject WebBridge::getSystemInfo()
 {
+    BridgeProfiler::Call call(m_profiler, "getSystemInfo");
+    TRACE_SCOPE("bridge", "getSystemInfo");
     QJsonObject obj;
     obj["cpuName"]         = m_ctrl->cpuName();
     obj["gpuName"]         = m_ctrl->gpuName();
@@ -30,6 +73,7 @@ QJsonObject WebBridge::getSystemInfo()
     obj["ramText"]         = m_ctrl->ramText();
     obj["cpuCores"]        = m_ctrl->cpuCores();
     obj["cpuThreads"]      = m_ctrl->cpuThreads();
+    obj["cpuLayout"]       = m_ctrl->cpuLayout();
     obj["motherboardName"] = m_ctrl->motherboardName();
     obj["storageText"]     = m_ctrl->storageText();
     obj["diskModel"]       = m_ctrl->diskModel();
@@ -40,6 +84,8 @@ QJsonObject WebBridge::getSystemInfo()
     // Lag 2: Low-Level
     obj["ramType"]         = m_ctrl->ramType();
     obj["ramSpeedMhz"]     = m_ctrl->ramSpeedMhz();
+    obj["ramChannels"]     = m_ctrl->ramChannels();
+    obj["ramLayout"]       = m_ctrl->ramLayout();
     obj["gpuVramMb"]       = m_ctrl->gpuVramMb();
     obj["gpuDriverVersion"]= m_ctrl->gpuDriverVersion();
     obj["cpuL2CacheKb"]    = m_ctrl->cpuL2CacheKb();
@@ -50,11 +96,19 @@ QJsonObject WebBridge::getSystemInfo()
     obj["tpmVersion"]      = m_ctrl->tpmVersion();
     obj["secureBootEnabled"]= m_ctrl->secureBootEnabled();
     obj["chassisType"]     = m_ctrl->chassisType();
-    return obj;
+    obj["hardwareReady"]   = m_ctrl->hardwareReady();
+    return call.payload(obj);
 }
 
 QJsonObject WebBridge::getMonitorData()
 {
+    BridgeProfiler::Call call(m_profiler, "getMonitorData");
+    return call.payload(monitorSnapshot());
+}
+
+QJsonObject WebBridge::monitorSnapshot()
+{
+    TRACE_SCOPE("bridge", "monitorSnapshot");
     auto *mon = m_ctrl->systemMonitor();
     QJsonObject obj;
     obj["cpuUsage"]       = mon->cpuUsage();
@@ -65,11 +119,81 @@ QJsonObject WebBridge::getMonitorData()
     obj["storageUsedGb"]  = mon->storageUsedGb();
     obj["storageTotalGb"] = mon->storageTotalGb();
     obj["uptimeText"]     = mon->uptimeText();
+    // Paging / memory pressure
+    obj["pageFaultsPerSec"]  = mon->pageFaultsPerSec();
+    obj["majorFaultsPerSec"] = mon->majorFaultsPerSec();
+    obj["swapInPerSec"]      = mon->swapInPerSec();
+    obj["swapOutPerSec"]     = mon->swapOutPerSec();
+    obj["psiCpu"]            = mon->psiCpu();
+    obj["psiMemory"]         = mon->psiMemory();
+    obj["psiIo"]             = mon->psiIo();
+    obj["commitGb"]          = mon->commitGb();
+    obj["commitLimitGb"]     = mon->commitLimitGb();
+    // Disk / network I/O
+    obj["diskReadMBps"]      = mon->diskReadMBps();
+    obj["diskWriteMBps"]     = mon->diskWriteMBps();
+    obj["diskReadIops"]      = mon->diskReadIops();
+    obj["diskWriteIops"]     = mon->diskWriteIops();
+    obj["netRxMBps"]         = mon->netRxMBps();
+    obj["netTxMBps"]         = mon->netTxMBps();
+    obj["tcpRetransPerSec"]  = mon->tcpRetransPerSec();
+    obj["tcpRetransPercent"] = mon->tcpRetransPercent();
+    obj["disks"]             = QJsonArray::fromVariantList(mon->diskIo());
+    obj["interfaces"]        = QJsonArray::fromVariantList(mon->networkIo());
     return obj;
 }
 
+void WebBridge::setMonitorVisible(bool visible)
+{
+    BridgeProfiler::Call call(m_profiler, "setMonitorVisible");
+    if (visible == m_monitorVisible) return;
+    m_monitorVisible = visible;
+    m_monitorSent = {};          // the next push carries every field
+    if (visible)
+        pushMonitorDelta();
+}
+
+void WebBridge::pushMonitorDelta()
+{
+    TRACE_SCOPE("bridge", "pushMonitorDelta");
+    if (!m_monitorVisible) return;
+
+    // Values are compared at display precision so sub-0.01 jitter does not
+    // count as a change.
+    QJsonObject delta;
+    const QJsonObject current = monitorSnapshot();
+    for (auto it = current.begin(); it != current.end(); ++it) {
+        QJsonValue value = it.value();
+        if (value.isDouble())
+            value = std::round(value.toDouble() * 100.0) / 100.0;
+        if (m_monitorSent.value(it.key()) != value) {
+            delta.insert(it.key(), value);
+            m_monitorSent.insert(it.key(), value);
+        }
+    }
+    if (delta.isEmpty()) return;
+
+    const QString payload = QString::fromUtf8(QJsonDocument(delta).toJson(QJsonDocument::Compact));
+    m_profiler.recordSignal("monitorUpdated", payload.size());
+    emit monitorUpdated(payload);
+}
+
+QJsonArray WebBridge::getMonitorHistory()
+{
+    BridgeProfiler::Call call(m_profiler, "getMonitorHistory");
+    return call.payload(monitorHistory());
+}
+
+QJsonArray WebBridge::monitorHistory() const
+{
+    TRACE_SCOPE("bridge", "monitorHistory");
+    return QJsonArray::fromVariantList(m_ctrl->systemMonitor()->history());
+}
+
 QJsonObject WebBridge::getScoreData()
 {
+    BridgeProfiler::Call call(m_profiler, "getScoreData");
+    TRACE_SCOPE("bridge", "getScoreData");
     auto *sc = m_ctrl->hwScorer();
     QJsonObject obj;
     obj["gamingScore"]      = sc->gamingScore();
@@ -80,11 +204,51 @@ QJsonObject WebBridge::getScoreData()
     obj["storageScore"]     = sc->storageScore();
     obj["tier"]             = sc->tier();
     obj["bottleneck"]       = sc->bottleneck();
-    return obj;
+    obj["calibrated"]       = sc->calibrated();
+    obj["calibration"]      = QJsonObject::fromVariantMap(sc->calibration());
+    obj["calibrating"]      = m_ctrl->benchmarkRunning();
+    return call.payload(obj);
+}
+
+QJsonObject WebBridge::getFpsMatrix()
+{
+    BridgeProfiler::Call call(m_profiler, "getFpsMatrix");
+    TRACE_SCOPE("bridge", "getFpsMatrix");
+    // Whole games × resolutions × qualities table; the UI switches
+    // resolution/quality by indexing, without another round trip.
+    auto *gb = m_ctrl->gameBenchmark();
+    const GameBenchmark::FpsMatrix &m = gb->fpsMatrix();
+
+    QJsonArray avg, low;
+    for (float v : m.avgFps)        avg.append(qRound(v));
+    for (float v : m.onePercentLow) low.append(qRound(v));
+
+    QJsonObject obj;
+    obj["games"]              = QJsonArray::fromVariantList(gb->gameList());
+    obj["resolutions"]        = QJsonArray::fromStringList(m.resolutions);
+    obj["qualities"]          = QJsonArray::fromStringList(m.qualities);
+    obj["avgFps"]             = avg;      // index: (res * qualities + quality) * games + game
+    obj["onePercentLow"]      = low;
+    obj["systemLatencyScore"] = gb->systemLatencyScore();
+    return call.payload(obj);
+}
+
+QJsonArray WebBridge::getLatencyResults()
+{
+    BridgeProfiler::Call call(m_profiler, "getLatencyResults");
+    return call.payload(QJsonArray::fromVariantList(m_ctrl->gameBenchmark()->latencyResults()));
+}
+
+QJsonObject WebBridge::getCoreScan()
+{
+    BridgeProfiler::Call call(m_profiler, "getCoreScan");
+    return call.payload(QJsonObject::fromVariantMap(m_ctrl->coreScan()));
 }
 
 QJsonArray WebBridge::getTweaks()
 {
+    BridgeProfiler::Call call(m_profiler, "getTweaks");
+    TRACE_SCOPE("bridge", "getTweaks");
     QJsonArray arr;
     auto *model = m_ctrl->tweaksModel();
     for (int i = 0; i < model->rowCount(); ++i) {
@@ -104,53 +268,408 @@ QJsonArray WebBridge::getTweaks()
         t["status"]       = model->data(idx, TweakListModel::StatusRole).toString();
         arr.append(t);
     }
-    return arr;
+    return call.payload(arr);
+}
+
+QJsonObject WebBridge::getTweakCatalog()
+{
+    BridgeProfiler::Call call(m_profiler, "getTweakCatalog");
+    return call.payload(tweakCatalog());
+}
+
+QJsonObject WebBridge::tweakCatalog() const
+{
+    TRACE_SCOPE("bridge", "tweakCatalog");
+    QJsonArray arr;
+    auto *model = m_ctrl->tweaksModel();
+    for (int i = 0; i < model->rowCount(); ++i) {
+        QModelIndex idx = model->index(i, 0);
+        QJsonObject t;
+        t["row"]          = i;
+        t["id"]           = model->data(idx, TweakListModel::IdRole).toString();
+        t["name"]         = model->data(idx, TweakListModel::NameRole).toString();
+        t["description"]  = model->data(idx, TweakListModel::DescriptionRole).toString();
+        t["category"]     = model->data(idx, TweakListModel::CategoryRole).toString();
+        t["requiresAdmin"]= model->data(idx, TweakListModel::RequiresAdminRole).toBool();
+        t["risk"]         = model->data(idx, TweakListModel::RiskRole).toString();
+        t["learnMore"]    = model->data(idx, TweakListModel::LearnMoreRole).toString();
+        t["status"]       = model->data(idx, TweakListModel::StatusRole).toString();
+        arr.append(t);
+    }
+
+    QJsonObject obj;
+    obj["version"] = QString::fromLatin1(
+        QCryptographicHash::hash(QJsonDocument(arr).toJson(QJsonDocument::Compact),
+                                 QCryptographicHash::Sha1).toHex().left(12));
+    obj["tweaks"]  = arr;
+    return obj;
+}
+
+QString WebBridge::getTweakCatalogBulk()
+{
+    BridgeProfiler::Call call(m_profiler, "getTweakCatalogBulk");
+    return call.payload(tweakCatalogBulk());
+}
+
+QString WebBridge::tweakCatalogBulk() const
+{
+    TRACE_SCOPE("bridge", "tweakCatalogBulk");
+    auto *model = m_ctrl->tweaksModel();
+    const int rows = model->rowCount();
+    QStringList ids, names, descriptions, categories, risks, learnMore, statuses;
+    QList<bool> requiresAdmin;
+    for (int i = 0; i < rows; ++i) {
+        QModelIndex idx = model->index(i, 0);
+        ids           << model->data(idx, TweakListModel::IdRole).toString();
+        names         << model->data(idx, TweakListModel::NameRole).toString();
+        descriptions  << model->data(idx, TweakListModel::DescriptionRole).toString();
+        categories    << model->data(idx, TweakListModel::CategoryRole).toString();
+        risks         << model->data(idx, TweakListModel::RiskRole).toString();
+        learnMore     << model->data(idx, TweakListModel::LearnMoreRole).toString();
+        statuses      << model->data(idx, TweakListModel::StatusRole).toString();
+        requiresAdmin << model->data(idx, TweakListModel::RequiresAdminRole).toBool();
+    }
+
+    BulkPayload bulk(rows);
+    bulk.addString(QStringLiteral("id"),          ids);
+    bulk.addString(QStringLiteral("name"),        names);
+    bulk.addString(QStringLiteral("description"), descriptions);
+    bulk.addString(QStringLiteral("category"),    categories);
+    bulk.addBool(QStringLiteral("requiresAdmin"), requiresAdmin);
+    bulk.addString(QStringLiteral("risk"),        risks);
+    bulk.addString(QStringLiteral("learnMore"),   learnMore);
+    bulk.addString(QStringLiteral("status"),      statuses);
+    return bulk.toBase64();
+}
+
+QString WebBridge::getMonitorHistoryBulk()
+{
+    BridgeProfiler::Call call(m_profiler, "getMonitorHistoryBulk");
+    return call.payload(monitorHistoryBulk());
+}
+
+QString WebBridge::monitorHistoryBulk() const
+{
+    TRACE_SCOPE("bridge", "monitorHistoryBulk");
+    const QList<MonitorSample> &samples = m_ctrl->systemMonitor()->samples();
+    const int rows = int(samples.size());
+
+    // Timestamps need double precision; float is plenty for the metrics
+    QList<double> t;
+    t.reserve(rows);
+    for (const MonitorSample &s : samples)
+        t.append(double(s.timestampMs));
+
+    BulkPayload bulk(rows);
+    bulk.addFloat64(QStringLiteral("t"), t);
+    auto metric = [&](const char *name, double MonitorSample::*field) {
+        QList<double> values;
+        values.reserve(rows);
+        for (const MonitorSample &s : samples)
+            values.append(s.*field);
+        bulk.addFloat32(QString::fromLatin1(name), values);
+    };
+    metric("cpuUsage",          &MonitorSample::cpuUsage);
+    metric("ramUsedGb",         &MonitorSample::ramUsedGb);
+    metric("pageFaultsPerSec",  &MonitorSample::pageFaultsPerSec);
+    metric("majorFaultsPerSec", &MonitorSample::majorFaultsPerSec);
+    metric("swapInPerSec",      &MonitorSample::swapInPerSec);
+    metric("swapOutPerSec",     &MonitorSample::swapOutPerSec);
+    metric("psiCpu",            &MonitorSample::psiCpu);
+    metric("psiMemory",         &MonitorSample::psiMemory);
+    metric("psiIo",             &MonitorSample::psiIo);
+    metric("commitGb",          &MonitorSample::commitGb);
+    metric("commitLimitGb",     &MonitorSample::commitLimitGb);
+    metric("diskReadMBps",      &MonitorSample::diskReadMBps);
+    metric("diskWriteMBps",     &MonitorSample::diskWriteMBps);
+    metric("netRxMBps",         &MonitorSample::netRxMBps);
+    metric("netTxMBps",         &MonitorSample::netTxMBps);
+    metric("tcpRetransPerSec",  &MonitorSample::tcpRetransPerSec);
+    return bulk.toBase64();
+}
+
+QJsonObject WebBridge::benchmarkBulkTransfer(int iterations)
+{
+    BridgeProfiler::Call call(m_profiler, "benchmarkBulkTransfer");
+    iterations = std::max(iterations, 1);
+
+    // JSON path: what the fetcher builds plus the text QWebChannel sends.
+    // The builders are timed directly, so the runs stay out of the bridge
+    // profile and carry none of its payload sizing.
+    auto measure = [iterations](auto &&json, auto &&bulk) {
+        QJsonObject r;
+        QElapsedTimer timer;
+        qsizetype bytes = 0;
+
+        timer.start();
+        for (int i = 0; i < iterations; ++i)
+            bytes = json().size();
+        r["jsonUs"]    = double(timer.nsecsElapsed()) / 1000.0 / iterations;
+        r["jsonBytes"] = double(bytes);
+
+        timer.restart();
+        for (int i = 0; i < iterations; ++i)
+            bytes = bulk().size();
+        r["bulkUs"]    = double(timer.nsecsElapsed()) / 1000.0 / iterations;
+        r["bulkBytes"] = double(bytes);
+        return r;
+    };
+
+    QJsonObject obj;
+    obj["iterations"] = iterations;
+    obj["tweakCatalog"] = measure(
+        [this] { return QJsonDocument(tweakCatalog()).toJson(QJsonDocument::Compact); },
+        [this] { return tweakCatalogBulk(); });
+    obj["monitorHistory"] = measure(
+        [this] { return QJsonDocument(monitorHistory()).toJson(QJsonDocument::Compact); },
+        [this] { return monitorHistoryBulk(); });
+    obj["historySamples"] = int(m_ctrl->systemMonitor()->samples().size());
+    return call.payload(obj);
+}
+
+QJsonObject WebBridge::getTweakState()
+{
+    BridgeProfiler::Call call(m_profiler, "getTweakState");
+    TRACE_SCOPE("bridge", "getTweakState");
+    pushTweakState();            // fold in anything not yet announced
+
+    QByteArray digits(m_tweakBits.size(), '0');
+    for (int i = 0; i < m_tweakBits.size(); ++i)
+        digits[i] = char('0' + m_tweakBits.at(i));
+
+    QJsonObject obj;
+    obj["version"] = m_tweakStateVersion;
+    obj["bits"]    = QString::fromLatin1(digits);
+    return call.payload(obj);
+}
+
+void WebBridge::pushTweakState()
+{
+    TRACE_SCOPE("bridge", "pushTweakState");
+    auto *model = m_ctrl->tweaksModel();
+    const int rows = model->rowCount();
+    if (rows != m_tweakBits.size()) {
+        // Different tweak set: the page's catalog is stale, diffs would be meaningless
+        m_tweakBits.fill(0, rows);
+        for (int i = 0; i < rows; ++i)
+            m_tweakBits[i] = char(model->stateBits(i));
+        ++m_tweakStateVersion;
+        emit tweakCatalogChanged();
+        return;
+    }
+
+    QJsonObject changed;
+    for (int i = 0; i < rows; ++i) {
+        const char bits = char(model->stateBits(i));
+        if (bits != m_tweakBits.at(i)) {
+            m_tweakBits[i] = bits;
+            changed.insert(QString::number(i), int(bits));
+        }
+    }
+    if (changed.isEmpty()) return;
+
+    QJsonObject diff;
+    diff["from"] = m_tweakStateVersion;
+    diff["to"]   = ++m_tweakStateVersion;
+    diff["rows"] = changed;
+    if (m_profiler.enabled())
+        m_profiler.recordSignal("tweakStateChanged", BridgeProfiler::payloadSize(diff));
+    emit tweakStateChanged(diff);
 }
 
 QJsonArray WebBridge::getCategories()
 {
+    BridgeProfiler::Call call(m_profiler, "getCategories");
     QJsonArray arr;
     for (const auto &c : m_ctrl->categories())
         arr.append(c);
-    return arr;
+    return call.payload(arr);
+}
+
+void WebBridge::markStartup(const QString &milestone, double agoMs)
+{
+    BridgeProfiler::Call call(m_profiler, "markStartup");
+    StartupTrace::mark(milestone, agoMs);
+}
+
+QJsonArray WebBridge::getStartupTrace()
+{
+    BridgeProfiler::Call call(m_profiler, "getStartupTrace");
+    return call.payload(QJsonArray::fromVariantList(StartupTrace::milestones()));
+}
+
+void WebBridge::setBridgeProfiling(bool enabled)
+{
+    m_profiler.setEnabled(enabled);
+}
+
+QJsonObject WebBridge::getBridgeDiagnostics()
+{
+    return m_profiler.toJson();
+}
+
+QString WebBridge::exportBridgeDiagnostics()
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+                      + QStringLiteral("/diagnostics");
+    QDir().mkpath(dir);
+    QSaveFile f(dir + QStringLiteral("/bridge-")
+                + QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss"))
+                + QStringLiteral(".json"));
+    if (!f.open(QIODevice::WriteOnly))
+        return {};
+    f.write(QJsonDocument(m_profiler.toJson()).toJson(QJsonDocument::Indented));
+    return f.commit() ? f.fileName() : QString();
+}
+
+void WebBridge::setTracing(bool enabled)
+{
+    BridgeProfiler::Call call(m_profiler, "setTracing");
+    Trace::setEnabled(enabled);
+}
+
+QString WebBridge::exportTrace()
+{
+    BridgeProfiler::Call call(m_profiler, "exportTrace");
+    const QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+                       + QStringLiteral("/traces/trace-")
+                       + QDateTime::currentDateTime().toString(QStringLiteral("yyyyMMdd-HHmmss"))
+                       + QStringLiteral(".json");
+    return call.payload(Trace::writeChromeJson(path) ? path : QString());
+}
+
+QJsonArray WebBridge::getStalls()
+{
+    BridgeProfiler::Call call(m_profiler, "getStalls");
+    if (!m_watchdog)
+        return {};
+    return call.payload(QJsonArray::fromVariantList(m_watchdog->stallsVariant()));
 }
 
 void WebBridge::loginLicense(const QString &username, const QString &password)
 {
+    BridgeProfiler::Call call(m_profiler, "loginLicense");
     m_license->login(username, password);
 }
 
 void WebBridge::activateLicense(const QString &key, const QString &username,
                                 const QString &password)
 {
+    BridgeProfiler::Call call(m_profiler, "activateLicense");
     m_license->activate(key, username, password);
 }
 
 QString WebBridge::getHwid()
 {
-    return m_license->hwid();
+    BridgeProfiler::Call call(m_profiler, "getHwid");
+    MachineIdentity &identity = MachineIdentity::instance();
+    return call.payload(identity.isReady() ? identity.hwid() : QString());
 }
 
 void WebBridge::checkHwidStatus(const QString &username)
 {
+    BridgeProfiler::Call call(m_profiler, "checkHwidStatus");
     m_license->checkHwidStatus(username);
 }
 
-int  WebBridge::getAppliedCount()     { return m_ctrl->appliedCount(); }
-int  WebBridge::getRecommendedCount() { return m_ctrl->recommendedCount(); }
-bool WebBridge::getIsAdmin()          { return m_ctrl->isAdmin(); }
+int WebBridge::getAppliedCount()
+{
+    BridgeProfiler::Call call(m_profiler, "getAppliedCount");
+    return m_ctrl->appliedCount();
+}
+
+int WebBridge::getRecommendedCount()
+{
+    BridgeProfiler::Call call(m_profiler, "getRecommendedCount");
+    return m_ctrl->recommendedCount();
+}
+
+bool WebBridge::getIsAdmin()
+{
+    BridgeProfiler::Call call(m_profiler, "getIsAdmin");
+    return m_ctrl->isAdmin();
+}
+
+void WebBridge::toggleTweak(int row)
+{
+    BridgeProfiler::Call call(m_profiler, "toggleTweak");
+    m_ctrl->toggleTweak(row);
+}
+
+void WebBridge::applyAllGaming()
+{
+    BridgeProfiler::Call call(m_profiler, "applyAllGaming");
+    m_ctrl->applyAllGaming();
+}
 
-void WebBridge::toggleTweak(int row)     { m_ctrl->toggleTweak(row); }
-void WebBridge::applyAllGaming()         { m_ctrl->applyAllGaming(); }
-void WebBridge::restoreAll()             { m_ctrl->restoreAll(); }
-void WebBridge::clearTempFiles()         { m_ctrl->clearTempFiles(); }
-void WebBridge::flushDns()               { m_ctrl->flushDns(); }
-void WebBridge::requestAdmin()           { m_ctrl->requestAdmin(); }
-void WebBridge::applyRecommended()       { m_ctrl->applyRecommended(); }
-void WebBridge::verifyAllTweaks()        { m_ctrl->verifyAllTweaks(); }
+void WebBridge::restoreAll()
+{
+    BridgeProfiler::Call call(m_profiler, "restoreAll");
+    m_ctrl->restoreAll();
+}
+
+void WebBridge::clearTempFiles()
+{
+    BridgeProfiler::Call call(m_profiler, "clearTempFiles");
+    m_ctrl->clearTempFiles();
+}
+
+void WebBridge::flushDns()
+{
+    BridgeProfiler::Call call(m_profiler, "flushDns");
+    m_ctrl->flushDns();
+}
+
+void WebBridge::requestAdmin()
+{
+    BridgeProfiler::Call call(m_profiler, "requestAdmin");
+    m_ctrl->requestAdmin();
+}
+
+void WebBridge::applyRecommended()
+{
+    BridgeProfiler::Call call(m_profiler, "applyRecommended");
+    m_ctrl->applyRecommended();
+}
+
+void WebBridge::verifyAllTweaks()
+{
+    BridgeProfiler::Call call(m_profiler, "verifyAllTweaks");
+    m_ctrl->verifyAllTweaks();
+}
+
+void WebBridge::calibrateScores()
+{
+    BridgeProfiler::Call call(m_profiler, "calibrateScores");
+    m_ctrl->calibrateScores();
+}
+
+void WebBridge::runPingTest()
+{
+    BridgeProfiler::Call call(m_profiler, "runPingTest");
+    m_ctrl->gameBenchmark()->runPingTest();
+}
+
+bool WebBridge::runCoreScan()
+{
+    BridgeProfiler::Call call(m_profiler, "runCoreScan");
+    // BenchmarkEngine ignores the request while another pass is running
+    if (m_ctrl->benchmarkRunning())
+        return false;
+    m_ctrl->runCoreScan();
+    return true;
+}
+
+void WebBridge::resetCalibration()
+{
+    BridgeProfiler::Call call(m_profiler, "resetCalibration");
+    m_ctrl->resetCalibration();
+}
 
 void WebBridge::applyBatch(QJsonArray rowIndices)
 {
+    BridgeProfiler::Call call(m_profiler, "applyBatch");
+    TRACE_SCOPE("bridge", "applyBatch");
     int total = rowIndices.size();
     for (int i = 0; i < total; ++i) {
         int row = rowIndices[i].toInt();
@@ -173,6 +692,7 @@ void WebBridge::applyBatch(QJsonArray rowIndices)
 
 void WebBridge::saveCredentials(const QString &user, const QString &pass, bool save)
 {
+    BridgeProfiler::Call call(m_profiler, "saveCredentials");
     QSettings s;
     s.beginGroup(QStringLiteral("Credentials"));
     if (save && !user.isEmpty()) {
@@ -188,6 +708,7 @@ void WebBridge::saveCredentials(const QString &user, const QString &pass, bool s
 
 QJsonObject WebBridge::loadCredentials()
 {
+    BridgeProfiler::Call call(m_profiler, "loadCredentials");
     QSettings s;
     s.beginGroup(QStringLiteral("Credentials"));
     QJsonObject obj;
@@ -195,11 +716,12 @@ QJsonObject WebBridge::loadCredentials()
     obj[QStringLiteral("username")] = s.value(QStringLiteral("username"), QString()).toString();
     obj[QStringLiteral("password")] = s.value(QStringLiteral("password"), QString()).toString();
     s.endGroup();
-    return obj;
+    return call.payload(obj);
 }
 
 void WebBridge::clearCredentials()
 {
+    BridgeProfiler::Call call(m_profiler, "clearCredentials");
     QSettings s;
     s.beginGroup(QStringLiteral("Credentials"));
     s.remove(QStringLiteral(""));
@@ -209,6 +731,7 @@ void WebBridge::clearCredentials()
 
 void WebBridge::restartComputer()
 {
+    BridgeProfiler::Call call(m_profiler, "restartComputer");
 #ifdef Q_OS_WIN
     QProcess::startDetached(QStringLiteral("shutdown"), {"/r", "/t", "3", "/c", "ADAMV TWEAKS: Restarting to apply changes"});
 #else
@@ -219,5 +742,6 @@ void WebBridge::restartComputer()
 
 void WebBridge::closeApp()
 {
+    BridgeProfiler::Call call(m_profiler, "closeApp");
     emit closeAppRequested();
 }
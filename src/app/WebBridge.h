@@ -8,7 +8,9 @@
 #include <QSettings>
 
 #include "app/AppController.h"
+#include "app/BridgeProfiler.h"
 #include "app/LicenseManager.h"
+#include "app/StallWatchdog.h"
 
 /// Bridge between the HTML UI (via QWebChannel) and the C++ AppController.
 /// Exposes all data and actions as Q_INVOKABLE methods + signals.
@@ -23,17 +25,72 @@ public:
     // ── Data fetchers (called from JS) ──
     Q_INVOKABLE QJsonObject getSystemInfo();
     Q_INVOKABLE QJsonObject getMonitorData();
+    /// Whether monitor values are on screen. While hidden no samples are
+    /// pushed; becoming visible pushes a full snapshot right away.
+    Q_INVOKABLE void setMonitorVisible(bool visible);
+    /// JSON twin of getMonitorHistoryBulk(), for benchmarkBulkTransfer().
+    Q_INVOKABLE QJsonArray  getMonitorHistory();
     Q_INVOKABLE QJsonObject getScoreData();
+    Q_INVOKABLE QJsonObject getFpsMatrix();
+    Q_INVOKABLE QJsonArray  getLatencyResults();
+    /// Last core scan: { topology, modes: [...], cores: [...], slowCores,
+    /// smtGainPct, takenAtMs }; empty until runCoreScan() finished once.
+    Q_INVOKABLE QJsonObject getCoreScan();
     Q_INVOKABLE QJsonArray  getTweaks();
+    /// Tweak sync: the static catalog once, then state diffs.
+    /// getTweakCatalog() → { version, tweaks: [{row, id, name, ...}] } without
+    /// the mutable fields; getTweakState() → { version, bits } where bits holds
+    /// one TweakListModel::StateBit digit per row. After that,
+    /// tweakStateChanged pushes only the rows that changed.
+    Q_INVOKABLE QJsonObject getTweakCatalog();
+    Q_INVOKABLE QJsonObject getTweakState();
+
+    // ── Bulk transfers: base64 BulkPayload, decoded by readBulk() in the page ──
+    /// Numeric history is where bulk wins: f32 columns are ~1/5 of the JSON.
+    /// Feeds the page's memory pressure card: "t" (f64 ms) plus one f32
+    /// column per MonitorSample metric.
+    Q_INVOKABLE QString getMonitorHistoryBulk();
+    /// Kept for benchmarkBulkTransfer() only; the page loads the catalog as
+    /// JSON, which is smaller for an all-string table once base64 is added.
+    Q_INVOKABLE QString getTweakCatalogBulk();
+    /// Serialization time and size of each bulk payload against its JSON
+    /// equivalent: { tweakCatalog: { jsonBytes, jsonUs, bulkBytes, bulkUs }, ... }.
+    Q_INVOKABLE QJsonObject benchmarkBulkTransfer(int iterations = 50);
     Q_INVOKABLE QJsonArray  getCategories();
     Q_INVOKABLE int         getAppliedCount();
     Q_INVOKABLE int         getRecommendedCount();
     Q_INVOKABLE bool        getIsAdmin();
 
+    // ── Startup timing ──
+    /// Page-side milestone ("first paint", "interactive") reached agoMs ago.
+    Q_INVOKABLE void markStartup(const QString &milestone, double agoMs);
+    /// StartupTrace milestones: [{ name, ms }] since process start.
+    Q_INVOKABLE QJsonArray getStartupTrace();
+
+    // ── Bridge call profiling (BridgeProfiler.h) ──
+    Q_INVOKABLE void setBridgeProfiling(bool enabled);
+    /// Per-method counts, payload sizes, latency histograms and the calls
+    /// that blocked the event loop.
+    Q_INVOKABLE QJsonObject getBridgeDiagnostics();
+    /// The same as a JSON file under the app data folder; returns its path.
+    Q_INVOKABLE QString exportBridgeDiagnostics();
+
+    // ── Tracing (Trace.h) ──
+    Q_INVOKABLE void setTracing(bool enabled);
+    /// Write every span so far as Chrome trace JSON under the app data
+    /// folder; returns the file path, empty on failure.
+    Q_INVOKABLE QString exportTrace();
+
+    // ── GUI stall watchdog (StallWatchdog.h) ──
+    void setStallWatchdog(StallWatchdog *watchdog) { m_watchdog = watchdog; }
+    /// Recent event-loop stalls: [{ startedAt, durationMs, ongoing, operations, stack }].
+    Q_INVOKABLE QJsonArray getStalls();
+
     // ── License / Auth (async – results come via signals) ──
     Q_INVOKABLE void loginLicense(const QString &username, const QString &password);
     Q_INVOKABLE void activateLicense(const QString &key, const QString &username,
                                      const QString &password);
+    /// Empty until MachineIdentity is ready; hwidReady() delivers it then.
     Q_INVOKABLE QString getHwid();
     Q_INVOKABLE void checkHwidStatus(const QString &username);
 
@@ -46,6 +103,10 @@ public:
     Q_INVOKABLE void requestAdmin();
     Q_INVOKABLE void applyRecommended();
     Q_INVOKABLE void verifyAllTweaks();
+    Q_INVOKABLE void calibrateScores();     // result arrives via scoresChanged
+    Q_INVOKABLE void runPingTest();         // results stream via latencyUpdated, then pingDone
+    Q_INVOKABLE bool runCoreScan();         // false if a benchmark is running; else coreScanFinished
+    Q_INVOKABLE void resetCalibration();
 
     // Batch apply with progress
     Q_INVOKABLE void applyBatch(QJsonArray rowIndices);
@@ -60,18 +121,50 @@ public:
     Q_INVOKABLE void clearCredentials();
 
 signals:
-    void tweaksChanged();
-    void monitorUpdated();
+    /// { from, to, rows: { "<row>": bits } }. If `from` is not the state
+    /// version the page holds, it missed a diff and should call getTweakState().
+    void tweakStateChanged(const QJsonObject &diff);
+    /// The set of tweaks changed; refetch the catalog.
+    void tweakCatalogChanged();
+    void hardwareChanged();
+    void scoresChanged();
+    void latencyUpdated(const QJsonObject &stats);
+    void pingDone(double medianMs);
+    /// A core scan finished; getCoreScan() holds the result.
+    void coreScanFinished();
+    /// Compact JSON object of the monitor fields that changed since the last
+    /// push — every field after a visibility change. Merge into the previous
+    /// state; no getMonitorData() round trip is needed.
+    void monitorUpdated(const QString &delta);
     void batchProgress(int current, int total, QString name, QString status);
     void batchComplete();
     void loginResult(bool success, const QString &message);
     void activateResult(bool success, const QString &message);
     void hwidStatusResult(const QString &status, const QString &message);
+    /// The HWID, once known; getHwid() returns empty before that.
+    void hwidReady(const QString &hwid);
+    /// A login accepted offline did not survive revalidation; log out.
+    void licenseRevoked(const QString &message);
     void showRestartDialog();
     void closeAppRequested();
 
 private:
+    QJsonObject monitorSnapshot();
+    // Payload builders behind the fetchers, unprofiled for benchmarkBulkTransfer()
+    QJsonObject tweakCatalog() const;
+    QString     tweakCatalogBulk() const;
+    QJsonArray  monitorHistory() const;
+    QString     monitorHistoryBulk() const;
+    void pushMonitorDelta();
+    void pushTweakState();
+
     AppController  *m_ctrl;
     LicenseManager *m_license;
     QTimer m_pollTimer;
+    BridgeProfiler m_profiler;
+    StallWatchdog *m_watchdog = nullptr;
+    QJsonObject m_monitorSent;          // last state pushed to JS
+    bool m_monitorVisible = false;
+    QByteArray m_tweakBits;             // state as of m_tweakStateVersion
+    int m_tweakStateVersion = 0;
 };
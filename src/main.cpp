@@ -9,10 +9,19 @@
 #include <QIcon>
 #include <QPainterPath>
 #include <QCloseEvent>
+#include <QDebug>
+#include <QThread>
+#include <QTimer>
 
 #include "app/AppController.h"
 #include "app/WebBridge.h"
 #include "app/LicenseManager.h"
+#include "app/MachineIdentity.h"
+#include "app/StallWatchdog.h"
+#include "app/StartupTrace.h"
+#include "app/Trace.h"
+
+#include <algorithm>
 
 // Custom view that intercepts the close event to show restart dialog
 class TweakView : public QWebEngineView
@@ -96,6 +105,8 @@ static QIcon createAvIcon()
 
 int main(int argc, char *argv[])
 {
+    StartupTrace::mark(QStringLiteral("main"));
+    Trace::setEnabled(qEnvironmentVariableIntValue("TWEAK_TRACE") != 0);
     QApplication app(argc, argv);
     QApplication::setOrganizationName(QStringLiteral("ADAMV"));
     QApplication::setOrganizationDomain(QStringLiteral("adamv.local"));
@@ -103,10 +114,18 @@ int main(int argc, char *argv[])
     QApplication::setApplicationVersion(QStringLiteral("5.0.0"));
     app.setWindowIcon(createAvIcon());
 
+    // HWID and fingerprint are computed off the GUI thread; the hardware
+    // cache check waits for ready() rather than for the values
+    MachineIdentity::instance().start();
+
+    StallWatchdog watchdog;
+    watchdog.start();
+
     AppController controller;
     LicenseManager license;
 
     WebBridge bridge(&controller, &license);
+    bridge.setStallWatchdog(&watchdog);
     QWebChannel channel;
     channel.registerObject(QStringLiteral("bridge"), &bridge);
 
@@ -125,9 +144,35 @@ int main(int argc, char *argv[])
     view.setUrl(QUrl(QStringLiteral("qrc:/web/index.html")));
     view.setWindowTitle(QStringLiteral("ADAMV TWEAKS"));
     view.resize(1400, 860);
+    QObject::connect(&view, &QWebEngineView::loadFinished, [](bool) {
+        StartupTrace::mark(QStringLiteral("page loaded"));
+    });
     view.show();
+    StartupTrace::mark(QStringLiteral("window shown"));
+
+    // Heavy initialization starts once the event loop runs, so the window
+    // and page come up first; the page fills in as readiness signals arrive.
+    QTimer::singleShot(0, &controller, &AppController::initialize);
+
+    // TWEAK_STALL_TEST=<ms> blocks the GUI thread once after start-up
+    // (capped at 10 s) inside a traced span, so the watchdog's report can
+    // be checked on any platform. Deliberately not reachable from the page.
+    if (const int stallMs = qEnvironmentVariableIntValue("TWEAK_STALL_TEST"); stallMs > 0)
+        QTimer::singleShot(2000, &app, [stallMs]() {
+            TRACE_SCOPE("diagnostics", "injectStall");
+            QThread::msleep(ulong(std::min(stallMs, 10000)));
+        });
+
+    const int rc = app.exec();
 
-    return app.exec();
+    // A traced session leaves its timeline next to the app data
+    if (Trace::enabled()) {
+        const QString path = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+                           + QStringLiteral("/traces/session.json");
+        if (Trace::writeChromeJson(path))
+            qDebug() << "[Trace] Wrote" << path;
+    }
+    return rc;
 }
 
 #include "main.moc"
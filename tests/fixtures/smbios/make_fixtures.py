@@ -0,0 +1,131 @@
+#!/usr/bin/env python3
+"""
+Writes the SMBIOS tables tst_smbiosdecoder reads
+
+The structures follow DMTF DSP0134 field for field and carry the strings
+real boards report, so the decoder sees what it would on those machines:
+
+    desktop-ddr4.dmi    Linux /sys/firmware/dmi/tables/DMI of an AM4 desktop:
+                        SMBIOS 3.3, 4 slots, 2 x 16 GB DDR4-3200 dual rank
+                        on channels A and B, plus a flash array to ignore
+    laptop-ddr5.rsmb    Windows GetSystemFirmwareTable('RSMB') blob of a
+                        laptop: RawSMBIOSData header, 2 x 32 GB DDR5 using
+                        the extended size and speed fields, one channel on
+                        each of two controllers
+    unlabelled.dmi      2 modules whose locators name no channel
+
+Requires only the Python standard library.
+"""
+
+import os
+import struct
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+
+
+def structure(stype, handle, body, strings=()):
+    formatted = struct.pack("<BBH", stype, 4 + len(body), handle) + body
+    text = b"".join(s.encode() + b"\0" for s in strings)
+    return formatted + (text + b"\0" if strings else b"\0\0")
+
+
+def bios(vendor, version, date):
+    # 0x04 vendor, 0x05 version, 0x06 segment, 0x08 date, 0x09 ROM size,
+    # 0x0A characteristics, 0x12 extension bytes, 0x14 release, 0x16 EC, 0x18 ext ROM size
+    body = struct.pack("<BBHBBQHBBBBH", 1, 2, 0xF000, 3, 0xFF, 0x08, 0x0D03, 5, 17, 0xFF, 0xFF, 0x0020)
+    return structure(0, 0x0000, body, (vendor, version, date))
+
+
+def baseboard(manufacturer, product):
+    # 0x04..0x08 strings, 0x09 features, 0x0A location, 0x0B chassis, 0x0D type, 0x0E handles
+    body = struct.pack("<BBBBBBBHBB", 1, 2, 3, 4, 5, 0x09, 6, 0x0003, 0x0A, 0)
+    return structure(2, 0x0002, body, (manufacturer, product, "Rev X.0x", "Default string",
+                                        "Default string", "Default string"))
+
+
+def enclosure(chassis_byte):
+    # 0x04 manufacturer, 0x05 type (bit 7 = lock), 0x06..0x08 strings, 0x09..0x0C states
+    body = struct.pack("<BBBBBBBBB", 1, chassis_byte, 2, 3, 4, 3, 3, 3, 3)
+    return structure(3, 0x0003, body, ("Default string", "Default string",
+                                        "Default string", "Default string"))
+
+
+def memory_array(handle, use, devices, max_kb):
+    # 0x04 location, 0x05 use, 0x06 ECC, 0x07 max capacity, 0x0B error handle,
+    # 0x0D devices, 0x0F extended max capacity
+    body = struct.pack("<BBBIHHQ", 0x03, use, 0x03, max_kb, 0xFFFE, devices, 0)
+    return structure(16, handle, body)
+
+
+def memory_device(handle, array, size, device, bank, mem_type, speed, configured,
+                  ranks, ext_size=0, ext_speed=0, ext_configured=0, length=0x28):
+    populated = size != 0
+    body = struct.pack("<HHHHHBBBBBHHBBBBBIH",
+                       array, 0xFFFE, 64, 64, size, 0x09, 0,
+                       1, 2,                        # device, bank locator
+                       mem_type, 0x0080 if populated else 0x0004, speed,
+                       3, 4, 5, 6,                  # manufacturer, serial, asset, part
+                       ranks, ext_size, configured)
+    body += struct.pack("<HHH", 1200, 1200, 1200)   # min, max, configured voltage
+    if length > 0x28:
+        body += bytes(0x54 - 4 - len(body))         # 3.2 memory technology .. 3.3 fields
+        body += struct.pack("<II", ext_speed, ext_configured)
+    assert len(body) + 4 == length, (len(body) + 4, length)
+    vendor = ("Unknown", "Unknown", "Unknown", "Unknown") if not populated else \
+             ("G Skill Intl", "00000000", "Not Specified", "F4-3200C16-16GVK")
+    return structure(17, handle, body, (device, bank) + vendor)
+
+
+def end_of_table():
+    return structure(127, 0xFEFF, b"")
+
+
+def write(name, data):
+    with open(os.path.join(HERE, name), "wb") as f:
+        f.write(data)
+
+
+def main():
+    ddr4, ddr5 = 0x1A, 0x22
+    write("desktop-ddr4.dmi", b"".join([
+        bios("American Megatrends Inc.", "2423", "08/10/2021"),
+        baseboard("ASUSTeK COMPUTER INC.", "ROG STRIX B550-F GAMING"),
+        enclosure(0x83),                                   # desktop, lock bit set
+        memory_array(0x000A, 0x03, 4, 128 * 1024 * 1024),
+        memory_array(0x000B, 0x05, 1, 16 * 1024),          # flash, not system memory
+        memory_device(0x0010, 0x000A, 0, "DIMM_A1", "P0 CHANNEL A", 0x02, 0, 0, 0),
+        memory_device(0x0011, 0x000A, 16384, "DIMM_A2", "P0 CHANNEL A", ddr4, 3600, 3200, 2),
+        memory_device(0x0012, 0x000A, 0, "DIMM_B1", "P0 CHANNEL B", 0x02, 0, 0, 0),
+        memory_device(0x0013, 0x000A, 16384, "DIMM_B2", "P0 CHANNEL B", ddr4, 3600, 3200, 2),
+        end_of_table(),
+    ]))
+
+    table = b"".join([
+        bios("LENOVO", "N3HET82W (1.54 )", "11/15/2023"),
+        baseboard("LENOVO", "21CBCTO1WW"),
+        enclosure(0x0A),                                   # notebook
+        memory_array(0x0008, 0x03, 2, 0x80000000),
+        memory_device(0x0009, 0x0008, 0x7FFF, "Controller0-ChannelA-DIMM0", "BANK 0", ddr5,
+                      0xFFFF, 0xFFFF, 1, ext_size=32768, ext_speed=5600, ext_configured=5200,
+                      length=0x5C),
+        memory_device(0x000A, 0x0008, 0x7FFF, "Controller1-ChannelA-DIMM0", "BANK 0", ddr5,
+                      0xFFFF, 0xFFFF, 1, ext_size=32768, ext_speed=5600, ext_configured=5200,
+                      length=0x5C),
+        end_of_table(),
+    ])
+    # RawSMBIOSData: Used20CallingMethod, Major, Minor, DmiRevision, Length
+    write("laptop-ddr5.rsmb", struct.pack("<BBBBI", 0, 3, 4, 0, len(table)) + table)
+
+    write("unlabelled.dmi", b"".join([
+        bios("Dell Inc.", "1.17.0", "02/07/2022"),
+        baseboard("Dell Inc.", "0K8CW7"),
+        enclosure(0x23),                                   # mini PC
+        memory_array(0x1000, 0x03, 2, 64 * 1024 * 1024),
+        memory_device(0x1100, 0x1000, 8192, "DIMM 1", "Not Specified", ddr4, 2666, 2666, 1),
+        memory_device(0x1101, 0x1000, 8192, "DIMM 2", "Not Specified", ddr4, 2666, 2666, 1),
+        end_of_table(),
+    ]))
+
+
+if __name__ == "__main__":
+    main()
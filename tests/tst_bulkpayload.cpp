@@ -0,0 +1,166 @@
+#include "app/BulkPayload.h"
+
+#include <QTest>
+#include <QtEndian>
+
+/// Walks the buffer the way readBulk() in web/index.html does, so a layout
+/// change that would break the page's typed-array views fails here first.
+class TestBulkPayload : public QObject
+{
+    Q_OBJECT
+
+private:
+    struct Column
+    {
+        quint8     type = 0;
+        QByteArray name;
+        qsizetype  lengthAt = 0;    // offset of the u32 dataBytes
+        qsizetype  dataAt = 0;
+        quint32    dataBytes = 0;
+    };
+
+    static quint32 u32(const QByteArray &data, qsizetype at)
+    {
+        return qFromLittleEndian<quint32>(data.constData() + at);
+    }
+
+    static QList<Column> columns(const QByteArray &data)
+    {
+        QList<Column> out;
+        qsizetype pos = 12;
+        for (quint32 c = 0; c < u32(data, 8); ++c) {
+            Column col;
+            col.type = quint8(data.at(pos));
+            const int nameLength = quint8(data.at(pos + 1));
+            col.name = data.mid(pos + 2, nameLength);
+            col.lengthAt = (pos + 2 + nameLength + 3) & ~qsizetype(3);
+            col.dataBytes = u32(data, col.lengthAt);
+            col.dataAt = (col.lengthAt + 4 + 7) & ~qsizetype(7);
+            pos = col.dataAt + col.dataBytes;
+            out.append(col);
+        }
+        return out;
+    }
+
+private slots:
+    void header();
+    void columnAlignment();
+    void numericColumns();
+    void stringOffsets();
+    void padAndTruncate();
+    void base64RoundTrip();
+};
+
+void TestBulkPayload::header()
+{
+    BulkPayload bulk(3);
+    bulk.addInt32(QStringLiteral("a"), { 1, 2, 3 });
+    bulk.addBool(QStringLiteral("b"), { true, false, true });
+    const QByteArray data = bulk.toBytes();
+
+    QCOMPARE(data.left(4), QByteArray("TBP1"));
+    QCOMPARE(u32(data, 4), 3u);
+    QCOMPARE(u32(data, 8), 2u);
+
+    QCOMPARE(u32(BulkPayload(-5).toBytes(), 4), 0u);   // negative row counts clamp to 0
+}
+
+void TestBulkPayload::columnAlignment()
+{
+    // Name lengths 1..8 walk the padding through every remainder, and the
+    // odd-sized bool column shifts the start of the column after it
+    BulkPayload bulk(3);
+    for (int n = 1; n <= 8; ++n) {
+        bulk.addBool(QString(n, QLatin1Char('b')), { true, true, false });
+        bulk.addFloat64(QString(n, QLatin1Char('f')), { 1.0, 2.0, 3.0 });
+    }
+    const QByteArray data = bulk.toBytes();
+    const QList<Column> cols = columns(data);
+    QCOMPARE(cols.size(), 16);
+
+    for (const Column &col : cols) {
+        QCOMPARE(col.lengthAt % 4, 0);
+        QCOMPARE(col.dataAt % 8, 0);                   // Float64Array needs this
+        QVERIFY(col.dataAt + col.dataBytes <= data.size());
+    }
+    QCOMPARE(cols.last().dataAt + cols.last().dataBytes, data.size());   // no trailing bytes
+    QCOMPARE(cols.at(14).name, QByteArray("bbbbbbbb"));
+    QCOMPARE(cols.at(14).type, quint8(BulkPayload::ColumnType::Bool));
+    QCOMPARE(cols.at(15).type, quint8(BulkPayload::ColumnType::Float64));
+}
+
+void TestBulkPayload::numericColumns()
+{
+    BulkPayload bulk(3);
+    bulk.addFloat64(QStringLiteral("t"), { 1700000000123.0, -0.5, 2.25 });
+    bulk.addFloat32(QStringLiteral("cpu"), { 12.5, 99.75, 0.0 });
+    bulk.addInt32(QStringLiteral("row"), { -1, 0, 2147483647 });
+    bulk.addBool(QStringLiteral("on"), { false, true, true });
+    const QByteArray data = bulk.toBytes();
+    const QList<Column> cols = columns(data);
+    QCOMPARE(cols.size(), 4);
+
+    QCOMPARE(cols.at(0).dataBytes, 24u);
+    QCOMPARE(qFromLittleEndian<double>(data.constData() + cols.at(0).dataAt), 1700000000123.0);
+    QCOMPARE(qFromLittleEndian<double>(data.constData() + cols.at(0).dataAt + 16), 2.25);
+
+    QCOMPARE(cols.at(1).dataBytes, 12u);
+    QCOMPARE(qFromLittleEndian<float>(data.constData() + cols.at(1).dataAt + 4), 99.75f);
+
+    QCOMPARE(cols.at(2).dataBytes, 12u);
+    QCOMPARE(qFromLittleEndian<qint32>(data.constData() + cols.at(2).dataAt), -1);
+    QCOMPARE(qFromLittleEndian<qint32>(data.constData() + cols.at(2).dataAt + 8), 2147483647);
+
+    QCOMPARE(cols.at(3).dataBytes, 3u);               // one byte per row
+    QCOMPARE(data.mid(cols.at(3).dataAt, 3), QByteArray("\x00\x01\x01", 3));
+}
+
+void TestBulkPayload::stringOffsets()
+{
+    const QStringList values = { QStringLiteral("Game Mode"), QString(),
+                                 QStringLiteral("Hintergrund-Apps überprüfen") };
+    BulkPayload bulk(3);
+    bulk.addString(QStringLiteral("name"), values);
+    const QByteArray data = bulk.toBytes();
+    const Column col = columns(data).first();
+    QCOMPARE(col.type, quint8(BulkPayload::ColumnType::String));
+
+    // u32 offsets[rows + 1], then the UTF-8 bytes they index
+    const qsizetype text = col.dataAt + 4 * 4;
+    QCOMPARE(u32(data, col.dataAt), 0u);
+    for (int r = 0; r < values.size(); ++r) {
+        const quint32 from = u32(data, col.dataAt + r * 4);
+        const quint32 to   = u32(data, col.dataAt + (r + 1) * 4);
+        QCOMPARE(QString::fromUtf8(data.mid(text + from, to - from)), values.at(r));
+    }
+    QCOMPARE(col.dataBytes, 4 * 4 + u32(data, col.dataAt + 3 * 4));
+}
+
+void TestBulkPayload::padAndTruncate()
+{
+    BulkPayload bulk(3);
+    bulk.addInt32(QStringLiteral("short"), { 7 });
+    bulk.addInt32(QStringLiteral("long"), { 1, 2, 3, 4, 5 });
+    bulk.addString(QStringLiteral("s"), { QStringLiteral("x") });
+    const QByteArray data = bulk.toBytes();
+    const QList<Column> cols = columns(data);
+
+    QCOMPARE(cols.at(0).dataBytes, 12u);
+    QCOMPARE(qFromLittleEndian<qint32>(data.constData() + cols.at(0).dataAt + 4), 0);
+    QCOMPARE(cols.at(1).dataBytes, 12u);
+    QCOMPARE(qFromLittleEndian<qint32>(data.constData() + cols.at(1).dataAt + 8), 3);
+
+    // Missing strings are empty: the last two offsets repeat
+    QCOMPARE(u32(data, cols.at(2).dataAt + 4), 1u);
+    QCOMPARE(u32(data, cols.at(2).dataAt + 12), 1u);
+}
+
+void TestBulkPayload::base64RoundTrip()
+{
+    BulkPayload bulk(2);
+    bulk.addFloat32(QStringLiteral("v"), { 1.0, 2.0 });
+    QCOMPARE(QByteArray::fromBase64(bulk.toBase64().toLatin1()), bulk.toBytes());
+}
+
+QTEST_APPLESS_MAIN(TestBulkPayload)
+#include "tst_bulkpayload.moc"
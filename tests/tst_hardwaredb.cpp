@@ -0,0 +1,172 @@
+#include "app/HardwareDb.h"
+#include "app/PatternAutomaton.h"
+
+#include <QTest>
+
+/// Model lookup over a small inline DB (HwDbIndex), and the built-in
+/// fallback matcher HardwareScorer compiles its tables into (PatternMatch).
+class TestHardwareDb : public QObject
+{
+    Q_OBJECT
+
+private:
+    static HwDbIndex index(const QStringList &keys)
+    {
+        QList<HwDbEntry> entries;
+        for (const QString &key : keys) {
+            HwDbEntry e;
+            e.key   = key;
+            e.model = key;
+            e.score = 50;
+            entries.append(e);
+        }
+        HwDbIndex idx;
+        idx.build(entries);
+        return idx;
+    }
+
+    static QString key(const HwDbEntry *entry)
+    {
+        return entry ? entry->key : QStringLiteral("<none>");
+    }
+
+private slots:
+    void tokenize();
+    void findCpu_data();
+    void findCpu();
+    void findGpu_data();
+    void findGpu();
+    void emptyIndex();
+    void automatonLongestMatch_data();
+    void automatonLongestMatch();
+    void automatonTies();
+};
+
+void TestHardwareDb::tokenize()
+{
+    QCOMPARE(HwDbIndex::tokenize(QStringLiteral("Intel(R) Core(TM) i7-13700KF")),
+             QStringList({ "INTEL", "R", "CORE", "TM", "I7", "13700KF" }));
+    QCOMPARE(HwDbIndex::tokenize(QStringLiteral("  ")), QStringList());
+}
+
+void TestHardwareDb::findCpu_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<QString>("expected");
+
+    // Suffix variants fall back to the base model by prefix
+    QTest::newRow("13700KF → 13700K") << QStringLiteral("13th Gen Intel(R) Core(TM) i7-13700KF")
+        << QStringLiteral("13700K");
+    // A plain-digit model must not pick up its K sibling
+    QTest::newRow("14900 → 14900") << QStringLiteral("Intel(R) Core(TM) i9-14900")
+        << QStringLiteral("14900");
+    QTest::newRow("14900K exact") << QStringLiteral("Intel(R) Core(TM) i9-14900K")
+        << QStringLiteral("14900K");
+    // The X3D part is its own entry, not the 7800X
+    QTest::newRow("7800X3D") << QStringLiteral("AMD Ryzen 7 7800X3D 8-Core Processor")
+        << QStringLiteral("7800X3D");
+    QTest::newRow("7800X") << QStringLiteral("AMD Ryzen 7 7800X") << QStringLiteral("7800X");
+    QTest::newRow("unknown") << QStringLiteral("Intel(R) Pentium(R) CPU G4560 @ 3.50GHz")
+        << QStringLiteral("<none>");
+}
+
+void TestHardwareDb::findCpu()
+{
+    QFETCH(QString, name);
+    const HwDbIndex cpus = index({ "13700K", "14900K", "14900", "7800X", "7800X3D", "5600" });
+    QTEST(key(cpus.find(name)), "expected");
+}
+
+void TestHardwareDb::findGpu_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("Ti Super") << QStringLiteral("NVIDIA GeForce RTX 4070 Ti SUPER")
+        << QStringLiteral("RTX 4070 Ti Super");
+    QTest::newRow("Super") << QStringLiteral("NVIDIA GeForce RTX 4070 SUPER")
+        << QStringLiteral("RTX 4070 Super");
+    QTest::newRow("Ti") << QStringLiteral("NVIDIA GeForce RTX 4070 Ti")
+        << QStringLiteral("RTX 4070 Ti");
+    QTest::newRow("plain") << QStringLiteral("NVIDIA GeForce RTX 4070")
+        << QStringLiteral("RTX 4070");
+    QTest::newRow("other family") << QStringLiteral("NVIDIA GeForce GTX 1070")
+        << QStringLiteral("<none>");
+}
+
+void TestHardwareDb::findGpu()
+{
+    QFETCH(QString, name);
+    const HwDbIndex gpus = index({ "RTX 4070", "RTX 4070 Ti", "RTX 4070 Super", "RTX 4070 Ti Super" });
+    QTEST(key(gpus.find(name)), "expected");
+}
+
+void TestHardwareDb::emptyIndex()
+{
+    const HwDbIndex none;
+    QVERIFY(!none.find(QStringLiteral("RTX 4070")));
+}
+
+// ---------------------------------------------------------------------------
+// PatternMatch
+// ---------------------------------------------------------------------------
+namespace {
+
+struct Keyword { const char *keyword; int score; };
+
+// Listed shortest first, so table order cannot be what picks the winner
+constexpr Keyword gpuKeywords[] = {
+    {"RTX 4070", 83}, {"RTX 4070 Ti", 88}, {"RTX 4070 Super", 86},
+    {"RTX 4070 Ti Super", 90}, {"RX 7600", 68}, {"RX 6600", 55},
+    {"RX 6600", 10},
+};
+static_assert(PatternMatch::validKeywords(gpuKeywords), "letters, digits and spaces only");
+
+constexpr auto gpuMatcher =
+    PatternMatch::Automaton<PatternMatch::stateBound(gpuKeywords)>::build(gpuKeywords);
+
+// Built at compile time, so it can be queried at compile time too
+constexpr char kTiSuper[] = "GeForce RTX 4070 Ti SUPER";
+static_assert(gpuMatcher.find(kTiSuper, sizeof(kTiSuper) - 1).index == 3, "longest keyword wins");
+
+} // anonymous namespace
+
+void TestHardwareDb::automatonLongestMatch_data()
+{
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<int>("index");
+
+    QTest::newRow("Ti Super") << QStringLiteral("NVIDIA GeForce RTX 4070 Ti SUPER") << 3;
+    QTest::newRow("Super") << QStringLiteral("NVIDIA GeForce RTX 4070 SUPER") << 2;
+    QTest::newRow("Ti") << QStringLiteral("NVIDIA GeForce RTX 4070 Ti") << 1;
+    QTest::newRow("plain") << QStringLiteral("NVIDIA GeForce RTX 4070") << 0;
+    // Punctuation breaks a match instead of being skipped
+    QTest::newRow("hyphen") << QStringLiteral("RTX-4070") << -1;
+    QTest::newRow("none") << QStringLiteral("Intel UHD Graphics 630") << -1;
+}
+
+void TestHardwareDb::automatonLongestMatch()
+{
+    QFETCH(QString, name);
+    const PatternMatch::Match m = gpuMatcher.find(name.utf16(), size_t(name.size()));
+    QTEST(m.index, "index");
+    QCOMPARE(m.found(), m.index >= 0);
+    if (m.found())
+        QCOMPARE(m.length, int(qstrlen(gpuKeywords[m.index].keyword)));
+}
+
+void TestHardwareDb::automatonTies()
+{
+    // Same length: the higher score wins, wherever it occurs in the text
+    const QString both = QStringLiteral("Radeon RX 6600 / RX 7600");
+    QCOMPARE(gpuMatcher.find(both.utf16(), size_t(both.size())).index, 4);
+
+    // A duplicate keyword keeps the first entry's score
+    const QString dup = QStringLiteral("RX 6600");
+    const PatternMatch::Match m = gpuMatcher.find(dup.utf16(), size_t(dup.size()));
+    QCOMPARE(m.index, 5);
+    QCOMPARE(m.score, 55);
+}
+
+QTEST_APPLESS_MAIN(TestHardwareDb)
+#include "tst_hardwaredb.moc"
@@ -0,0 +1,173 @@
+#include "app/LatencyProbe.h"
+
+#include <QElapsedTimer>
+#include <QNetworkDatagram>
+#include <QSignalSpy>
+#include <QTcpServer>
+#include <QTest>
+#include <QTimer>
+#include <QUdpSocket>
+
+/// Probes echo servers on 127.0.0.1, so RTTs and losses are known up front.
+class TestLatencyProbe : public QObject
+{
+    Q_OBJECT
+
+private:
+    /// UDP echo that answers each datagram after delayMs; never, if negative.
+    static QUdpSocket *udpEcho(QObject *parent, int delayMs)
+    {
+        auto *socket = new QUdpSocket(parent);
+        if (!socket->bind(QHostAddress(QHostAddress::LocalHost), 0))
+            qFatal("cannot bind UDP echo: %s", qPrintable(socket->errorString()));
+        if (delayMs < 0)
+            return socket;
+        connect(socket, &QUdpSocket::readyRead, socket, [socket, delayMs]() {
+            while (socket->hasPendingDatagrams()) {
+                const QNetworkDatagram request = socket->receiveDatagram();
+                QTimer::singleShot(delayMs, Qt::PreciseTimer, socket, [socket, request]() {
+                    socket->writeDatagram(request.makeReply(request.data()));
+                });
+            }
+        });
+        return socket;
+    }
+
+    static LatencyProbe::Target udpTarget(const QString &name, const QUdpSocket *echo)
+    {
+        return { name, QStringLiteral("127.0.0.1"), echo->localPort(), LatencyProbe::Protocol::UdpEcho };
+    }
+
+    static LatencyProbe::Target tcpTarget(const QString &name, const QString &host, quint16 port)
+    {
+        return { name, host, port, LatencyProbe::Protocol::TcpConnect };
+    }
+
+    /// Run to completion; the wall time of the whole run in ms.
+    static qint64 run(LatencyProbe &probe, const QList<LatencyProbe::Target> &targets,
+                      const LatencyProbe::Options &options)
+    {
+        QSignalSpy finished(&probe, &LatencyProbe::finished);
+        QElapsedTimer timer;
+        timer.start();
+        probe.start(targets, options);
+        if (!finished.wait(10000))
+            qFatal("latency probe did not finish");
+        return timer.elapsed();
+    }
+
+    static LatencyProbe::Stats statsFor(const LatencyProbe &probe, const QString &name)
+    {
+        for (const LatencyProbe::Stats &s : probe.results())
+            if (s.name == name)
+                return s;
+        return {};
+    }
+
+private slots:
+    void echoRoundTrips();
+    void targetsRunConcurrently();
+    void udpTimeout();
+    void refusedTcpCountsAsReply();
+    void unreachableHost();
+};
+
+void TestLatencyProbe::echoRoundTrips()
+{
+    QTcpServer server;
+    QVERIFY(server.listen(QHostAddress(QHostAddress::LocalHost), 0));
+    QObject scope;
+    const QUdpSocket *echo = udpEcho(&scope, 40);
+
+    LatencyProbe probe;
+    QSignalSpy probes(&probe, &LatencyProbe::probeFinished);
+    run(probe, { tcpTarget(QStringLiteral("tcp"), QStringLiteral("127.0.0.1"), server.serverPort()),
+                 udpTarget(QStringLiteral("udp"), echo) },
+        { 3, 20, 1000 });
+
+    QCOMPARE(probes.size(), 6);
+    const LatencyProbe::Stats tcp = statsFor(probe, QStringLiteral("tcp"));
+    QCOMPARE(tcp.sent, 3);
+    QCOMPARE(tcp.received, 3);
+    QVERIFY(tcp.maxMs < 1000);
+
+    const LatencyProbe::Stats udp = statsFor(probe, QStringLiteral("udp"));
+    QCOMPARE(udp.received, 3);
+    QCOMPARE(udp.lossPct(), 0.0);
+    QVERIFY2(udp.minMs >= 40, qPrintable(QString::number(udp.minMs)));   // the echo's delay
+    QVERIFY(udp.maxMs < 1000);
+    QVERIFY(udp.minMs <= udp.medianMs && udp.medianMs <= udp.p95Ms && udp.p95Ms <= udp.maxMs);
+    QVERIFY(probe.medianRttMs() >= 0);
+}
+
+void TestLatencyProbe::targetsRunConcurrently()
+{
+    // Four targets answering after 200 ms: one target after another takes
+    // over 800 ms, overlapping them one RTT plus the probe spacing
+    QObject scope;
+    QList<LatencyProbe::Target> targets;
+    for (int i = 0; i < 4; ++i)
+        targets.append(udpTarget(QStringLiteral("udp%1").arg(i), udpEcho(&scope, 200)));
+
+    LatencyProbe probe;
+    const qint64 elapsed = run(probe, targets, { 3, 10, 1000 });
+    for (const LatencyProbe::Stats &s : probe.results())
+        QCOMPARE(s.received, 3);
+    QVERIFY2(elapsed < 500, qPrintable(QStringLiteral("%1 ms").arg(elapsed)));
+}
+
+void TestLatencyProbe::udpTimeout()
+{
+    QObject scope;
+    const QUdpSocket *silent = udpEcho(&scope, -1);
+
+    LatencyProbe probe;
+    QSignalSpy probes(&probe, &LatencyProbe::probeFinished);
+    const qint64 elapsed = run(probe, { udpTarget(QStringLiteral("silent"), silent) }, { 2, 10, 200 });
+
+    QCOMPARE(probes.size(), 2);
+    for (const QList<QVariant> &args : probes)
+        QCOMPARE(args.at(2).toDouble(), -1.0);
+    const LatencyProbe::Stats s = statsFor(probe, QStringLiteral("silent"));
+    QCOMPARE(s.sent, 2);
+    QCOMPARE(s.received, 0);
+    QCOMPARE(s.lossPct(), 100.0);
+    QCOMPARE(probe.medianRttMs(), -1.0);
+    QVERIFY(elapsed >= 190);                 // coarse timers may fire 5% early
+}
+
+void TestLatencyProbe::refusedTcpCountsAsReply()
+{
+    // A port that was just free: the RST still measures the round trip
+    quint16 port = 0;
+    {
+        QTcpServer server;
+        QVERIFY(server.listen(QHostAddress(QHostAddress::LocalHost), 0));
+        port = server.serverPort();
+    }
+
+    LatencyProbe probe;
+    run(probe, { tcpTarget(QStringLiteral("closed"), QStringLiteral("127.0.0.1"), port) }, { 2, 10, 1000 });
+    const LatencyProbe::Stats s = statsFor(probe, QStringLiteral("closed"));
+    QCOMPARE(s.received, 2);
+    QVERIFY(s.maxMs < 1000);
+}
+
+void TestLatencyProbe::unreachableHost()
+{
+    // TEST-NET-1 (RFC 5737) is never routed: lost by timeout or by a
+    // host-unreachable error, whichever the network reports first
+    LatencyProbe probe;
+    QSignalSpy probes(&probe, &LatencyProbe::probeFinished);
+    const qint64 elapsed = run(probe, { tcpTarget(QStringLiteral("void"), QStringLiteral("192.0.2.1"), 443) },
+                               { 2, 10, 300 });
+
+    QCOMPARE(probes.size(), 2);
+    const LatencyProbe::Stats s = statsFor(probe, QStringLiteral("void"));
+    QCOMPARE(s.received, 0);
+    QCOMPARE(s.lossPct(), 100.0);
+    QVERIFY(elapsed < 2000);                 // bounded by the per-probe timeout
+}
+
+QTEST_GUILESS_MAIN(TestLatencyProbe)
+#include "tst_latencyprobe.moc"
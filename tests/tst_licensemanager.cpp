@@ -0,0 +1,399 @@
+#include "app/LicenseManager.h"
+#include "app/MachineIdentity.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMessageAuthenticationCode>
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTest>
+
+namespace {
+
+// Must match kXorKey in src/app/LicenseManager.cpp
+const unsigned char kXorKey[32] = {
+    0x54,0x77,0x65,0x61,0x6B,0x4C,0x69,0x63,
+    0x65,0x6E,0x73,0x65,0x4B,0x65,0x79,0x21,
+    0xAB,0xCD,0xEF,0x01,0x23,0x45,0x67,0x89,
+    0xDE,0xAD,0xBE,0xEF,0xCA,0xFE,0xBA,0xBE
+};
+
+QByteArray xorKey()
+{
+    return QByteArray(reinterpret_cast<const char *>(kXorKey), sizeof(kXorKey));
+}
+
+QByteArray encrypt(const QByteArray &data)
+{
+    const QByteArray key = xorKey();
+    QByteArray out = data;
+    for (int i = 0; i < out.size(); ++i)
+        out[i] = out[i] ^ key[i % key.size()];
+    return out.toBase64();
+}
+
+QByteArray decrypt(const QByteArray &data)
+{
+    const QByteArray key = xorKey();
+    QByteArray raw = QByteArray::fromBase64(data);
+    for (int i = 0; i < raw.size(); ++i)
+        raw[i] = raw[i] ^ key[i % key.size()];
+    return raw;
+}
+
+QString passHash(const QString &password)
+{
+    return QString::fromLatin1(QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex());
+}
+
+} // anonymous namespace
+
+/// The GitHub contents API as LicenseManager uses it — GET and sha-checked
+/// PUT of encrypted files — from memory on 127.0.0.1, like
+/// tools/fake_license_api.py. One request per connection.
+class FakeLicenseApi : public QObject
+{
+public:
+    explicit FakeLicenseApi(QObject *parent = nullptr)
+        : QObject(parent)
+    {
+        if (!m_server.listen(QHostAddress(QHostAddress::LocalHost), 0))
+            qFatal("cannot listen: %s", qPrintable(m_server.errorString()));
+        connect(&m_server, &QTcpServer::newConnection, this, [this]() {
+            while (QTcpSocket *socket = m_server.nextPendingConnection()) {
+                connect(socket, &QTcpSocket::readyRead, this, [this, socket]() { serve(socket); });
+                connect(socket, &QTcpSocket::disconnected, socket, &QObject::deleteLater);
+            }
+        });
+    }
+
+    QString baseUrl() const { return QStringLiteral("http://127.0.0.1:%1").arg(m_server.serverPort()); }
+
+    void setOutage(bool on) { m_outage = on; }
+    int  requests() const   { return m_requests; }
+
+    /// Store licenses in their key shards and index their usernames.
+    void seed(const QJsonArray &licenses)
+    {
+        for (const QJsonValue &v : licenses) {
+            const QJsonObject lic = v.toObject();
+            const QString key = lic.value(QStringLiteral("key")).toString();
+            QJsonArray shard = read(LicenseManager::keyShardPath(key)).array();
+            shard.append(lic);
+            write(LicenseManager::keyShardPath(key), QJsonDocument(shard));
+
+            const QString user = lic.value(QStringLiteral("username")).toString();
+            if (user.isEmpty())
+                continue;
+            QJsonObject index = read(LicenseManager::userShardPath(user)).object();
+            index[user.toLower()] = key;
+            write(LicenseManager::userShardPath(user), QJsonDocument(index));
+        }
+    }
+
+    /// Delete username's license and index entry, as /_admin/revoke.
+    void revoke(const QString &username)
+    {
+        const QString path = LicenseManager::userShardPath(username);
+        QJsonObject index = read(path).object();
+        const QString key = index.take(username.toLower()).toString();
+        write(path, QJsonDocument(index));
+
+        QJsonArray shard = read(LicenseManager::keyShardPath(key)).array();
+        for (int i = shard.size() - 1; i >= 0; --i)
+            if (shard.at(i).toObject().value(QStringLiteral("key")).toString() == key)
+                shard.removeAt(i);
+        write(LicenseManager::keyShardPath(key), QJsonDocument(shard));
+    }
+
+    QJsonObject license(const QString &key) const
+    {
+        for (const QJsonValue &v : read(LicenseManager::keyShardPath(key)).array())
+            if (v.toObject().value(QStringLiteral("key")).toString() == key)
+                return v.toObject();
+        return {};
+    }
+
+private:
+    QJsonDocument read(const QString &path) const
+    {
+        return m_files.contains(path) ? QJsonDocument::fromJson(decrypt(m_files.value(path)))
+                                      : QJsonDocument();
+    }
+
+    void write(const QString &path, const QJsonDocument &doc)
+    {
+        m_files[path] = encrypt(doc.toJson(QJsonDocument::Compact));
+    }
+
+    static QByteArray sha(const QByteArray &data)
+    {
+        return QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex();
+    }
+
+    void serve(QTcpSocket *socket)
+    {
+        QByteArray &buffer = m_buffers[socket];
+        buffer += socket->readAll();
+        const int headerEnd = buffer.indexOf("\r\n\r\n");
+        if (headerEnd < 0)
+            return;
+        const QList<QByteArray> lines = buffer.left(headerEnd).split('\n');
+        qint64 length = 0;
+        for (const QByteArray &line : lines)
+            if (line.toLower().startsWith("content-length:"))
+                length = line.mid(15).trimmed().toLongLong();
+        if (buffer.size() < headerEnd + 4 + length)
+            return;
+
+        const QList<QByteArray> request = lines.first().trimmed().split(' ');
+        const QByteArray body = buffer.mid(headerEnd + 4, length);
+        m_buffers.remove(socket);
+        ++m_requests;
+
+        const QByteArray target = request.value(1);
+        const int at = target.indexOf("/contents/");
+        if (m_outage)
+            reply(socket, 503, QJsonObject{ { QStringLiteral("message"), QStringLiteral("Service Unavailable") } });
+        else if (at < 0)
+            reply(socket, 404, {});
+        else if (request.value(0) == "GET")
+            get(socket, QString::fromUtf8(target.mid(at + 10)));
+        else if (request.value(0) == "PUT")
+            put(socket, QString::fromUtf8(target.mid(at + 10)), QJsonDocument::fromJson(body).object());
+        else
+            reply(socket, 405, {});
+    }
+
+    void get(QTcpSocket *socket, const QString &path)
+    {
+        if (!m_files.contains(path)) {
+            reply(socket, 404, QJsonObject{ { QStringLiteral("message"), QStringLiteral("Not Found") } });
+            return;
+        }
+        const QByteArray data = m_files.value(path);
+        reply(socket, 200, QJsonObject{
+            { QStringLiteral("path"),     path },
+            { QStringLiteral("sha"),      QString::fromLatin1(sha(data)) },
+            { QStringLiteral("encoding"), QStringLiteral("base64") },
+            { QStringLiteral("content"),  QString::fromLatin1(data.toBase64()) },
+        });
+    }
+
+    void put(QTcpSocket *socket, const QString &path, const QJsonObject &body)
+    {
+        // GitHub: a stale sha is 409, a missing sha for an existing file 422
+        const QString given = body.value(QStringLiteral("sha")).toString();
+        if (m_files.contains(path) && given.isEmpty()) {
+            reply(socket, 422, {});
+            return;
+        }
+        if (!given.isEmpty() && (!m_files.contains(path) || given.toLatin1() != sha(m_files.value(path)))) {
+            reply(socket, 409, {});
+            return;
+        }
+        m_files[path] = QByteArray::fromBase64(body.value(QStringLiteral("content")).toString().toLatin1());
+        reply(socket, 200, QJsonObject{ { QStringLiteral("content"), QJsonObject{
+            { QStringLiteral("path"), path },
+            { QStringLiteral("sha"),  QString::fromLatin1(sha(m_files.value(path))) } } } });
+    }
+
+    static void reply(QTcpSocket *socket, int status, const QJsonObject &body)
+    {
+        const QByteArray data = QJsonDocument(body).toJson(QJsonDocument::Compact);
+        socket->write("HTTP/1.1 " + QByteArray::number(status) + " X\r\n"
+                      "Content-Type: application/json\r\n"
+                      "Content-Length: " + QByteArray::number(data.size()) + "\r\n"
+                      "Connection: close\r\n\r\n" + data);
+        socket->disconnectFromHost();
+    }
+
+    QTcpServer                        m_server;
+    QHash<QString, QByteArray>        m_files;      // path -> encrypted content
+    QHash<QTcpSocket *, QByteArray>   m_buffers;
+    bool                              m_outage = false;
+    int                               m_requests = 0;
+};
+
+/// LicenseManager against FakeLicenseApi, with the token and identity
+/// files in Qt's test-mode AppData folder.
+class TestLicenseManager : public QObject
+{
+    Q_OBJECT
+
+private:
+    static const inline QString kKey  = QStringLiteral("TEST-0001-0000-0000");
+    static const inline QString kUser = QStringLiteral("user1");
+    static const inline QString kPass = QStringLiteral("test");
+
+    static QString tokenPath()
+    {
+        return QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)
+               + QStringLiteral("/license.token");
+    }
+
+    /// A token for kUser on this machine, signed as LicenseManager signs
+    /// it, validated ageDays ago.
+    static void writeToken(int ageDays)
+    {
+        const QString hwid = MachineIdentity::instance().hwid();
+        const QJsonObject obj{
+            { QStringLiteral("username"),     kUser },
+            { QStringLiteral("password"),     passHash(kPass) },
+            { QStringLiteral("hwid"),         hwid },
+            { QStringLiteral("validated_at"), double(QDateTime::currentSecsSinceEpoch() - qint64(ageDays) * 86400) },
+        };
+        const QByteArray payload = QJsonDocument(obj).toJson(QJsonDocument::Compact);
+        const QByteArray key = QCryptographicHash::hash(xorKey() + hwid.toLatin1(), QCryptographicHash::Sha256);
+        const QByteArray signature = QMessageAuthenticationCode::hash(payload, key, QCryptographicHash::Sha256);
+
+        const auto options = QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals;
+        QDir().mkpath(QFileInfo(tokenPath()).absolutePath());
+        QFile f(tokenPath());
+        QVERIFY(f.open(QIODevice::WriteOnly));
+        f.write(payload.toBase64(options) + '.' + signature.toBase64(options));
+    }
+
+    /// Log in and return the loginResult arguments.
+    static QList<QVariant> login(LicenseManager &license)
+    {
+        QSignalSpy result(&license, &LicenseManager::loginResult);
+        license.login(kUser, kPass);
+        if (result.isEmpty() && !result.wait(5000))
+            return {};
+        return result.takeFirst();
+    }
+
+    FakeLicenseApi *m_api = nullptr;
+    LicenseManager *m_license = nullptr;
+
+private slots:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void onlineLoginWritesToken();
+    void cachedLoginDuringOutage();
+    void revokeEmitsLicenseRevoked();
+    void graceTokenAsksServerFirst();
+    void graceTokenCoversOutage();
+    void expiredTokenRefused();
+    void wrongPasswordRefused();
+};
+
+void TestLicenseManager::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    MachineIdentity::instance().start();
+}
+
+void TestLicenseManager::init()
+{
+    QFile::remove(tokenPath());
+    m_api = new FakeLicenseApi(this);
+    m_api->seed(QJsonArray{ QJsonObject{
+        { QStringLiteral("key"),              kKey },
+        { QStringLiteral("username"),         kUser },
+        { QStringLiteral("password"),         passHash(kPass) },
+        { QStringLiteral("hwid"),             QString() },
+        { QStringLiteral("hwid_resets"),      0 },
+        { QStringLiteral("max_resets"),       3 },
+        { QStringLiteral("last_hwid_change"), QString() },
+    } });
+    m_license = new LicenseManager(this);
+    m_license->setApiBase(m_api->baseUrl());
+}
+
+void TestLicenseManager::cleanup()
+{
+    delete m_license;
+    delete m_api;
+    QFile::remove(tokenPath());
+}
+
+void TestLicenseManager::onlineLoginWritesToken()
+{
+    const QList<QVariant> result = login(*m_license);
+    QCOMPARE(result.value(0).toBool(), true);
+    QVERIFY(QFile::exists(tokenPath()));
+    // The login bound the unbound license to this machine
+    QCOMPARE(m_api->license(kKey).value(QStringLiteral("hwid")).toString(),
+             MachineIdentity::instance().hwid());
+}
+
+void TestLicenseManager::cachedLoginDuringOutage()
+{
+    QCOMPARE(login(*m_license).value(0).toBool(), true);
+
+    m_api->setOutage(true);
+    const QList<QVariant> result = login(*m_license);
+    QCOMPARE(result.value(0).toBool(), true);
+    QCOMPARE(result.value(1).toString(), QStringLiteral("Welcome back!"));
+    QVERIFY(QFile::exists(tokenPath()));     // a deferred revalidation keeps it
+}
+
+void TestLicenseManager::revokeEmitsLicenseRevoked()
+{
+    QCOMPARE(login(*m_license).value(0).toBool(), true);
+
+    m_api->revoke(kUser);
+    QSignalSpy revoked(m_license, &LicenseManager::licenseRevoked);
+    // Accepted from the fresh token, then refused by the revalidation
+    QCOMPARE(login(*m_license).value(0).toBool(), true);
+    QTRY_COMPARE_WITH_TIMEOUT(revoked.size(), 1, 5000);
+    QVERIFY(!QFile::exists(tokenPath()));
+}
+
+void TestLicenseManager::graceTokenAsksServerFirst()
+{
+    writeToken(LicenseManager::kTokenLifetimeDays + 2);
+    m_api->revoke(kUser);
+
+    const QList<QVariant> result = login(*m_license);
+    QCOMPARE(result.value(0).toBool(), false);
+    QVERIFY(m_api->requests() > 0);
+    QVERIFY(!QFile::exists(tokenPath()));
+}
+
+void TestLicenseManager::graceTokenCoversOutage()
+{
+    writeToken(LicenseManager::kTokenLifetimeDays + 2);
+    m_api->setOutage(true);
+
+    const QList<QVariant> result = login(*m_license);
+    QCOMPARE(result.value(0).toBool(), true);
+    QVERIFY(result.value(1).toString().contains(QStringLiteral("unreachable")));
+    QVERIFY(m_api->requests() > 0);
+}
+
+void TestLicenseManager::expiredTokenRefused()
+{
+    writeToken(LicenseManager::kTokenLifetimeDays + LicenseManager::kTokenGraceDays + 1);
+    m_api->setOutage(true);
+
+    const QList<QVariant> result = login(*m_license);
+    QCOMPARE(result.value(0).toBool(), false);
+    QCOMPARE(result.value(1).toString(), QStringLiteral("Could not connect to license server."));
+}
+
+void TestLicenseManager::wrongPasswordRefused()
+{
+    QCOMPARE(login(*m_license).value(0).toBool(), true);
+
+    QSignalSpy result(m_license, &LicenseManager::loginResult);
+    m_license->login(kUser, QStringLiteral("nope"));
+    QVERIFY(result.wait(5000));
+    QCOMPARE(result.first().value(0).toBool(), false);
+    QCOMPARE(result.first().value(1).toString(), QStringLiteral("Wrong password."));
+}
+
+QTEST_GUILESS_MAIN(TestLicenseManager)
+#include "tst_licensemanager.moc"
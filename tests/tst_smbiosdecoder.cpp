@@ -0,0 +1,120 @@
+#include "app/SmbiosDecoder.h"
+
+#include <QFile>
+#include <QTest>
+
+/// Decodes the tables under fixtures/smbios (see make_fixtures.py there).
+class TestSmbiosDecoder : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QByteArray fixture(const QString &name)
+    {
+        QFile f(QFINDTESTDATA(QStringLiteral("fixtures/smbios/") + name));
+        if (!f.open(QIODevice::ReadOnly))
+            qFatal("missing fixture %s", qPrintable(name));
+        return f.readAll();
+    }
+
+private slots:
+    void biosBoardAndChassis_data();
+    void biosBoardAndChassis();
+    void memoryLayout_data();
+    void memoryLayout();
+    void rawSmbiosDataHeader();
+    void truncatedTable();
+};
+
+void TestSmbiosDecoder::biosBoardAndChassis_data()
+{
+    QTest::addColumn<QByteArray>("table");
+    QTest::addColumn<QString>("biosVersion");
+    QTest::addColumn<QString>("biosDate");
+    QTest::addColumn<QString>("motherboard");
+    QTest::addColumn<QString>("chassisType");
+
+    QTest::newRow("desktop, DMI") << fixture(QStringLiteral("desktop-ddr4.dmi"))
+        << QStringLiteral("2423") << QStringLiteral("2021-08-10")
+        << QStringLiteral("ROG STRIX B550-F GAMING") << QStringLiteral("Desktop");
+    QTest::newRow("laptop, RSMB") << SmbiosDecoder::tableFromRawSmbiosData(fixture(QStringLiteral("laptop-ddr5.rsmb")))
+        << QStringLiteral("N3HET82W (1.54 )") << QStringLiteral("2023-11-15")
+        << QStringLiteral("21CBCTO1WW") << QStringLiteral("Laptop");
+    QTest::newRow("mini PC, DMI") << fixture(QStringLiteral("unlabelled.dmi"))
+        << QStringLiteral("1.17.0") << QStringLiteral("2022-02-07")
+        << QStringLiteral("0K8CW7") << QStringLiteral("Desktop");
+}
+
+void TestSmbiosDecoder::biosBoardAndChassis()
+{
+    QFETCH(QByteArray, table);
+    const HardwareInfo info = SmbiosDecoder::decode(table);
+    QTEST(info.biosVersion, "biosVersion");
+    QTEST(info.biosDate, "biosDate");
+    QTEST(info.motherboard, "motherboard");
+    QTEST(info.chassisType, "chassisType");   // desktop fixture also sets the lock bit
+}
+
+void TestSmbiosDecoder::memoryLayout_data()
+{
+    QTest::addColumn<QByteArray>("table");
+    QTest::addColumn<int>("slots");
+    QTest::addColumn<QList<quint32>>("modulesMb");
+    QTest::addColumn<QString>("type");
+    QTest::addColumn<quint32>("speedMhz");
+    QTest::addColumn<int>("ranks");
+    QTest::addColumn<int>("channels");
+
+    // 4 slots (the flash array is not counted), 2 filled; "P0 CHANNEL A/B" → 0:A, 0:B
+    const QByteArray desktop = fixture(QStringLiteral("desktop-ddr4.dmi"));
+    QTest::newRow("desktop, two channels") << desktop << 4 << QList<quint32>{ 16384, 16384 }
+        << QStringLiteral("DDR4") << 3200u << 2 << 2;
+    // Extended size and speed fields; "Controller0/1-ChannelA" are two channels
+    QTest::newRow("laptop, two controllers")
+        << SmbiosDecoder::tableFromRawSmbiosData(fixture(QStringLiteral("laptop-ddr5.rsmb")))
+        << 2 << QList<quint32>{ 32768, 32768 } << QStringLiteral("DDR5") << 5200u << 1 << 2;
+    // "DIMM 1/2" name no channel: assume a pair fills both channels
+    QTest::newRow("unlabelled locators") << fixture(QStringLiteral("unlabelled.dmi"))
+        << 2 << QList<quint32>{ 8192, 8192 } << QStringLiteral("DDR4") << 2666u << 1 << 2;
+    // Second module's strings cut off: only the first one is counted
+    QTest::newRow("desktop, truncated") << desktop.left(desktop.indexOf("DIMM_B2"))
+        << 4 << QList<quint32>{ 16384 } << QStringLiteral("DDR4") << 3200u << 2 << 1;
+}
+
+void TestSmbiosDecoder::memoryLayout()
+{
+    QFETCH(QByteArray, table);
+    const HardwareInfo info = SmbiosDecoder::decode(table);
+    QTEST(info.ramSlots, "slots");
+    QTEST(info.ramModulesMb, "modulesMb");
+    QTEST(info.ramType, "type");
+    QTEST(info.ramSpeedMhz, "speedMhz");   // configured speed, not the rated one
+    QTEST(info.ramRanks, "ranks");
+    QTEST(info.ramChannels, "channels");
+}
+
+void TestSmbiosDecoder::rawSmbiosDataHeader()
+{
+    const QByteArray raw = fixture(QStringLiteral("laptop-ddr5.rsmb"));
+    const QByteArray table = SmbiosDecoder::tableFromRawSmbiosData(raw);
+    QCOMPARE(table.size(), raw.size() - 8);
+    QCOMPARE(quint8(table.at(0)), quint8(0));      // starts at the type 0 structure
+
+    QVERIFY(SmbiosDecoder::tableFromRawSmbiosData(raw.left(6)).isEmpty());
+    QVERIFY(SmbiosDecoder::tableFromRawSmbiosData(raw.left(raw.size() - 1)).isEmpty());
+}
+
+void TestSmbiosDecoder::truncatedTable()
+{
+    // Cut inside the baseboard's string set: BIOS survives, nothing after it
+    const QByteArray table = fixture(QStringLiteral("desktop-ddr4.dmi"));
+    const HardwareInfo info = SmbiosDecoder::decode(table.left(table.indexOf("ROG STRIX")));
+    QCOMPARE(info.biosVersion, QStringLiteral("2423"));
+    QVERIFY(info.motherboard.isEmpty());
+    QVERIFY(info.chassisType.isEmpty());
+
+    QVERIFY(SmbiosDecoder::decode(QByteArray()).biosVersion.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestSmbiosDecoder)
+#include "tst_smbiosdecoder.moc"
@@ -0,0 +1,88 @@
+#include "app/StallWatchdog.h"
+#include "app/Trace.h"
+
+#include <QSignalSpy>
+#include <QTest>
+#include <QThread>
+
+/// Blocks the GUI thread inside a traced span, as TWEAK_STALL_TEST does, and
+/// checks what the watchdog reports. The threshold is lowered through
+/// TWEAK_STALL_MS so a run takes well under a second per case.
+class TestStallWatchdog : public QObject
+{
+    Q_OBJECT
+
+private:
+    static constexpr int kThresholdMs = 100;
+
+    static void block(int ms)
+    {
+        TRACE_SCOPE("test", "blockingCall");
+        QThread::msleep(ulong(ms));
+    }
+
+private slots:
+    void initTestCase();
+    void blockedSpanIsReported();
+    void shortBlockIsIgnored();
+};
+
+void TestStallWatchdog::initTestCase()
+{
+    qputenv("TWEAK_STALL_MS", QByteArray::number(kThresholdMs));
+}
+
+void TestStallWatchdog::blockedSpanIsReported()
+{
+    StallWatchdog watchdog;
+    QCOMPARE(watchdog.thresholdMs(), kThresholdMs);
+    QSignalSpy detected(&watchdog, &StallWatchdog::stallDetected);
+    QThread *deliveredOn = nullptr;
+    connect(&watchdog, &StallWatchdog::stallDetected, this, [&deliveredOn]() {
+        deliveredOn = QThread::currentThread();
+    });
+
+    watchdog.start();
+    QTest::qWait(3 * StallWatchdog::kHeartbeatMs);
+    block(400);
+    QVERIFY(detected.wait(2000));
+    watchdog.stop();
+
+    QCOMPARE(detected.size(), 1);
+    QCOMPARE(deliveredOn, QThread::currentThread());
+
+    // The heartbeat was posted at most one beat before the block began
+    const QVariantMap stall = detected.first().first().toMap();
+    const double durationMs = stall.value(QStringLiteral("durationMs")).toDouble();
+    QVERIFY2(durationMs >= 400 - StallWatchdog::kHeartbeatMs && durationMs < 2000,
+             qPrintable(QString::number(durationMs)));
+    QCOMPARE(stall.value(QStringLiteral("ongoing")).toBool(), false);
+    QCOMPARE(stall.value(QStringLiteral("operations")).toStringList(),
+             QStringList{ QStringLiteral("test/blockingCall") });
+
+    // The ring holds the same stall, no longer ongoing
+    const QList<StallWatchdog::Stall> ring = watchdog.stalls();
+    QCOMPARE(ring.size(), 1);
+    QCOMPARE(ring.first().durationMs, durationMs);
+    QCOMPARE(ring.first().ongoing, false);
+    QCOMPARE(ring.first().operations, QStringList{ QStringLiteral("test/blockingCall") });
+    QCOMPARE(watchdog.stallsVariant().size(), 1);
+}
+
+void TestStallWatchdog::shortBlockIsIgnored()
+{
+    StallWatchdog watchdog;
+    QSignalSpy detected(&watchdog, &StallWatchdog::stallDetected);
+
+    watchdog.start();
+    QTest::qWait(3 * StallWatchdog::kHeartbeatMs);
+    block(kThresholdMs / 4);
+    QTest::qWait(4 * kThresholdMs);
+    watchdog.stop();
+
+    QCOMPARE(detected.size(), 0);
+    QVERIFY(watchdog.stalls().isEmpty());
+}
+
+QTEST_GUILESS_MAIN(TestStallWatchdog)
+#include "tst_stallwatchdog.moc"
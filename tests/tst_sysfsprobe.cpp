@@ -0,0 +1,95 @@
+#include "app/SysfsProbe.h"
+
+#include <QTest>
+
+/// Probes the trimmed sysfs trees under fixtures/sysfs (see README.md there).
+class TestSysfsProbe : public QObject
+{
+    Q_OBJECT
+
+private:
+    static QString root(const QString &name)
+    {
+        const QString path = QFINDTESTDATA(QStringLiteral("fixtures/sysfs/") + name);
+        if (path.isEmpty())
+            qFatal("missing fixture %s", qPrintable(name));
+        return path;
+    }
+
+private slots:
+    void storage_data();
+    void storage();
+    void gpu_data();
+    void gpu();
+    void missingRoot();
+};
+
+void TestSysfsProbe::storage_data()
+{
+    QTest::addColumn<QString>("sysRoot");
+    QTest::addColumn<QStringList>("models");
+    QTest::addColumn<QStringList>("interfaces");
+    QTest::addColumn<QList<quint64>>("sizesGb");
+    QTest::addColumn<bool>("hasSsd");
+    QTest::addColumn<bool>("hasNvme");
+
+    // Model of the NVMe namespace comes from its controller; loop0 is skipped
+    QTest::newRow("NVMe + SATA HDD") << root(QStringLiteral("desktop"))
+        << QStringList{ QStringLiteral("Samsung SSD 980 PRO 1TB"), QStringLiteral("ST2000DM008-2FR102") }
+        << QStringList{ QStringLiteral("NVMe"), QStringLiteral("SATA") }
+        << QList<quint64>{ 931, 1863 } << true << true;
+    QTest::newRow("SATA SSD + USB") << root(QStringLiteral("laptop"))
+        << QStringList{ QStringLiteral("CT500MX500SSD1"), QStringLiteral("Flash Drive") }
+        << QStringList{ QStringLiteral("SATA"), QStringLiteral("USB") }
+        << QList<quint64>{ 465, 29 } << true << false;
+}
+
+void TestSysfsProbe::storage()
+{
+    QFETCH(QString, sysRoot);
+    const HardwareInfo info = SysfsProbe::storage(sysRoot);
+    QTEST(info.storage, "models");
+    QTEST(info.diskInterfaces, "interfaces");
+    QTEST(info.diskSizesGb, "sizesGb");
+    QTEST(info.hasSsd, "hasSsd");
+    QTEST(info.hasNvme, "hasNvme");
+}
+
+void TestSysfsProbe::gpu_data()
+{
+    QTest::addColumn<QString>("sysRoot");
+    QTest::addColumn<QString>("name");
+    QTest::addColumn<QString>("vendor");
+    QTest::addColumn<quint32>("vramMb");
+    QTest::addColumn<QString>("driver");
+
+    // The discrete card wins over the iGPU; amdgpu exports no module version
+    QTest::newRow("amdgpu + i915") << root(QStringLiteral("desktop"))
+        << QStringLiteral("AMD Radeon RX 6700 XT") << QStringLiteral("AMD") << 12288u
+        << QStringLiteral("amdgpu");
+    QTest::newRow("i915 only") << root(QStringLiteral("laptop"))
+        << QStringLiteral("Intel Iris Xe Graphics") << QStringLiteral("Intel") << 0u
+        << QStringLiteral("6.8.0-custom");
+}
+
+void TestSysfsProbe::gpu()
+{
+    QFETCH(QString, sysRoot);
+    const HardwareInfo info = SysfsProbe::gpu(sysRoot);
+    QTEST(info.gpuName, "name");
+    QTEST(info.gpuVendor, "vendor");
+    QTEST(info.gpuVramMb, "vramMb");
+    QTEST(info.gpuDriverVersion, "driver");
+}
+
+void TestSysfsProbe::missingRoot()
+{
+    const QString none = QStringLiteral("/nonexistent-sysfs-root");
+    const HardwareInfo storage = SysfsProbe::storage(none);
+    QVERIFY(storage.storage.isEmpty());
+    QVERIFY(!storage.hasSsd);
+    QVERIFY(SysfsProbe::gpu(none).gpuName.isEmpty());
+}
+
+QTEST_APPLESS_MAIN(TestSysfsProbe)
+#include "tst_sysfsprobe.moc"
@@ -0,0 +1,290 @@
+#!/usr/bin/env python3
+"""
+Local stand-in for the GitHub contents API that holds the license store
+
+Serves GET/PUT on /repos/<owner>/<repo>/contents/<path> with the same
+encoding, directory listings and sha-checked writes as GitHub, from
+memory, laid out as license_store.py describes. Point the app at it to
+test login, the offline token and revalidation without a network:
+
+    python fake_license_api.py --seed 3
+    TWEAK_LICENSE_API=http://127.0.0.1:8765 ./TweakApp
+
+Seeded users are user1..userN with password "test", HWID unbound.
+Admin endpoints (POST) change behaviour while the app runs:
+    /_admin/outage?on=1        answer every API call with 503
+    /_admin/revoke?user=NAME   delete that user's license
+    /_admin/latency?ms=300     delay every API reply
+
+Load test of concurrent activations (server and clients in one process):
+
+    python fake_license_api.py --load-test 500 --concurrency 32
+    python fake_license_api.py --load-test 500 --concurrency 32 --layout legacy
+
+Requires only the Python standard library.
+"""
+
+import argparse
+import base64
+import hashlib
+import json
+import statistics
+import sys
+import threading
+import time
+from concurrent.futures import ThreadPoolExecutor
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import urlparse, parse_qs
+
+import license_store as store_layout
+from license_store import encrypt, decrypt
+
+
+class Store:
+    """Files as GitHub would hold them: {path: (encrypted bytes, sha)}."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.files = {}
+        self.outage = False
+        self.latency_ms = 0
+        self.conflicts = 0
+
+    def write(self, path, value):
+        data = encrypt(json.dumps(value, separators=(",", ":")).encode())
+        self.files[path] = (data, hashlib.sha1(data).hexdigest())
+
+    def read(self, path, default=None):
+        return json.loads(decrypt(self.files[path][0])) if path in self.files else default
+
+    def licenses(self):
+        return store_layout.merge({p: self.read(p) for p in self.files})
+
+    def set_licenses(self, licenses):
+        self.files = {}
+        for path, value in store_layout.split(licenses).items():
+            self.write(path, value)
+
+
+def seed_licenses(count, bound=True):
+    password = hashlib.sha256(b"test").hexdigest()
+    return [{
+        "key": f"TEST-{i:04d}-0000-0000",
+        "username": f"user{i}" if bound else "",
+        "password": password if bound else "",
+        "hwid": "",
+        "hwid_resets": 0,
+        "max_resets": 3,
+        "last_hwid_change": "",
+        "activated_at": "",
+    } for i in range(1, count + 1)]
+
+
+def make_handler(store):
+    class Handler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"
+
+        def reply(self, status, body=None):
+            data = json.dumps(body if body is not None else {}).encode()
+            self.send_response(status)
+            self.send_header("Content-Type", "application/json")
+            self.send_header("Content-Length", str(len(data)))
+            self.end_headers()
+            self.wfile.write(data)
+
+        def api_path(self):
+            """The repo path of a contents API call, None after replying."""
+            if store.latency_ms:
+                time.sleep(store.latency_ms / 1000)
+            if store.outage:
+                self.reply(503, {"message": "Service Unavailable"})
+                return None
+            url = urlparse(self.path).path
+            if not url.startswith("/repos/") or "/contents/" not in url:
+                self.reply(404, {"message": "Not Found"})
+                return None
+            return url.split("/contents/", 1)[1].strip("/")
+
+        def do_GET(self):
+            path = self.api_path()
+            if path is None:
+                return
+            with store.lock:
+                if path in store.files:
+                    data, sha = store.files[path]
+                    self.reply(200, {"path": path, "sha": sha, "encoding": "base64",
+                                     "content": base64.encodebytes(data).decode()})
+                    return
+                prefix = path + "/"
+                children = sorted({prefix + p[len(prefix):].split("/")[0]
+                                   for p in store.files if p.startswith(prefix)})
+            if not children:
+                self.reply(404, {"message": "Not Found"})
+                return
+            self.reply(200, [{"path": c, "name": c.rsplit("/", 1)[-1],
+                              "type": "file" if c in store.files else "dir"} for c in children])
+
+        def do_PUT(self):
+            path = self.api_path()
+            length = int(self.headers.get("Content-Length", 0))
+            body = json.loads(self.rfile.read(length) or b"{}")
+            if path is None:
+                return
+            with store.lock:
+                current = store.files.get(path)
+                # GitHub: a stale sha is 409, a missing sha for an existing file 422
+                if current and not body.get("sha"):
+                    store.conflicts += 1
+                    self.reply(422, {"message": "sha wasn't supplied"})
+                    return
+                if body.get("sha") and (not current or body["sha"] != current[1]):
+                    store.conflicts += 1
+                    self.reply(409, {"message": f"{path} does not match {body['sha']}"})
+                    return
+                data = base64.b64decode(body.get("content", ""))
+                store.files[path] = (data, hashlib.sha1(data).hexdigest())
+                self.reply(200, {"content": {"path": path, "sha": store.files[path][1]}})
+
+        def do_POST(self):
+            url = urlparse(self.path)
+            args = {k: v[0] for k, v in parse_qs(url.query).items()}
+            with store.lock:
+                if url.path == "/_admin/outage":
+                    store.outage = args.get("on", "1") not in ("0", "false")
+                elif url.path == "/_admin/latency":
+                    store.latency_ms = int(args.get("ms", "0"))
+                elif url.path == "/_admin/revoke":
+                    user = args.get("user", "").lower()
+                    store.set_licenses([l for l in store.licenses()
+                                        if l.get("username", "").lower() != user])
+                else:
+                    self.reply(404, {"message": "Not Found"})
+                    return
+                self.reply(200, {"outage": store.outage, "latency_ms": store.latency_ms,
+                                 "licenses": len(store.licenses())})
+
+        def log_message(self, fmt, *args):
+            if not self.server.quiet:
+                print(f"[{self.log_date_time_string()}] {fmt % args}")
+
+    return Handler
+
+
+def serve(store, port, quiet=False):
+    server = ThreadingHTTPServer(("127.0.0.1", port), make_handler(store))
+    server.quiet = quiet
+    server.daemon_threads = True
+    return server
+
+
+# ── Load test ──
+
+def legacy_activate(client, key, username, password, hwid, stats):
+    """The pre-sharding protocol: one file, scanned and rewritten whole."""
+    pass_hash = hashlib.sha256(password.encode()).hexdigest()
+
+    def edit(licenses):
+        lic = next((l for l in licenses if l["key"] == key), None)
+        if lic is None:
+            raise store_layout.Aborted("Invalid license key.")
+        if any(l.get("username", "").lower() == username.lower() and l is not lic for l in licenses):
+            raise store_layout.Aborted("Username already taken.")
+        lic.update(hwid=hwid, username=username, password=pass_hash)
+        return True
+
+    store_layout.update(client, store_layout.LEGACY_FILE, edit, list, stats)
+
+
+def load_test(args):
+    store = Store()
+    licenses = seed_licenses(args.load_test, bound=False)
+    if args.layout == "legacy":
+        store.write(store_layout.LEGACY_FILE, licenses)
+    else:
+        store.set_licenses(licenses)
+    server = serve(store, args.port, quiet=True)
+    threading.Thread(target=server.serve_forever, daemon=True).start()
+
+    base = f"http://127.0.0.1:{args.port}"
+    activate = legacy_activate if args.layout == "legacy" else store_layout.activate
+    latencies, failures, stats = [], [], {}
+
+    def one(i):
+        client = store_layout.ContentsClient(base, "o", "r", user_agent="Tweak-LoadTest")
+        start = time.perf_counter()
+        try:
+            activate(client, f"TEST-{i:04d}-0000-0000", f"load{i}", "test", f"HWID{i:04d}", stats)
+        except Exception as e:          # exhausted retries or rejected
+            failures.append(f"load{i}: {e!r}")
+        latencies.append((time.perf_counter() - start) * 1000)
+
+    started = time.perf_counter()
+    with ThreadPoolExecutor(max_workers=args.concurrency) as pool:
+        list(pool.map(one, range(1, args.load_test + 1)))
+    elapsed = time.perf_counter() - started
+    server.shutdown()
+
+    # Every activation that reported success must be visible in the store
+    if args.layout == "legacy":
+        final = store.read(store_layout.LEGACY_FILE, [])
+        index = {l["username"].lower(): l["key"] for l in final if l.get("username")}
+    else:
+        final = store.licenses()
+        index = {}
+        for p in store.files:
+            if p.startswith(store_layout.USERS_DIR + "/"):
+                index.update(store.read(p))
+    bound = {l["key"]: l.get("username", "") for l in final}
+    lost = [i for i in range(1, args.load_test + 1)
+            if bound.get(f"TEST-{i:04d}-0000-0000") != f"load{i}"
+            and not any(f.startswith(f"load{i}:") for f in failures)]
+    missing_index = [i for i in range(1, args.load_test + 1)
+                     if bound.get(f"TEST-{i:04d}-0000-0000") == f"load{i}"
+                     and index.get(f"load{i}") != f"TEST-{i:04d}-0000-0000"]
+
+    latencies.sort()
+    print(f"layout={args.layout} activations={args.load_test} concurrency={args.concurrency}")
+    print(f"  wall {elapsed:.2f}s, {args.load_test / elapsed:.0f} activations/s")
+    print(f"  latency p50 {statistics.median(latencies):.1f} ms, "
+          f"p95 {latencies[int(len(latencies) * 0.95) - 1]:.1f} ms, max {latencies[-1]:.1f} ms")
+    print(f"  write conflicts {store.conflicts}, failed activations {len(failures)}, "
+          f"lost updates {len(lost)}, missing index entries {len(missing_index)}")
+    for f in failures[:5]:
+        print("   ", f)
+    return 0 if not lost and not missing_index else 1
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Local stand-in for the license API")
+    ap.add_argument("--port", type=int, default=8765)
+    ap.add_argument("--seed", type=int, default=1, help="number of test users to create")
+    ap.add_argument("--latency-ms", type=int, default=0, help="delay every API reply")
+    ap.add_argument("--load", metavar="FILE", help="start from a licenses JSON array instead")
+    ap.add_argument("--load-test", type=int, metavar="N", help="run N concurrent activations and exit")
+    ap.add_argument("--concurrency", type=int, default=16, help="client threads for --load-test")
+    ap.add_argument("--layout", choices=("sharded", "legacy"), default="sharded",
+                    help="store layout for --load-test; legacy is the single licenses.enc")
+    args = ap.parse_args()
+
+    if args.load_test:
+        sys.exit(load_test(args))
+
+    store = Store()
+    store.latency_ms = args.latency_ms
+    if args.load:
+        with open(args.load) as f:
+            store.set_licenses(json.load(f))
+    else:
+        store.set_licenses(seed_licenses(args.seed))
+
+    server = serve(store, args.port)
+    print(f"Fake license API on http://127.0.0.1:{args.port} ({len(store.licenses())} licenses)")
+    print(f"  TWEAK_LICENSE_API=http://127.0.0.1:{args.port}")
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()
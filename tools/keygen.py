@@ -8,6 +8,7 @@ Requires: pip install flask requests
 Usage:
     python keygen.py                     # Start on http://localhost:5000
     python keygen.py --port 8080         # Custom port
+    python keygen.py --migrate           # Split licenses.enc into the sharded store
 """
 
 import argparse
@@ -28,6 +29,8 @@ try:
 except ImportError:
     print("Error: pip install requests"); sys.exit(1)
 
+import license_store as store
+
 # ── Configuration ──
 GITHUB_OWNER = "pedziito"
 GITHUB_REPO  = "tweak-licenses"
@@ -69,29 +72,68 @@ def gh_headers(token):
         "User-Agent": "Tweak-Admin",
     }
 
-def fetch_licenses(token):
-    url = f"https://api.github.com/repos/{GITHUB_OWNER}/{GITHUB_REPO}/contents/{LICENSE_FILE}"
-    r = http.get(url, headers=gh_headers(token))
+def gh_url(path):
+    return f"https://api.github.com/repos/{GITHUB_OWNER}/{GITHUB_REPO}/contents/{path}"
+
+def get_file(token, path):
+    r = http.get(gh_url(path), headers=gh_headers(token))
     if r.status_code == 404:
-        return [], None
+        return None, None
     r.raise_for_status()
     d = r.json()
-    content = base64.b64decode(d["content"])
-    decrypted = decrypt(content)
-    return json.loads(decrypted), d["sha"]
+    return json.loads(decrypt(base64.b64decode(d["content"]))), d["sha"]
 
-def save_licenses(token, licenses, sha=None):
-    url = f"https://api.github.com/repos/{GITHUB_OWNER}/{GITHUB_REPO}/contents/{LICENSE_FILE}"
-    encrypted = encrypt(json.dumps(licenses, indent=2).encode())
+def put_file(token, path, value, sha=None):
+    encrypted = encrypt(json.dumps(value, indent=2).encode())
     body = {
-        "message": f"Update licenses ({datetime.now(timezone.utc).strftime('%Y-%m-%d %H:%M')})",
+        "message": f"Update {path} ({datetime.now(timezone.utc).strftime('%Y-%m-%d %H:%M')})",
         "content": base64.b64encode(encrypted).decode(),
     }
     if sha:
         body["sha"] = sha
-    r = http.put(url, headers=gh_headers(token), json=body)
+    r = http.put(gh_url(path), headers=gh_headers(token), json=body)
     r.raise_for_status()
 
+def list_dir(token, path):
+    r = http.get(gh_url(path), headers=gh_headers(token))
+    if r.status_code == 404:
+        return []
+    r.raise_for_status()
+    return [e["path"] for e in r.json() if e.get("type") == "file"]
+
+def fetch_licenses(token):
+    """Every license in the sharded store (see license_store.py), plus the
+    (value, sha) each file held, for save_licenses()."""
+    files = {p: get_file(token, p)
+             for p in list_dir(token, store.KEYS_DIR) + list_dir(token, store.USERS_DIR)}
+    return store.merge({p: v for p, (v, _) in files.items()}), files
+
+def save_licenses(token, licenses, files=None):
+    """Rewrite the key shards and username index shards that changed. Each
+    write carries the sha it was read with, so an activation that landed
+    in between fails the save instead of being overwritten."""
+    files = files or {}
+    new = store.split(licenses)
+    for path in sorted(set(new) | set(files)):
+        old, sha = files.get(path, (None, None))
+        value = new.get(path, [] if path.startswith(store.KEYS_DIR) else {})
+        if value != (old if old is not None else type(value)()):
+            put_file(token, path, value, sha)
+
+def migrate(token):
+    """Split the old single licenses.enc into the sharded layout."""
+    licenses, _ = get_file(token, LICENSE_FILE)
+    if licenses is None:
+        print("No licenses.enc to migrate.")
+        return
+    existing, files = fetch_licenses(token)
+    if existing:
+        print(f"Sharded store already has {len(existing)} license(s); not migrating.")
+        return
+    save_licenses(token, licenses, files)
+    print(f"Migrated {len(licenses)} license(s) into {store.KEYS_DIR}/ and {store.USERS_DIR}/.")
+    print("licenses.enc is left in place; delete it once the app has been updated.")
+
 def generate_key():
     chars = string.ascii_uppercase + string.digits
     return "LICENSE-" + "-".join("".join(random.choices(chars, k=4)) for _ in range(3))
@@ -110,8 +152,8 @@ def api_list():
     if not token:
         return jsonify({"error": "No GITHUB_TOKEN set"}), 500
     try:
-        licenses, sha = fetch_licenses(token)
-        return jsonify({"licenses": licenses, "sha": sha})
+        licenses, _ = fetch_licenses(token)
+        return jsonify({"licenses": licenses})
     except Exception as e:
         return jsonify({"error": str(e)}), 500
 
@@ -122,7 +164,7 @@ def api_generate():
         return jsonify({"error": "No GITHUB_TOKEN"}), 500
     count = request.json.get("count", 1)
     try:
-        licenses, sha = fetch_licenses(token)
+        licenses, files = fetch_licenses(token)
         existing = {l["key"] for l in licenses}
         new_keys = []
         for _ in range(count):
@@ -137,7 +179,7 @@ def api_generate():
                 "hwid_resets": 0, "last_hwid_change": "", "max_resets": 3
             })
             new_keys.append(k)
-        save_licenses(token, licenses, sha)
+        save_licenses(token, licenses, files)
         return jsonify({"ok": True, "keys": new_keys})
     except Exception as e:
         return jsonify({"error": str(e)}), 500
@@ -149,11 +191,11 @@ def api_revoke():
         return jsonify({"error": "No GITHUB_TOKEN"}), 500
     key = request.json.get("key", "").upper()
     try:
-        licenses, sha = fetch_licenses(token)
+        licenses, files = fetch_licenses(token)
         new_list = [l for l in licenses if l["key"].upper() != key]
         if len(new_list) == len(licenses):
             return jsonify({"error": "Key not found"}), 404
-        save_licenses(token, new_list, sha)
+        save_licenses(token, new_list, files)
         return jsonify({"ok": True})
     except Exception as e:
         return jsonify({"error": str(e)}), 500
@@ -168,13 +210,13 @@ def api_bulk_revoke():
     if not keys:
         return jsonify({"error": "No keys provided"}), 400
     try:
-        licenses, sha = fetch_licenses(token)
+        licenses, files = fetch_licenses(token)
         before = len(licenses)
         new_list = [l for l in licenses if l["key"].upper() not in keys]
         removed = before - len(new_list)
         if removed == 0:
             return jsonify({"error": "No matching keys found"}), 404
-        save_licenses(token, new_list, sha)
+        save_licenses(token, new_list, files)
         return jsonify({"ok": True, "removed": removed})
     except Exception as e:
         return jsonify({"error": str(e)}), 500
@@ -186,7 +228,7 @@ def api_reset_hwid():
         return jsonify({"error": "No GITHUB_TOKEN"}), 500
     key = request.json.get("key", "").upper()
     try:
-        licenses, sha = fetch_licenses(token)
+        licenses, files = fetch_licenses(token)
         found = False
         for l in licenses:
             if l["key"].upper() == key:
@@ -200,7 +242,7 @@ def api_reset_hwid():
                 break
         if not found:
             return jsonify({"error": "Key not found"}), 404
-        save_licenses(token, licenses, sha)
+        save_licenses(token, licenses, files)
         return jsonify({"ok": True, "resets_used": l.get("hwid_resets", 0), "max_resets": l.get("max_resets", 3)})
     except Exception as e:
         return jsonify({"error": str(e)}), 500
@@ -212,7 +254,7 @@ def api_reset_user():
         return jsonify({"error": "No GITHUB_TOKEN"}), 500
     key = request.json.get("key", "").upper()
     try:
-        licenses, sha = fetch_licenses(token)
+        licenses, files = fetch_licenses(token)
         found = False
         for l in licenses:
             if l["key"].upper() == key:
@@ -226,7 +268,7 @@ def api_reset_user():
                 break
         if not found:
             return jsonify({"error": "Key not found"}), 404
-        save_licenses(token, licenses, sha)
+        save_licenses(token, licenses, files)
         return jsonify({"ok": True})
     except Exception as e:
         return jsonify({"error": str(e)}), 500
@@ -237,13 +279,13 @@ def api_init():
     if not token:
         return jsonify({"error": "No GITHUB_TOKEN"}), 500
     try:
-        licenses, sha = fetch_licenses(token)
+        licenses, files = fetch_licenses(token)
         if licenses:
             return jsonify({"error": f"Database already has {len(licenses)} license(s)"}), 400
     except Exception:
-        sha = None
+        files = None
     try:
-        save_licenses(token, [], sha)
+        save_licenses(token, [], files)
         return jsonify({"ok": True})
     except Exception as e:
         return jsonify({"error": str(e)}), 500
@@ -784,6 +826,8 @@ def main():
     parser = argparse.ArgumentParser(description="Tweak License Admin Panel")
     parser.add_argument("--port", type=int, default=5000, help="Port (default 5000)")
     parser.add_argument("--host", default="127.0.0.1", help="Host (default 127.0.0.1)")
+    parser.add_argument("--migrate", action="store_true",
+                        help="Split the single licenses.enc into the sharded store and exit")
     args = parser.parse_args()
 
     token = get_token()
@@ -792,6 +836,10 @@ def main():
         print("Set GITHUB_TOKEN env var or create tools/.env with GITHUB_TOKEN=...")
         print()
 
+    if args.migrate:
+        migrate(token)
+        return
+
     print(f"\n  Tweak License Admin → http://{args.host}:{args.port}\n")
     app.run(host=args.host, port=args.port, debug=False)
 
@@ -0,0 +1,192 @@
+"""
+Sharded license storage, as LicenseManager reads and writes it
+
+    licenses/keys/XX.enc     JSON array of the licenses whose key hashes to XX
+    licenses/users/XX.enc    JSON object: lower-case username -> license key
+
+XX is the first byte of SHA-256(key upper-cased, or username lower-cased)
+modulo SHARD_COUNT, as two hex digits. Each file is encrypt(json) stored
+through the GitHub contents API. A write carries the sha it read; 409 or
+422 means another client wrote first, so re-read and redo the edit.
+
+Standard library only; shared by keygen.py and fake_license_api.py.
+"""
+
+import base64
+import hashlib
+import json
+import random
+import time
+import urllib.error
+import urllib.request
+
+SHARD_COUNT = 64             # must match LicenseManager::kShardCount
+MAX_WRITE_ATTEMPTS = 5       # must match LicenseManager::kMaxWriteAttempts
+LEGACY_FILE = "licenses.enc"
+KEYS_DIR = "licenses/keys"
+USERS_DIR = "licenses/users"
+
+# Must match kXorKey in src/app/LicenseManager.cpp
+XOR_KEY = bytes([
+    0x54, 0x77, 0x65, 0x61, 0x6B, 0x4C, 0x69, 0x63,
+    0x65, 0x6E, 0x73, 0x65, 0x4B, 0x65, 0x79, 0x21,
+    0xAB, 0xCD, 0xEF, 0x01, 0x23, 0x45, 0x67, 0x89,
+    0xDE, 0xAD, 0xBE, 0xEF, 0xCA, 0xFE, 0xBA, 0xBE,
+])
+
+def encrypt(data: bytes) -> bytes:
+    xored = bytes(b ^ XOR_KEY[i % len(XOR_KEY)] for i, b in enumerate(data))
+    return base64.b64encode(xored)
+
+def decrypt(data: bytes) -> bytes:
+    raw = base64.b64decode(data)
+    return bytes(b ^ XOR_KEY[i % len(XOR_KEY)] for i, b in enumerate(raw))
+
+# ── Layout ──
+
+def _shard(text):
+    return f"{hashlib.sha256(text.encode()).digest()[0] % SHARD_COUNT:02x}"
+
+def key_shard_path(key):
+    return f"{KEYS_DIR}/{_shard(key.upper())}.enc"
+
+def user_shard_path(username):
+    return f"{USERS_DIR}/{_shard(username.lower())}.enc"
+
+def split(licenses):
+    """Every shard and index file for a full license list: {path: json value}."""
+    files = {}
+    for lic in licenses:
+        files.setdefault(key_shard_path(lic["key"]), []).append(lic)
+        if lic.get("username"):
+            files.setdefault(user_shard_path(lic["username"]), {})[lic["username"].lower()] = lic["key"]
+    return files
+
+def merge(files):
+    """The license list back out of {path: json value}."""
+    licenses = []
+    for path in sorted(files):
+        if path.startswith(KEYS_DIR + "/"):
+            licenses.extend(files[path] or [])
+    return licenses
+
+# ── Contents API client ──
+
+class Conflict(Exception):
+    pass
+
+class ContentsClient:
+    """GET/PUT of encrypted JSON files through the GitHub contents API."""
+
+    def __init__(self, base_url, owner, repo, token=None, user_agent="Tweak-Admin"):
+        self.base = f"{base_url.rstrip('/')}/repos/{owner}/{repo}/contents/"
+        self.headers = {"Accept": "application/vnd.github.v3+json", "User-Agent": user_agent}
+        if token:
+            self.headers["Authorization"] = f"Bearer {token}"
+
+    def _request(self, path, method="GET", body=None):
+        data = json.dumps(body).encode() if body is not None else None
+        headers = dict(self.headers, **({"Content-Type": "application/json"} if data else {}))
+        req = urllib.request.Request(self.base + path, data=data, method=method, headers=headers)
+        with urllib.request.urlopen(req, timeout=30) as r:
+            return json.loads(r.read() or b"null")
+
+    def get(self, path):
+        """(value, sha); (None, None) if the file does not exist."""
+        try:
+            d = self._request(path)
+        except urllib.error.HTTPError as e:
+            if e.code == 404:
+                return None, None
+            raise
+        return json.loads(decrypt(base64.b64decode(d["content"]))), d["sha"]
+
+    def put(self, path, value, sha=None, message=None):
+        body = {
+            "message": message or f"Update {path}",
+            "content": base64.b64encode(encrypt(json.dumps(value, separators=(",", ":")).encode())).decode(),
+        }
+        if sha:
+            body["sha"] = sha
+        try:
+            return self._request(path, "PUT", body)["content"]["sha"]
+        except urllib.error.HTTPError as e:
+            if e.code in (409, 422):
+                raise Conflict(path) from e
+            raise
+
+    def list(self, directory):
+        """Paths of the files in a directory; empty if it does not exist."""
+        try:
+            entries = self._request(directory)
+        except urllib.error.HTTPError as e:
+            if e.code == 404:
+                return []
+            raise
+        return [e["path"] for e in entries if e.get("type") == "file"]
+
+    def get_all(self):
+        """Every shard and index file: {path: (value, sha)}."""
+        return {p: self.get(p) for p in self.list(KEYS_DIR) + self.list(USERS_DIR)}
+
+class Aborted(Exception):
+    pass
+
+def update(client, path, mutate, empty, stats=None):
+    """Read-modify-write with retries, as LicenseManager::updateFile.
+    mutate(value) edits value in place and returns True to write it, or
+    raises Aborted. Conflicts are counted in stats["conflicts"]."""
+    for attempt in range(1, MAX_WRITE_ATTEMPTS + 1):
+        value, sha = client.get(path)
+        if value is None:
+            value = empty()
+        if not mutate(value):
+            return
+        try:
+            client.put(path, value, sha)
+            return
+        except Conflict:
+            if stats is not None:
+                stats["conflicts"] = stats.get("conflicts", 0) + 1
+            if attempt == MAX_WRITE_ATTEMPTS:
+                raise
+            time.sleep(attempt * random.uniform(0.05, 0.15))
+
+def activate(client, key, username, password, hwid, stats=None):
+    """A fresh activation, step for step as LicenseManager::activate:
+    claim the username, then bind the license, releasing the claim if
+    that fails."""
+    name = username.lower()
+    pass_hash = hashlib.sha256(password.encode()).hexdigest()
+
+    def claim(index):
+        owner = index.get(name, "")
+        if owner.upper() == key.upper():
+            return False
+        if owner:
+            raise Aborted("Username already taken.")
+        index[name] = key
+        return True
+
+    def bind(licenses):
+        lic = next((l for l in licenses if l["key"].upper() == key.upper()), None)
+        if lic is None:
+            raise Aborted("Invalid license key.")
+        if lic.get("hwid") and lic["hwid"] != hwid:
+            raise Aborted("This license was just activated on another machine.")
+        lic.update(hwid=hwid, username=username, password=pass_hash,
+                   activated_at=time.strftime("%Y-%m-%dT%H:%M:%SZ", time.gmtime()))
+        return True
+
+    def release(index):
+        if index.get(name, "").upper() != key.upper():
+            return False
+        del index[name]
+        return True
+
+    update(client, user_shard_path(username), claim, dict, stats)
+    try:
+        update(client, key_shard_path(key), bind, list, stats)
+    except Exception:
+        update(client, user_shard_path(username), release, dict, stats)
+        raise